@@ -53,6 +53,12 @@ namespace QuantLib {
         const boost::shared_ptr<IborIndex>& iborIndex() const {
             return iborIndex_;
         }
+        //! start of the period over which the fixing is forecast
+        const Date& fixingValueDate() const { return fixingValueDate_; }
+        //! end of the period over which the fixing is forecast
+        const Date& fixingEndDate() const { return fixingEndDate_; }
+        //! length of the forecast period in the index day counter
+        Time spanningTime() const { return spanningTime_; }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
@@ -56,6 +56,14 @@ namespace QuantLib {
         sample_type next() const {
             return sample_type(nextGaussian(),1.0);
         }
+        //! skip the next \f$ n \f$ draws
+        /*! Since the number of uniform deviates used for each draw
+            is not fixed, the skipped draws are actually generated.
+        */
+        void skip(BigNatural n) {
+            for (BigNatural i=0; i<n; ++i)
+                nextGaussian();
+        }
       private:
         mutable MersenneTwisterUniformRng mt32_;
         Real nextGaussian() const;
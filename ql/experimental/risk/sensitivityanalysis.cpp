@@ -20,6 +20,7 @@
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/instrument.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
 
 using std::vector;
 using std::pair;
@@ -351,4 +352,21 @@ namespace QuantLib {
         return result;
     }
 
+    vector<Real>
+    bucketDeltaFromJacobian(const Matrix& jacobian,
+                            const Array& dataSensitivities)
+    {
+        QL_REQUIRE(jacobian.rows() == jacobian.columns(),
+                   "non square Jacobian (" << jacobian.rows() << "x" <<
+                   jacobian.columns() << ")");
+        QL_REQUIRE(jacobian.columns() == dataSensitivities.size(),
+                   "dimension mismatch between Jacobian (" <<
+                   jacobian.columns() << " columns) and data "
+                   "sensitivities (" << dataSensitivities.size() << ")");
+
+        // dV/dq = J^{-T} dV/dx
+        Array x = qrSolve(transpose(jacobian), dataSensitivities);
+        return vector<Real>(x.begin(), x.end());
+    }
+
 }
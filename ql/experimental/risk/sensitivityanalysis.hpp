@@ -24,7 +24,7 @@
 #ifndef quantlib_sensitivity_analysis_hpp
 #define quantlib_sensitivity_analysis_hpp
 
-//#include <ql/math/matrix.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/types.hpp>
 #include <ql/utilities/null.hpp>
 #include <boost/shared_ptr.hpp>
@@ -176,6 +176,24 @@ namespace QuantLib {
                    Real shift = 0.0001,
                    SensitivityAnalysis type = Centered);
 
+    //! bucket PV01 sensitivity analysis from a bootstrap Jacobian
+    /*! returns the derivatives of a value with respect to the quotes
+        of the alive helpers of a bootstrapped curve, given its
+        derivatives with respect to the curve data and the Jacobian
+        of the implied quotes with respect to the same data (see
+        PiecewiseYieldCurve::dataSensitivities() and
+        PiecewiseYieldCurve::jacobian()).
+
+        The result, obtained by solving a single linear system, is
+        the first-order equivalent of tweaking the quotes one by one
+        and bootstrapping the curve each time.  Unlike
+        bucketAnalysis(), no shift is involved and only the first
+        derivatives are returned.
+    */
+    std::vector<Real>
+    bucketDeltaFromJacobian(const Matrix& jacobian,
+                            const Array& dataSensitivities);
+
 }
 
 #endif
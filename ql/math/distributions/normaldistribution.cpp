@@ -22,6 +22,7 @@
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -86,6 +87,56 @@ namespace QuantLib {
     const Real InverseCumulativeNormal::x_low_ = 0.02425;
     const Real InverseCumulativeNormal::x_high_= 1.0 - x_low_;
 
+    void InverseCumulativeNormal::operator()(const Real* begin,
+                                             const Real* end,
+                                             Real* out) const {
+        // The range is processed in chunks, so that the input can be
+        // kept aside for the tails when working in place.  The last
+        // chunk is padded, so that the central region is always
+        // evaluated over a full chunk; a loop with a fixed trip count
+        // and no branches is vectorized by the compiler even when
+        // cost models are conservative, as they are at -O2.
+        const Size chunk = 64;
+        Real x[chunk], y[chunk];
+        Size tails[chunk];
+        while (begin != end) {
+            const Size n = std::min<Size>(chunk, end-begin);
+            Size i, k, m = 0;
+            std::copy(begin, begin+n, x);
+            std::fill(x+n, x+chunk, 0.5);
+            Real* central = (n == chunk ? out : y);
+            for (i=0; i<chunk; ++i) {
+                Real z = x[i] - 0.5;
+                Real r = z*z;
+                central[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                    (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+            }
+            if (n != chunk)
+                std::copy(y, y+n, out);
+            // tails, which are rarely hit; they are collected without
+            // branching on the (random) input values
+            for (i=0; i<n; ++i) {
+                tails[m] = i;
+                m += Size(x[i] < x_low_ || x_high_ < x[i]);
+            }
+            for (k=0; k<m; ++k)
+                out[tails[k]] = tail_value(x[tails[k]]);
+            #ifdef  REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+            for (i=0; i<n; ++i) {
+                Real r = (f_(out[i]) - x[i])
+                    * M_SQRT2 * M_SQRTPI * exp(0.5 * out[i]*out[i]);
+                out[i] -= r/(1+0.5*out[i]*r);
+            }
+            #endif
+            if (average_ != 0.0 || sigma_ != 1.0) {
+                for (i=0; i<n; ++i)
+                    out[i] = average_ + sigma_*out[i];
+            }
+            begin += n;
+            out += n;
+        }
+    }
+
     Real InverseCumulativeNormal::tail_value(Real x) {
         if (x <= 0.0 || x >= 1.0) {
             // try to recover if due to numerical error
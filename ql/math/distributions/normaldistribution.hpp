@@ -107,6 +107,15 @@ namespace QuantLib {
         Real operator()(Real x) const {
             return average_ + sigma_*standard_value(x);
         }
+        //! values for a range of probabilities
+        /*! The results are the same as the ones returned by the
+            scalar operator(), and so is their accuracy; the central
+            region is evaluated in a branch-free loop which the
+            compiler can vectorize, and the tails are patched
+            afterwards. The output can overwrite the input range.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
         // value for average=0, sigma=1
         /* Compared to operator(), this method avoids 2 floating point
            operations (we use average=0 and sigma=1 most of the
@@ -174,6 +183,13 @@ namespace QuantLib {
         static const Real x_high_;
     };
 
+    // batch version used by InverseCumulativeRsg
+    inline void applyInverseCumulative(const InverseCumulativeNormal& ic,
+                                       const Real* begin, const Real* end,
+                                       Real* out) {
+        ic(begin, end, out);
+    }
+
     // backward compatibility
     typedef InverseCumulativeNormal InvCumulativeNormalDistribution;
 
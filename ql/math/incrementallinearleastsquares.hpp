@@ -0,0 +1,171 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file incrementallinearleastsquares.hpp
+    \brief linear least squares by incremental QR decomposition
+*/
+
+#ifndef quantlib_incremental_linear_least_squares_hpp
+#define quantlib_incremental_linear_least_squares_hpp
+
+#include <ql/math/matrixutilities/svd.hpp>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! linear least squares by incremental QR decomposition
+    /*! Observations are added one at a time and folded into the
+        triangular factor \f$ R \f$ of the QR decomposition of the
+        design matrix by means of Givens rotations, together with the
+        rotated right-hand side \f$ Q^T y \f$.  The design matrix is
+        never stored; memory is \f$ O(m^2) \f$ for \f$ m \f$ regressors
+        regardless of the number of observations.
+
+        Two instances can be merged, which allows partial regressions
+        to be computed separately (e.g., on different threads) and
+        combined afterwards.  Merging the same partial results in the
+        same order always gives the same coefficients.
+
+        The coefficients are obtained from the singular value
+        decomposition of the \f$ m \times m \f$ factor \f$ R \f$,
+        which has the same singular values as the design matrix;
+        rank-deficient problems are therefore handled as in
+        GeneralLinearLeastSquares.
+
+        \test the correctness of the returned values is tested by
+              checking them against the SVD-based regression.
+    */
+    class IncrementalLinearLeastSquares {
+      public:
+        explicit IncrementalLinearLeastSquares(Size dimension = 0);
+        //! \name inspectors
+        //@{
+        //! number of regressors
+        Size dimension() const { return qty_.size(); }
+        //! number of observations added so far
+        Size size() const { return size_; }
+        //! fitted coefficients
+        Array coefficients() const;
+        //@}
+        //! \name modifiers
+        //@{
+        //! adds the observation \f$ (x_1, \dots, x_m; y) \f$
+        /*! The iterator must give access to dimension() regressors. */
+        template <class Iterator>
+        void add(Iterator x, Real y);
+        //! adds the observations collected by another instance
+        void merge(const IncrementalLinearLeastSquares& other);
+        //! removes all observations, keeping the dimension
+        void reset();
+        //@}
+      private:
+        void rotate(Real y);
+        Matrix r_;
+        Array qty_, row_;
+        Size size_;
+    };
+
+
+    // inline definitions
+
+    inline IncrementalLinearLeastSquares::IncrementalLinearLeastSquares(
+                                                              Size dimension)
+    : r_(dimension, dimension, 0.0), qty_(dimension, 0.0),
+      row_(dimension), size_(0) {}
+
+    template <class Iterator>
+    inline void IncrementalLinearLeastSquares::add(Iterator x, Real y) {
+        for (Size j=0; j<row_.size(); ++j, ++x)
+            row_[j] = *x;
+        rotate(y);
+        ++size_;
+    }
+
+    inline void IncrementalLinearLeastSquares::merge(
+                                  const IncrementalLinearLeastSquares& other) {
+        QL_REQUIRE(other.dimension() == dimension(),
+                   "dimension mismatch (" << other.dimension()
+                   << " vs " << dimension() << ")");
+        // the rows of the other triangular factor, together with the
+        // corresponding rotated right-hand side, carry all the
+        // information about the observations it collected
+        for (Size i=0; i<other.r_.rows(); ++i) {
+            std::copy(other.r_.row_begin(i), other.r_.row_end(i),
+                      row_.begin());
+            rotate(other.qty_[i]);
+        }
+        size_ += other.size_;
+    }
+
+    inline void IncrementalLinearLeastSquares::reset() {
+        std::fill(r_.begin(), r_.end(), 0.0);
+        std::fill(qty_.begin(), qty_.end(), 0.0);
+        size_ = 0;
+    }
+
+    inline void IncrementalLinearLeastSquares::rotate(Real y) {
+        const Size m = row_.size();
+        for (Size k=0; k<m; ++k) {
+            const Real xk = row_[k];
+            if (xk == 0.0)
+                continue;
+            const Real rkk = r_[k][k];
+            const Real h = std::sqrt(rkk*rkk + xk*xk);
+            const Real c = rkk/h, s = xk/h;
+            r_[k][k] = h;
+            for (Size j=k+1; j<m; ++j) {
+                const Real rkj = r_[k][j];
+                r_[k][j] = c*rkj + s*row_[j];
+                row_[j] = c*row_[j] - s*rkj;
+            }
+            const Real qk = qty_[k];
+            qty_[k] = c*qk + s*y;
+            y = c*y - s*qk;
+        }
+    }
+
+    inline Array IncrementalLinearLeastSquares::coefficients() const {
+        const Size m = qty_.size();
+        Array a(m, 0.0);
+        if (m == 0)
+            return a;
+
+        const SVD svd(r_);
+        const Matrix& V = svd.V();
+        const Matrix& U = svd.U();
+        const Array& w = svd.singularValues();
+        const Real threshold = size_*QL_EPSILON;
+
+        for (Size i=0; i<m; ++i) {
+            if (w[i] > threshold) {
+                const Real u = std::inner_product(U.column_begin(i),
+                                                  U.column_end(i),
+                                                  qty_.begin(), 0.0)/w[i];
+                for (Size j=0; j<m; ++j)
+                    a[j] += u*V[j][i];
+            }
+        }
+        return a;
+    }
+
+}
+
+#endif
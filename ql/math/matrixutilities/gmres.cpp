@@ -0,0 +1,145 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gmres.cpp
+    \brief generalized minimal residual method
+*/
+
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    GMRES::GMRES(const GMRES::MatrixMult& A, Size maxIter, Real relTol,
+                 const GMRES::MatrixMult& preConditioner)
+    : A_(A), M_(preConditioner), maxIter_(maxIter), relTol_(relTol) {
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater than zero");
+    }
+
+    GMRESResult GMRES::solve(const Array& b, const Array& x0) const {
+        const GMRESResult result = solveImpl(b, x0);
+
+        QL_REQUIRE(result.errors.back() < relTol_, "could not converge");
+
+        return result;
+    }
+
+    GMRESResult GMRES::solveWithRestart(Size restart, const Array& b,
+                                        const Array& x0) const {
+        GMRESResult result = solveImpl(b, x0);
+        std::list<Real> errors = result.errors;
+
+        for (Size i=0; i < restart && errors.back() >= relTol_; ++i) {
+            result = solveImpl(b, result.x);
+            errors.insert(errors.end(),
+                          result.errors.begin(), result.errors.end());
+        }
+
+        QL_REQUIRE(errors.back() < relTol_, "could not converge");
+
+        result.errors = errors;
+        return result;
+    }
+
+    GMRESResult GMRES::solveImpl(const Array& b, const Array& x0) const {
+        const Real bn = norm2(b);
+        if (bn == 0.0) {
+            GMRESResult result = { std::list<Real>(1, 0.0), b };
+            return result;
+        }
+
+        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        const Array r = b - A_(x);
+
+        const Real g = norm2(r);
+        std::list<Real> errors(1, g/bn);
+        if (errors.back() < relTol_) {
+            GMRESResult result = { errors, x };
+            return result;
+        }
+
+        // Krylov basis and Hessenberg matrix, the latter stored by
+        // columns and reduced to upper triangular form on the fly
+        std::vector<Array> v(1, r/g);
+        std::vector<Array> h;
+        std::vector<Real> c(maxIter_), s(maxIter_), z(maxIter_+1, 0.0);
+        z[0] = g;
+
+        for (Size j=0; j < maxIter_; ++j) {
+            Array w = A_((M_) ? M_(v[j]) : v[j]);
+
+            h.push_back(Array(j+2, 0.0));
+            Array& hj = h.back();
+            for (Size i=0; i <= j; ++i) {
+                hj[i] = DotProduct(w, v[i]);
+                w -= hj[i]*v[i];
+            }
+            hj[j+1] = norm2(w);
+            const Real wn = hj[j+1];
+
+            for (Size i=0; i < j; ++i) {
+                const Real h0 =  c[i]*hj[i] + s[i]*hj[i+1];
+                const Real h1 = -s[i]*hj[i] + c[i]*hj[i+1];
+                hj[i]   = h0;
+                hj[i+1] = h1;
+            }
+
+            const Real nu = std::sqrt(hj[j]*hj[j] + hj[j+1]*hj[j+1]);
+            QL_REQUIRE(nu > 0.0, "singular system");
+            c[j] = hj[j]/nu;
+            s[j] = hj[j+1]/nu;
+            hj[j]   = nu;
+            hj[j+1] = 0.0;
+
+            z[j+1] = -s[j]*z[j];
+            z[j]   =  c[j]*z[j];
+
+            errors.push_back(std::fabs(z[j+1])/bn);
+
+            // stop on convergence or if the Krylov space is invariant
+            if (errors.back() < relTol_ || wn == 0.0)
+                break;
+
+            v.push_back(w/wn);
+        }
+
+        // back substitution for the coefficients of the basis vectors
+        const Size k = h.size();
+        Array y(k);
+        for (Size i=k; i > 0; --i) {
+            Real sum = z[i-1];
+            for (Size l=i; l < k; ++l)
+                sum -= h[l][i-1]*y[l];
+            y[i-1] = sum/h[i-1][i-1];
+        }
+
+        Array xm(b.size(), 0.0);
+        for (Size i=0; i < k; ++i)
+            xm += y[i]*v[i];
+
+        x += (M_) ? M_(xm) : xm;
+
+        GMRESResult result = { errors, x };
+        return result;
+    }
+
+    Real GMRES::norm2(const Array& a) const {
+        return std::sqrt(DotProduct(a, a));
+    }
+}
@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gmres.hpp
+    \brief generalized minimal residual method
+*/
+
+#ifndef quantlib_gmres_hpp
+#define quantlib_gmres_hpp
+
+#include <ql/math/array.hpp>
+#include <boost/function.hpp>
+#include <list>
+
+namespace QuantLib {
+
+    struct GMRESResult {
+        std::list<Real> errors;
+        Array x;
+    };
+
+    //! generalized minimal residual method
+    /*! Solves \f$ A x = b \f$ for a general non-singular matrix given
+        only through its action on a vector.  The Krylov basis is
+        built with the modified Gram-Schmidt method and the least-
+        squares problem is solved by Givens rotations.  The optional
+        preconditioner \f$ M \approx A^{-1} \f$ is applied on the
+        right, so that the residuals are those of the original
+        system.
+
+        solve() builds at most maxIter basis vectors; the memory
+        needed is therefore proportional to maxIter times the size
+        of the system.  solveWithRestart() keeps this bounded for
+        large systems by restarting from the current approximation
+        after maxIter iterations.
+
+        \test the solution is checked against the matrix used to
+              build the system.
+    */
+    class GMRES  {
+      public:
+        typedef boost::function1<Disposable<Array> , const Array& > MatrixMult;
+
+        GMRES(const MatrixMult& A, Size maxIter, Real relTol,
+              const MatrixMult& preConditioner = MatrixMult());
+
+        GMRESResult solve(const Array& b, const Array& x0 = Array()) const;
+        GMRESResult solveWithRestart(Size restart, const Array& b,
+                                     const Array& x0 = Array()) const;
+
+      protected:
+        GMRESResult solveImpl(const Array& b, const Array& x0) const;
+        Real norm2(const Array& a) const;
+
+        const MatrixMult A_, M_;
+        const Size maxIter_;
+        const Real relTol_;
+    };
+}
+
+#endif
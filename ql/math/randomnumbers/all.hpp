@@ -4,6 +4,7 @@
 #include <ql/math/randomnumbers/boxmullergaussianrng.hpp>
 #include <ql/math/randomnumbers/centrallimitgaussianrng.hpp>
 #include <ql/math/randomnumbers/faurersg.hpp>
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/math/randomnumbers/haltonrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
@@ -61,6 +61,14 @@ namespace QuantLib {
             return sequence_;
         }
         const sample_type& lastSequence() const { return sequence_; }
+        //! skip the next \f$ n \f$ samples
+        /*! The skipped draws are generated; the cost grows
+            linearly with \f$ n \f$.
+        */
+        void skip(BigNatural n) {
+            for (BigNatural i=0; i<n; ++i)
+                generateNextIntSequence();
+        }
         Size dimension() const { return dimensionality_; }
       private:
         void generateNextIntSequence() const;
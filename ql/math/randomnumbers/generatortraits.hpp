@@ -0,0 +1,62 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file generatortraits.hpp
+    \brief capabilities of random-number and path generators
+*/
+
+#ifndef quantlib_generator_traits_hpp
+#define quantlib_generator_traits_hpp
+
+#include <boost/type_traits.hpp>
+
+namespace QuantLib {
+
+    //! whether a generator can skip ahead efficiently
+    /*! True if the generator provides a <tt>skip(BigNatural)</tt>
+        method whose cost doesn't grow linearly with the number of
+        skipped draws.  Monte Carlo models only split a simulation
+        among parallel workers, each skipping to its own slice of
+        the sequence, when this holds for the path generator.
+
+        The default is false; generators with an efficient skip()
+        specialize this class, and composite generators forward it
+        from the generators they wrap.
+    */
+    template <class G>
+    struct has_fast_skip : boost::false_type {};
+
+    //! whether a generator can draw a number of samples at once
+    /*! True if the generator provides a <tt>nextBlock()</tt> method
+        writing a number of consecutive samples to a buffer.  Monte
+        Carlo models only generate and price paths in blocks when
+        this holds for the path generator; otherwise, the paths are
+        drawn one at a time.
+
+        The default is false; generators with a nextBlock() method
+        specialize this class, and composite generators forward it
+        from the generators they wrap.
+    */
+    template <class G>
+    struct has_block_generation : boost::false_type {};
+
+}
+
+
+#endif
@@ -24,6 +24,7 @@
 #ifndef quantlib_halton_ld_rsg_h
 #define quantlib_halton_ld_rsg_h
 
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <vector>
 
@@ -51,6 +52,8 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! skip the next \f$ n \f$ samples
+        void skip(BigNatural n) { sequenceCounter_ += n; }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
@@ -59,6 +62,9 @@ namespace QuantLib {
         std::vector<unsigned long> randomStart_;
         std::vector<Real>  randomShift_;
     };
+
+    template <>
+    struct has_fast_skip<HaltonRsg> : boost::true_type {};
 }
 
 
@@ -25,7 +25,9 @@
 #ifndef quantlib_inversecumulative_rsg_h
 #define quantlib_inversecumulative_rsg_h
 
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -51,7 +53,28 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+        Distributions providing a faster batch version can overload
+        the applyInverseCumulative() function for IC.
+
+        Samples can also be generated in blocks by means of the
+        nextBlock() method, which requires USG to implement
+        \code
+            void USG::nextBlock(Size n, Real* out, Real* weights) const;
+        \endcode
+    */
+    //! applies an inverse cumulative distribution to a range of values
+    /*! This generic version calls the distribution on each value in
+        turn; it can be overloaded for distributions providing a
+        faster batch version.  The output can overwrite the input.
     */
+    template <class IC>
+    inline void applyInverseCumulative(const IC& ic,
+                                       const Real* begin, const Real* end,
+                                       Real* out) {
+        for (; begin != end; ++begin, ++out)
+            *out = ic(*begin);
+    }
+
     template <class USG, class IC>
     class InverseCumulativeRsg {
       public:
@@ -61,7 +84,17 @@ namespace QuantLib {
                              const IC& inverseCumulative);
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
+        //! write the next \f$ n \f$ samples to a contiguous buffer
+        /*! The buffer must hold \f$ n \f$ times dimension() values;
+            the samples are written one after the other.  If given,
+            the weights buffer receives their \f$ n \f$ weights.  The
+            last sample is also available from lastSequence().
+        */
+        void nextBlock(Size n, Real* out, Real* weights = 0) const;
         const sample_type& lastSequence() const { return x_; }
+        //! skip the next \f$ n \f$ samples
+        /*! \pre USG must provide a <tt>skip(BigNatural)</tt> method */
+        void skip(BigNatural n) { uniformSequenceGenerator_.skip(n); }
         Size dimension() const { return dimension_; }
       private:
         USG uniformSequenceGenerator_;
@@ -70,6 +103,14 @@ namespace QuantLib {
         IC ICD_;
     };
 
+    template <class USG, class IC>
+    struct has_fast_skip<InverseCumulativeRsg<USG, IC> >
+        : has_fast_skip<USG> {};
+
+    template <class USG, class IC>
+    struct has_block_generation<InverseCumulativeRsg<USG, IC> >
+        : has_block_generation<USG> {};
+
     template <class USG, class IC>
     InverseCumulativeRsg<USG, IC>::InverseCumulativeRsg(const USG& usg)
     : uniformSequenceGenerator_(usg),
@@ -87,15 +128,26 @@ namespace QuantLib {
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
-        typename USG::sample_type sample =
+        const typename USG::sample_type& sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        applyInverseCumulative(ICD_, &sample.value[0],
+                               &sample.value[0]+dimension_, &x_.value[0]);
         return x_;
     }
 
+    template <class USG, class IC>
+    inline void InverseCumulativeRsg<USG, IC>::nextBlock(
+                                                  Size n, Real* out,
+                                                  Real* weights) const {
+        if (n == 0)
+            return;
+        uniformSequenceGenerator_.nextBlock(n, out, weights);
+        applyInverseCumulative(ICD_, out, out+n*dimension_, out);
+        x_.weight = uniformSequenceGenerator_.lastSequence().weight;
+        std::copy(out+(n-1)*dimension_, out+n*dimension_, x_.value.begin());
+    }
+
 }
 
 
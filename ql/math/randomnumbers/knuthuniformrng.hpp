@@ -50,6 +50,14 @@ namespace QuantLib {
         /*! returns a sample with weight 1.0 containing a random number
           uniformly chosen from (0.0,1.0) */
         sample_type next() const;
+        //! skip the next \f$ n \f$ draws
+        /*! The skipped draws are generated; the cost grows
+            linearly with \f$ n \f$.
+        */
+        void skip(BigNatural n) {
+            for (BigNatural i=0; i<n; ++i)
+                next();
+        }
       private:
         static const int KK, LL, TT, QUALITY;
         mutable std::vector<double> ranf_arr_buf;
@@ -24,6 +24,7 @@
 #ifndef quantlib_lattice_rsg_hpp
 #define quantlib_lattice_rsg_hpp
 
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <vector>
 
@@ -39,6 +40,8 @@ namespace QuantLib {
              Size N);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(unsigned long n);
+        //! skip the next \f$ n \f$ samples
+        void skip(BigNatural n) { i_ += n; }
         const LatticeRsg::sample_type& nextSequence();     
         Size dimension() const { return dimensionality_; }
         const sample_type& lastSequence() const { return sequence_; }
@@ -54,6 +57,9 @@ namespace QuantLib {
            
     };
 
+    template <>
+    struct has_fast_skip<LatticeRsg> : boost::true_type {};
+
 }
 
 #endif
@@ -68,9 +68,173 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Polynomials over GF(2) are stored as bit vectors; the i-th
+           bit is the coefficient of t^i. */
+        typedef std::vector<unsigned long> Gf2Polynomial;
+
+        const Size wordBits = std::numeric_limits<unsigned long>::digits;
+
+        // degree of the characteristic polynomial of MT19937
+        const Size mexp = 19937;
+
+        /* below this number of draws, skipping by generating the
+           sequence is faster than jumping */
+        const BigNatural jumpThreshold = 1UL << 25;
+
+        inline bool coefficient(const Gf2Polynomial& p, Size i) {
+            return ((p[i/wordBits] >> (i%wordBits)) & 1UL) != 0;
+        }
+
+        inline void flip(Gf2Polynomial& p, Size i) {
+            p[i/wordBits] ^= 1UL << (i%wordBits);
+        }
+
+        inline bool parity(unsigned long x) {
+            for (Size s=wordBits/2; s>0; s/=2)
+                x ^= x >> s;
+            return (x & 1UL) != 0;
+        }
+
+        // coefficients i, i+1, ..., i+wordBits-1 packed in a word
+        inline unsigned long window(const Gf2Polynomial& p, Size i) {
+            Size w = i/wordBits, b = i%wordBits;
+            unsigned long lo = (w < p.size() ? p[w] : 0UL);
+            if (b == 0)
+                return lo;
+            unsigned long hi = (w+1 < p.size() ? p[w+1] : 0UL);
+            return (lo >> b) | (hi << (wordBits-b));
+        }
+
+        // p += q * t^shift
+        void addShifted(Gf2Polynomial& p, const Gf2Polynomial& q,
+                        Size shift) {
+            Size w = shift/wordBits, b = shift%wordBits;
+            for (Size i=0; i<q.size() && i+w<p.size(); ++i) {
+                if (q[i] == 0UL)
+                    continue;
+                p[i+w] ^= q[i] << b;
+                if (b != 0 && i+w+1 < p.size())
+                    p[i+w+1] ^= q[i] >> (wordBits-b);
+            }
+        }
+
+        /* The characteristic polynomial of the generator is obtained
+           as the minimal polynomial of one bit of its output, which
+           is computed by means of the Berlekamp-Massey algorithm. */
+        Gf2Polynomial computeCharacteristicPolynomial() {
+            const Size length = 2*mexp;
+            const Size words = length/wordBits + 2;
+
+            // the output bits are stored in reverse order
+            Gf2Polynomial reversed(words, 0UL);
+            MersenneTwisterUniformRng rng(5489UL);
+            for (Size i=0; i<length; ++i)
+                if (rng.nextInt32() & 1UL)
+                    flip(reversed, length-1-i);
+
+            Gf2Polynomial c(words, 0UL), b(words, 0UL), tmp;
+            c[0] = b[0] = 1UL;
+            Size l = 0, m = 1;
+            for (Size n=0; n<length; ++n) {
+                unsigned long d = 0UL;
+                for (Size k=0; k<=l/wordBits; ++k)
+                    d ^= c[k] & window(reversed, length-1-n+k*wordBits);
+                if (!parity(d)) {
+                    ++m;
+                } else if (2*l <= n) {
+                    tmp = c;
+                    addShifted(c, b, m);
+                    l = n+1-l;
+                    b.swap(tmp);
+                    m = 1;
+                } else {
+                    addShifted(c, b, m);
+                    ++m;
+                }
+            }
+            QL_ENSURE(l == mexp,
+                      "wrong linear complexity (" << l << ") found");
+
+            // the characteristic polynomial is the reciprocal of c
+            Gf2Polynomial p(mexp/wordBits+1, 0UL);
+            for (Size i=0; i<=mexp; ++i)
+                if (coefficient(c, i))
+                    flip(p, mexp-i);
+            return p;
+        }
+
+        const Gf2Polynomial& characteristicPolynomial() {
+            static Gf2Polynomial p;
+            #if defined(_OPENMP)
+            #pragma omp critical(ql_mt19937_characteristic_polynomial)
+            #endif
+            {
+                if (p.empty())
+                    p = computeCharacteristicPolynomial();
+            }
+            return p;
+        }
+
+        // q <- q mod p, given the multiples p*t^i for i < wordBits
+        void reduce(Gf2Polynomial& q,
+                    const std::vector<Gf2Polynomial>& shiftedP) {
+            for (Size i=q.size()*wordBits; i-- > mexp; ) {
+                if (coefficient(q, i)) {
+                    Size s = i-mexp, w = s/wordBits;
+                    const Gf2Polynomial& p = shiftedP[s%wordBits];
+                    for (Size k=0; k<p.size() && w+k<q.size(); ++k)
+                        q[w+k] ^= p[k];
+                }
+            }
+        }
+
+        // t^n mod p, computed by repeated squaring
+        Gf2Polynomial jumpPolynomial(BigNatural n) {
+            const Gf2Polynomial& p = characteristicPolynomial();
+            const Size words = mexp/wordBits + 1;
+
+            std::vector<Gf2Polynomial> shiftedP(wordBits,
+                                                Gf2Polynomial(words+1, 0UL));
+            for (Size b=0; b<wordBits; ++b)
+                addShifted(shiftedP[b], p, b);
+
+            Gf2Polynomial q(2*words, 0UL), square(2*words, 0UL);
+            q[0] = 1UL;
+            Size top = std::numeric_limits<BigNatural>::digits;
+            while (top > 0 && !((n >> (top-1)) & 1UL))
+                --top;
+            for (Size j=top; j-- > 0; ) {
+                std::fill(square.begin(), square.end(), 0UL);
+                for (Size i=0; i<mexp; ++i)
+                    if (coefficient(q, i))
+                        flip(square, 2*i);
+                reduce(square, shiftedP);
+                q.swap(square);
+                if ((n >> j) & 1UL) {
+                    // multiply by t
+                    unsigned long carry = 0UL;
+                    for (Size k=0; k<words; ++k) {
+                        unsigned long next = q[k] >> (wordBits-1);
+                        q[k] = (q[k] << 1) | carry;
+                        carry = next;
+                    }
+                    reduce(q, shiftedP);
+                }
+            }
+            q.resize(words);
+            return q;
+        }
+
+    }
+
     // constant vector a
     const unsigned long MersenneTwisterUniformRng::MATRIX_A = 0x9908b0dfUL;
     // most significant w-r bits
@@ -142,4 +306,52 @@ namespace QuantLib {
         mti = 0;
     }
 
+    void MersenneTwisterUniformRng::skip(BigNatural n) {
+        // use the words left from the last twist first
+        Size left = N-mti;
+        if (n <= left) {
+            mti += n;
+            return;
+        }
+        n -= left;
+        if (n < jumpThreshold) {
+            for (BigNatural i=0; i<=n/N; ++i)
+                twist();
+            mti = n%N;
+        } else {
+            jump(n);
+        }
+    }
+
+    /* On entry, mt contains the last N generated words; on exit, it
+       contains the N words that would be generated after n more. */
+    void MersenneTwisterUniformRng::jump(BigNatural n) {
+        static const unsigned long mag01[2]={0x0UL, MATRIX_A};
+        const Gf2Polynomial q = jumpPolynomial(n);
+
+        // evaluate q(F)(mt) by Horner's scheme, F being the transition
+        // function of the generator; s is a circular buffer starting
+        // at index i.
+        unsigned long s[N];
+        std::fill(s, s+N, 0UL);
+        Size i = 0;
+        for (Size j=mexp; j-- > 0; ) {
+            Size i1 = (i+1 == N ? 0 : i+1);
+            Size iM = (i+M >= N ? i+M-N : i+M);
+            unsigned long y = (s[i]&UPPER_MASK)|(s[i1]&LOWER_MASK);
+            s[i] = s[iM] ^ (y >> 1) ^ mag01[y & 0x1UL];
+            i = i1;
+            if (coefficient(q, j)) {
+                for (Size k=0, h=i; k<N; ++k) {
+                    s[h] ^= mt[k];
+                    if (++h == N)
+                        h = 0;
+                }
+            }
+        }
+        for (Size k=0; k<N; ++k)
+            mt[k] = s[(i+k)%N];
+        mti = N;
+    }
+
 }
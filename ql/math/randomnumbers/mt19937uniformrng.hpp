@@ -25,6 +25,7 @@
 #ifndef quantlib_mersennetwister_uniform_rng_hpp
 #define quantlib_mersennetwister_uniform_rng_hpp
 
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <vector>
 
@@ -35,8 +36,19 @@ namespace QuantLib {
 
         For more details see http://www.math.keio.ac.jp/matumoto/emt.html
 
-        \test the correctness of the returned values is tested by
-              checking them against known good results.
+        The generator can be moved forward along its sequence by
+        means of the skip() method; for large skips, this uses the
+        polynomial jump-ahead algorithm described in H. Haramoto,
+        M. Matsumoto, T. Nishimura, F. Panneton and P. L'Ecuyer,
+        "Efficient jump ahead for F2-linear random number generators",
+        INFORMS Journal on Computing 20(3), 2008, whose cost grows with
+        the logarithm of the number of skipped draws.
+
+        \test
+        - the correctness of the returned values is tested by
+          checking them against known good results.
+        - the results of skip() are checked against the equivalent
+          sequence of draws.
     */
     class MersenneTwisterUniformRng {
       private:
@@ -70,14 +82,23 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        //! skip the next \f$ n \f$ draws of the sequence
+        /*! After the call, the generator returns the same numbers it
+            would return after \f$ n \f$ calls to nextInt32().
+        */
+        void skip(BigNatural n);
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
+        void jump(BigNatural n);
         mutable unsigned long mt[N];
         mutable Size mti;
         static const unsigned long MATRIX_A, UPPER_MASK, LOWER_MASK;
     };
 
+    template <>
+    struct has_fast_skip<MersenneTwisterUniformRng> : boost::true_type {};
+
 }
 
 
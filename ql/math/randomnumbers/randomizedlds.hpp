@@ -69,6 +69,8 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return x;
         }
+        //! skip the next \f$ n \f$ samples
+        void skip(BigNatural n) { ldsg_.skip(n); }
         /*! update the randomizing vector and re-initialize
             the low discrepancy generator */
         void nextRandomizer() {
@@ -133,6 +135,9 @@ namespace QuantLib {
     return x;
     }
 
+    template <class LDS, class PRS>
+    struct has_fast_skip<RandomizedLDS<LDS, PRS> > : has_fast_skip<LDS> {};
+
 }
 
 
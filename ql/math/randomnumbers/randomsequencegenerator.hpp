@@ -24,8 +24,10 @@
 #ifndef quantlib_random_sequence_generator_h
 #define quantlib_random_sequence_generator_h
 
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -43,6 +45,10 @@ namespace QuantLib {
         \code
             unsigned long RNG::nextInt32() const;
         \endcode
+        and if it wants to use the skip method,
+        \code
+            void RNG::skip(BigNatural n);
+        \endcode
 
         \warning do not use with low-discrepancy sequence generator.
     */
@@ -66,14 +72,28 @@ namespace QuantLib {
           int32Sequence_(dimensionality) {}
 
         const sample_type& nextSequence() const {
-            sequence_.weight = 1.0;
-            for (Size i=0; i<dimensionality_; i++) {
-                typename RNG::sample_type x(rng_.next());
-                sequence_.value[i] = x.value;
-                sequence_.weight  *= x.weight;
-            }
+            sequence_.weight = fill(&sequence_.value[0]);
             return sequence_;
         }
+        //! write the next \f$ n \f$ sequences to a contiguous buffer
+        /*! The buffer must hold \f$ n \f$ times dimension() values;
+            the sequences are written one after the other.  If given,
+            the weights buffer receives their \f$ n \f$ weights.  The
+            last sequence is also available from lastSequence().
+        */
+        void nextBlock(Size n, Real* out, Real* weights = 0) const {
+            if (n == 0)
+                return;
+            for (Size j=0; j<n-1; j++, out += dimensionality_) {
+                Real weight = fill(out);
+                if (weights)
+                    weights[j] = weight;
+            }
+            sequence_.weight = fill(&sequence_.value[0]);
+            std::copy(sequence_.value.begin(), sequence_.value.end(), out);
+            if (weights)
+                weights[n-1] = sequence_.weight;
+        }
         std::vector<BigNatural> nextInt32Sequence() const {
             for (Size i=0; i<dimensionality_; i++) {
                 int32Sequence_[i] = rng_.nextInt32();
@@ -83,14 +103,36 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! skip the next \f$ n \f$ sequences
+        void skip(BigNatural n) {
+            rng_.skip(n*dimensionality_);
+        }
         Size dimension() const {return dimensionality_;}
       private:
+        // writes the next sequence to out and returns its weight
+        Real fill(Real* out) const {
+            Real weight = 1.0;
+            for (Size i=0; i<dimensionality_; i++) {
+                typename RNG::sample_type x(rng_.next());
+                out[i] = x.value;
+                weight *= x.weight;
+            }
+            return weight;
+        }
         Size dimensionality_;
         RNG rng_;
         mutable sample_type sequence_;
         mutable std::vector<BigNatural> int32Sequence_;
     };
 
+    template <class RNG>
+    struct has_fast_skip<RandomSequenceGenerator<RNG> >
+        : has_fast_skip<RNG> {};
+
+    template <class RNG>
+    struct has_block_generation<RandomSequenceGenerator<RNG> >
+        : boost::true_type {};
+
 }
 
 
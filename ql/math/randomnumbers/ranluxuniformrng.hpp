@@ -53,6 +53,15 @@ namespace QuantLib {
             return sample_type(ranlux3_(), 1.0);
         }
 
+        //! skip the next \f$ n \f$ draws
+        /*! The skipped draws are generated; the cost grows
+            linearly with \f$ n \f$.
+        */
+        void skip(BigNatural n) {
+            for (BigNatural i=0; i<n; ++i)
+                ranlux3_();
+        }
+
       private:
         mutable boost::ranlux64_3_01 ranlux3_;
     };
@@ -68,6 +77,15 @@ namespace QuantLib {
             return sample_type(ranlux4_(), 1.0);
         }
 
+        //! skip the next \f$ n \f$ draws
+        /*! The skipped draws are generated; the cost grows
+            linearly with \f$ n \f$.
+        */
+        void skip(BigNatural n) {
+            for (BigNatural i=0; i<n; ++i)
+                ranlux4_();
+        }
+
       private:
         mutable boost::ranlux64_4_01 ranlux4_;
     };
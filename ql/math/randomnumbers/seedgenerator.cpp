@@ -18,6 +18,9 @@
 */
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <limits>
 #include <ctime>
 #if defined(BOOST_NO_STDC_NAMESPACE)
     namespace std { using ::time; }
@@ -60,4 +63,26 @@ namespace QuantLib {
         return rng_.nextInt32();
     }
 
+
+    StreamGenerator::StreamGenerator(unsigned long seed,
+                                     BigNatural streamLength)
+    : seed_(seed != 0 ? seed : SeedGenerator::instance().get()),
+      streamLength_(streamLength) {
+        QL_REQUIRE(streamLength_ > 0, "null stream length given");
+    }
+
+    MersenneTwisterUniformRng StreamGenerator::stream(Size i) const {
+        MersenneTwisterUniformRng rng(seed_);
+        // skip i*L draws, in chunks small enough not to overflow
+        const BigNatural maxStreams =
+            std::numeric_limits<BigNatural>::max()/streamLength_;
+        BigNatural n = i;
+        while (n > 0) {
+            BigNatural m = std::min(n, maxStreams);
+            rng.skip(m*streamLength_);
+            n -= m;
+        }
+        return rng;
+    }
+
 }
@@ -45,6 +45,32 @@ namespace QuantLib {
         MersenneTwisterUniformRng rng_;
     };
 
+
+    //! Generator of non-overlapping random-number streams
+    /*! All streams are taken from the same Mersenne-twister
+        sequence; the i-th stream starts \f$ i L \f$ draws into the
+        sequence, \f$ L \f$ being the given stream length.
+        Therefore, the streams do not overlap as long as no more than
+        \f$ L \f$ numbers are drawn from each of them.  If the given
+        seed is 0, the sequence is initialized with a seed obtained
+        from SeedGenerator.
+
+        \test the streams are checked against the corresponding
+              slices of the underlying sequence.
+    */
+    class StreamGenerator {
+      public:
+        explicit StreamGenerator(unsigned long seed = 0,
+                                 BigNatural streamLength = 1UL << 31);
+        //! returns a generator positioned at the start of the i-th stream
+        MersenneTwisterUniformRng stream(Size i) const;
+        unsigned long seed() const { return seed_; }
+        BigNatural streamLength() const { return streamLength_; }
+      private:
+        unsigned long seed_;
+        BigNatural streamLength_;
+    };
+
 }
 
 
@@ -32,20 +32,34 @@ namespace QuantLib {
         SobolRsg::DirectionIntegers directionIntegers)
     : factors_(factors), steps_(steps), dim_(factors*steps),
       seq_(sample_type::value_type(factors*steps), 1.0),
-      gen_(factors, steps, ordering, seed, directionIntegers) {
+      gen_(factors, steps, ordering, seed, directionIntegers),
+      output_(factors) {
     }
 
     const SobolBrownianBridgeRsg::sample_type&
     SobolBrownianBridgeRsg::nextSequence() const {
+        fill(&seq_.value[0]);
+        return seq_;
+    }
+
+    void SobolBrownianBridgeRsg::nextBlock(Size n, Real* out,
+                                           Real* weights) const {
+        if (n == 0)
+            return;
+        for (Size j=0; j<n-1; ++j, out += dim_)
+            fill(out);
+        fill(&seq_.value[0]);
+        std::copy(seq_.value.begin(), seq_.value.end(), out);
+        if (weights)
+            std::fill(weights, weights+n, 1.0);
+    }
+
+    void SobolBrownianBridgeRsg::fill(Real* out) const {
         gen_.nextPath();
-        std::vector<Real> output(factors_);
         for (Size i=0; i < steps_; ++i) {
-            gen_.nextStep(output);
-            std::copy(output.begin(), output.end(),
-                      seq_.value.begin()+i*factors_);
+            gen_.nextStep(output_);
+            out = std::copy(output_.begin(), output_.end(), out);
         }
-
-        return seq_;
     }
 
     const SobolBrownianBridgeRsg::sample_type&
@@ -26,6 +26,7 @@
 #define quantlib_sobol_brownian_bridge_rsg_hpp
 
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
+#include <ql/math/randomnumbers/generatortraits.hpp>
 
 namespace QuantLib {
 
@@ -41,14 +42,29 @@ namespace QuantLib {
                                    = SobolRsg::JoeKuoD7);
 
         const sample_type& nextSequence() const;
+        //! write the next \f$ n \f$ samples to a contiguous buffer
+        /*! The buffer must hold \f$ n \f$ times dimension() values;
+            the samples are written one after the other.  If given,
+            the weights buffer receives their \f$ n \f$ weights, which
+            are all equal to 1.  The last sample is also available
+            from lastSequence().
+        */
+        void nextBlock(Size n, Real* out, Real* weights = 0) const;
         const sample_type& lastSequence() const;
         Size dimension() const;
 
       private:
+        void fill(Real* out) const;
         const Size factors_, steps_, dim_;
         mutable sample_type seq_;
         mutable SobolBrownianGenerator gen_;
+        mutable std::vector<Real> output_;
     };
+
+    template <>
+    struct has_block_generation<SobolBrownianBridgeRsg>
+        : boost::true_type {};
+
 }
 
 #endif
@@ -26,7 +26,9 @@
 #ifndef quantlib_sobol_ld_rsg_hpp
 #define quantlib_sobol_ld_rsg_hpp
 
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -116,17 +118,50 @@ namespace QuantLib {
                  DirectionIntegers directionIntegers = Jaeckel);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(unsigned long n);
+        //! skip the next \f$ n \f$ samples
+        /*! The position in the sequence is given by the Gray-code
+            index, so the cost of the skip does not depend on
+            \f$ n \f$.
+        */
+        void skip(BigNatural n) {
+            // drawn so far; after a skip, the current integer
+            // sequence is the next one to be returned
+            unsigned long drawn =
+                firstDraw_ ? sequenceCounter_ : sequenceCounter_+1;
+            skipTo(drawn+n);
+            firstDraw_ = true;
+        }
         const std::vector<unsigned long>& nextInt32Sequence() const;
         const SobolRsg::sample_type& nextSequence() const {
-            const std::vector<unsigned long>& v = nextInt32Sequence();
-            // normalize to get a double in (0,1)
-            for (Size k=0; k<dimensionality_; ++k)
-                sequence_.value[k] = v[k] * normalizationFactor_;
+            fill(&sequence_.value[0]);
             return sequence_;
         }
+        //! write the next \f$ n \f$ samples to a contiguous buffer
+        /*! The buffer must hold \f$ n \f$ times dimension() values;
+            the samples are written one after the other.  If given,
+            the weights buffer receives their \f$ n \f$ weights, which
+            are all equal to 1.  The last sample is also available
+            from lastSequence().
+        */
+        void nextBlock(Size n, Real* out, Real* weights = 0) const {
+            if (n == 0)
+                return;
+            for (Size j=0; j<n-1; ++j, out += dimensionality_)
+                fill(out);
+            fill(&sequence_.value[0]);
+            std::copy(sequence_.value.begin(), sequence_.value.end(), out);
+            if (weights)
+                std::fill(weights, weights+n, 1.0);
+        }
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
+        void fill(Real* out) const {
+            const std::vector<unsigned long>& v = nextInt32Sequence();
+            // normalize to get a double in (0,1)
+            for (Size k=0; k<dimensionality_; ++k)
+                out[k] = v[k] * normalizationFactor_;
+        }
         static const int bits_;
         static const double normalizationFactor_;
         Size dimensionality_;
@@ -137,6 +172,12 @@ namespace QuantLib {
         std::vector<std::vector<unsigned long> > directionIntegers_;
     };
 
+    template <>
+    struct has_fast_skip<SobolRsg> : boost::true_type {};
+
+    template <>
+    struct has_block_generation<SobolRsg> : boost::true_type {};
+
 }
 
 #endif
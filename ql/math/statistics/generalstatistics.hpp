@@ -167,6 +167,8 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the data collected by another instance
+        void merge(const GeneralStatistics& other);
 
         //! resets the data to a null set
         void reset();
@@ -225,6 +227,17 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        if (&other == this) {
+            std::vector<std::pair<Real,Real> > data(samples_);
+            samples_.insert(samples_.end(), data.begin(), data.end());
+        } else {
+            samples_.insert(samples_.end(),
+                            other.samples_.begin(), other.samples_.end());
+        }
+        sorted_ = sorted_ && other.samples_.empty();
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
@@ -38,7 +38,7 @@ namespace QuantLib {
     Real IncrementalStatistics::mean() const {
         QL_REQUIRE(sampleWeight_>0.0,
                    "sampleWeight_=0, unsufficient");
-        return sum_/sampleWeight_;
+        return mean_;
     }
 
     Real IncrementalStatistics::variance() const {
@@ -47,9 +47,7 @@ namespace QuantLib {
         QL_REQUIRE(sampleNumber_>1,
                    "sample number <=1, unsufficient");
 
-        Real m = mean();
-        Real v = quadraticSum_/sampleWeight_;
-        v -= m*m;
+        Real v = secondMoment_/sampleWeight_;
         v *= sampleNumber_/(sampleNumber_-1.0);
 
 
@@ -94,10 +92,7 @@ namespace QuantLib {
 
         if (s==0.0) return 0.0;
 
-        Real m = mean();
-        Real result = cubicSum_/sampleWeight_;
-        result -= 3.0*m*(quadraticSum_/sampleWeight_);
-        result += 2.0*m*m*m;
+        Real result = thirdMoment_/sampleWeight_;
         result /= s*s*s;
         result *= sampleNumber_/(sampleNumber_-1.0);
         result *= sampleNumber_/(sampleNumber_-2.0);
@@ -108,7 +103,6 @@ namespace QuantLib {
         QL_REQUIRE(sampleNumber_>3,
                    "sample number <=3, unsufficient");
 
-        Real m = mean();
         Real v = variance();
 
         Real c = (sampleNumber_-1.0)/(sampleNumber_-2.0);
@@ -117,10 +111,7 @@ namespace QuantLib {
 
         if (v==0) return c;
 
-        Real result = fourthPowerSum_/sampleWeight_;
-        result -= 4.0*m*(cubicSum_/sampleWeight_);
-        result += 6.0*m*m*(quadraticSum_/sampleWeight_);
-        result -= 3.0*m*m*m*m;
+        Real result = fourthMoment_/sampleWeight_;
         result /= v*v;
         result *= sampleNumber_/(sampleNumber_-1.0);
         result *= sampleNumber_/(sampleNumber_-2.0);
@@ -149,21 +140,13 @@ namespace QuantLib {
         QL_ENSURE(sampleNumber_ > oldSamples,
                   "maximum number of samples reached");
 
-        sampleWeight_ += weight;
+        combine(weight, value, 0.0, 0.0, 0.0);
 
-        Real temp = weight*value;
-        sum_ += temp;
-        temp *= value;
-        quadraticSum_ += temp;
         if (value<0.0) {
-            downsideQuadraticSum_ += temp;
+            downsideQuadraticSum_ += weight*value*value;
             downsideSampleNumber_++;
             downsideSampleWeight_ += weight;
         }
-        temp *= value;
-        cubicSum_ += temp;
-        temp *= value;
-        fourthPowerSum_ += temp;
         if (oldSamples == 0) {
             min_ = max_ = value;
         } else {
@@ -172,6 +155,63 @@ namespace QuantLib {
         }
     }
 
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        if (other.sampleNumber_ == 0)
+            return;
+
+        Size oldSamples = sampleNumber_;
+        sampleNumber_ += other.sampleNumber_;
+        QL_ENSURE(sampleNumber_ > oldSamples,
+                  "maximum number of samples reached");
+
+        combine(other.sampleWeight_, other.mean_, other.secondMoment_,
+                other.thirdMoment_, other.fourthMoment_);
+
+        downsideQuadraticSum_ += other.downsideQuadraticSum_;
+        downsideSampleNumber_ += other.downsideSampleNumber_;
+        downsideSampleWeight_ += other.downsideSampleWeight_;
+        if (oldSamples == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(other.min_, min_);
+            max_ = std::max(other.max_, max_);
+        }
+    }
+
+    void IncrementalStatistics::combine(Real weight, Real mean,
+                                        Real secondMoment,
+                                        Real thirdMoment,
+                                        Real fourthMoment) {
+        if (weight == 0.0)
+            return;
+        if (sampleWeight_ == 0.0) {
+            sampleWeight_ = weight;
+            mean_ = mean;
+            secondMoment_ = secondMoment;
+            thirdMoment_ = thirdMoment;
+            fourthMoment_ = fourthMoment;
+            return;
+        }
+
+        // pairwise update of the central moments; the higher moments
+        // must be updated first since they use the old lower ones.
+        Real wa = sampleWeight_, wb = weight, w = wa+wb;
+        Real delta = mean-mean_;
+        Real d = delta/w, d2 = d*d;
+
+        fourthMoment_ += fourthMoment
+            + delta*d*d2*wa*wb*(wa*wa-wa*wb+wb*wb)
+            + 6.0*d2*(wa*wa*secondMoment+wb*wb*secondMoment_)
+            + 4.0*d*(wa*thirdMoment-wb*thirdMoment_);
+        thirdMoment_ += thirdMoment
+            + delta*d2*wa*wb*(wa-wb)
+            + 3.0*d*(wa*secondMoment-wb*secondMoment_);
+        secondMoment_ += secondMoment + delta*d*wa*wb;
+        mean_ += d*wb;
+        sampleWeight_ = w;
+    }
+
     void IncrementalStatistics::reset() {
         min_ = QL_MAX_REAL;
         max_ = QL_MIN_REAL;
@@ -179,11 +219,11 @@ namespace QuantLib {
         downsideSampleNumber_ = 0;
         sampleWeight_ = 0.0;
         downsideSampleWeight_ = 0.0;
-        sum_ = 0.0;
-        quadraticSum_ = 0.0;
+        mean_ = 0.0;
         downsideQuadraticSum_ = 0.0;
-        cubicSum_ = 0.0;
-        fourthPowerSum_ = 0.0;
+        secondMoment_ = 0.0;
+        thirdMoment_ = 0.0;
+        fourthMoment_ = 0.0;
     }
 
 }
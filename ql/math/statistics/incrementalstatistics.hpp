@@ -34,8 +34,13 @@ namespace QuantLib {
     /*! It can accumulate a set of data and return statistics (e.g: mean,
         variance, skewness, kurtosis, error estimation, etc.)
 
-        \warning high moments are numerically unstable for high
-                 average/standardDeviation ratios.
+        Central moments are accumulated by means of the pairwise
+        update formulas in Chan, Golub and LeVeque, "Updating Formulae
+        and a Pairwise Algorithm for Computing Sample Variances"
+        (1979), extended to higher moments by Pebay (2008).  This
+        avoids the cancellation errors of raw power sums and allows
+        partial results (e.g., from parallel simulations) to be
+        merged.
     */
     class IncrementalStatistics {
       public:
@@ -126,15 +131,24 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the data collected by another instance
+        /*! The result is the same (up to rounding) as if the data
+            added to the other instance were added to this one.
+        */
+        void merge(const IncrementalStatistics& other);
         //! resets the data to a null set
         void reset();
         //@}
       protected:
         Size sampleNumber_, downsideSampleNumber_;
         Real sampleWeight_, downsideSampleWeight_;
-        Real sum_, quadraticSum_, downsideQuadraticSum_,
-            cubicSum_, fourthPowerSum_;
+        Real mean_, downsideQuadraticSum_;
+        // weighted sums of the powers of the deviations from the mean
+        Real secondMoment_, thirdMoment_, fourthMoment_;
         Real min_, max_;
+      private:
+        void combine(Real weight, Real mean, Real secondMoment,
+                     Real thirdMoment, Real fourthMoment);
     };
 
 }
@@ -43,6 +43,10 @@ namespace QuantLib {
         requested to the 1-D underlying StatisticsType class, with the
         usual compile-time checks provided by the template approach.
 
+        The covariance is accumulated as a matrix of central
+        co-moments, which is updated and merged with the pairwise
+        formulas of Chan, Golub and LeVeque.
+
         \test the correctness of the returned values is tested by
               checking them against numerical calculations.
     */
@@ -132,19 +136,39 @@ namespace QuantLib {
                        " required, " << std::distance(begin, end) <<
                        " provided");
 
-            quadraticSum_ += weight * outerProduct(begin, end,
-                                                   begin, end);
+            Real oldWeight = sampleWeight_;
+            sampleWeight_ += weight;
+            if (weight > 0.0) {
+                Iterator it = begin;
+                for (Size i=0; i<dimension_; ++it, ++i)
+                    delta_[i] = *it - sampleMean_[i];
+                Real factor = weight*oldWeight/sampleWeight_;
+                for (Size i=0; i<dimension_; ++i) {
+                    sampleMean_[i] += delta_[i]*weight/sampleWeight_;
+                    for (Size j=0; j<=i; ++j)
+                        coMoments_[i][j] += factor*delta_[i]*delta_[j];
+                }
+            }
 
             for (Size i=0; i<dimension_; ++begin, ++i)
                 stats_[i].add(*begin, weight);
 
         }
+        //! adds the data collected by another instance
+        /*! \pre the underlying statistics class must provide a
+                 merge() method.
+        */
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
         Size dimension_;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
-        Matrix quadraticSum_;
+        // weighted sums of the products of deviations from the mean;
+        // only the lower triangle is stored
+        Matrix coMoments_;
+        std::vector<Real> sampleMean_, delta_;
+        Real sampleWeight_;
     };
 
     //! default multi-dimensional statistics tool
@@ -158,7 +182,7 @@ namespace QuantLib {
 
     template <class Stat>
     inline GenericSequenceStatistics<Stat>::GenericSequenceStatistics(Size dimension)
-    : dimension_(0) {
+    : dimension_(0), sampleWeight_(0.0) {
         reset(dimension);
     }
 
@@ -237,11 +261,45 @@ namespace QuantLib {
                 dimension_ = dimension;
                 stats_ = std::vector<Stat>(dimension);
                 results_ = std::vector<Real>(dimension);
+                delta_ = std::vector<Real>(dimension);
             }
-            quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
+            coMoments_ = Matrix(dimension_, dimension_, 0.0);
+            sampleMean_ = std::vector<Real>(dimension_, 0.0);
         } else {
             dimension_ = dimension;
         }
+        sampleWeight_ = 0.0;
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                   const GenericSequenceStatistics& other) {
+        if (other.samples() == 0)
+            return;
+        QL_REQUIRE(dimension_ == 0 || other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+        if (samples() == 0) {
+            *this = other;
+            return;
+        }
+
+        Real wa = sampleWeight_, wb = other.sampleWeight_, w = wa+wb;
+        if (wb > 0.0) {
+            for (Size i=0; i<dimension_; ++i)
+                delta_[i] = other.sampleMean_[i] - sampleMean_[i];
+            Real factor = wa*wb/w;
+            for (Size i=0; i<dimension_; ++i) {
+                sampleMean_[i] += delta_[i]*wb/w;
+                for (Size j=0; j<=i; ++j)
+                    coMoments_[i][j] += other.coMoments_[i][j]
+                                      + factor*delta_[i]*delta_[j];
+            }
+        }
+        sampleWeight_ = w;
+
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
     }
 
     template <class Stat>
@@ -254,14 +312,13 @@ namespace QuantLib {
         QL_REQUIRE(sampleNumber > 1.0,
                    "sample number <=1, unsufficient");
 
-        std::vector<Real> m = mean();
-        Real inv = 1.0/sampleWeight;
-
-        Matrix result = inv*quadraticSum_;
-        result -= outerProduct(m.begin(), m.end(),
-                               m.begin(), m.end());
+        Real factor = sampleNumber/(sampleNumber-1.0)/sampleWeight_;
 
-        result *= (sampleNumber/(sampleNumber-1.0));
+        Matrix result(dimension_, dimension_);
+        for (Size i=0; i<dimension_; ++i) {
+            for (Size j=0; j<=i; ++j)
+                result[i][j] = result[j][i] = factor*coMoments_[i][j];
+        }
         return result;
     }
 
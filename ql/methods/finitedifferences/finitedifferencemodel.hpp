@@ -71,7 +71,8 @@ namespace QuantLib {
                       Time from,
                       Time to,
                       Size steps) {
-            rollbackImpl(a,from,to,steps,(const condition_type*) 0);
+            const condition_type* condition = 0;
+            rollbackImpl(&a,&condition,1,from,to,steps);
         }
         /*! solves the problem between the given times,
             applying a condition at every step.
@@ -83,14 +84,36 @@ namespace QuantLib {
                       Time to,
                       Size steps,
                       const condition_type& condition) {
-            rollbackImpl(a,from,to,steps,&condition);
+            const condition_type* c = &condition;
+            rollbackImpl(&a,&c,1,from,to,steps);
+        }
+        /*! solves the problem between the given times for several
+            arrays at once, applying to each of them the corresponding
+            condition (if not null) at every step.  The arrays go
+            through the same sequence of steps, one after the other,
+            so that the evolver is set to each step size only once.
+            \warning being this a rollback, <tt>from</tt> must be a later
+                     time than <tt>to</tt>.
+        */
+        void rollback(std::vector<array_type>& a,
+                      Time from,
+                      Time to,
+                      Size steps,
+                      const std::vector<const condition_type*>& conditions) {
+            QL_REQUIRE(a.size() == conditions.size(),
+                       "number of arrays (" << a.size()
+                       << ") and of conditions (" << conditions.size()
+                       << ") do not match");
+            if (!a.empty())
+                rollbackImpl(&a[0],&conditions[0],a.size(),from,to,steps);
         }
       private:
-        void rollbackImpl(array_type& a,
+        void rollbackImpl(array_type* a,
+                          const condition_type* const* conditions,
+                          Size n,
                           Time from,
                           Time to,
-                          Size steps,
-                          const condition_type* condition) {
+                          Size steps) {
 
             QL_REQUIRE(from >= to,
                        "trying to roll back from " << from << " to " << to);
@@ -99,8 +122,9 @@ namespace QuantLib {
             evolver_.setStep(dt);
 
             if(!stoppingTimes_.empty() && stoppingTimes_.back() == from) {
-                if (condition)
-                    condition->applyTo(a,from);
+                for (Size k=0; k<n; ++k)
+                    if (conditions[k])
+                        conditions[k]->applyTo(a[k],from);
             }
             for (Size i=0; i<steps; ++i, t -= dt) {
                 Time now = t, next = t-dt;
@@ -113,9 +137,7 @@ namespace QuantLib {
 
                         // perform a small step to stoppingTimes_[j]...
                         evolver_.setStep(now-stoppingTimes_[j]);
-                        evolver_.step(a,now);
-                        if (condition)
-                            condition->applyTo(a,stoppingTimes_[j]);
+                        step(a,conditions,n,now,stoppingTimes_[j]);
                         // ...and continue the cycle
                         now = stoppingTimes_[j];
                     }
@@ -126,9 +148,7 @@ namespace QuantLib {
                     // complete the big one...
                     if (now > next) {
                         evolver_.setStep(now - next);
-                        evolver_.step(a,now);
-                        if (condition)
-                            condition->applyTo(a,next);
+                        step(a,conditions,n,now,next);
                     }
                     // ...and in any case, we have to reset the
                     // evolver to the default step.
@@ -136,12 +156,21 @@ namespace QuantLib {
                 } else {
                     // if we didn't, the evolver is already set to the
                     // default step, which is ok for us.
-                    evolver_.step(a,now);
-                    if (condition)
-                        condition->applyTo(a, next);
+                    step(a,conditions,n,now,next);
                 }
             }
         }
+        void step(array_type* a,
+                  const condition_type* const* conditions,
+                  Size n,
+                  Time now,
+                  Time next) {
+            for (Size k=0; k<n; ++k) {
+                evolver_.step(a[k],now);
+                if (conditions[k])
+                    conditions[k]->applyTo(a[k],next);
+            }
+        }
         Evolver evolver_;
         std::vector<Time> stoppingTimes_;
     };
@@ -25,9 +25,18 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        // differences in the drift and variance below this threshold
+        // are taken to be round-off from the term structures.
+        const Real coefficientTolerance = 1.0e-10;
+
+    }
+
     FdmBlackScholesOp::FdmBlackScholesOp(
         const boost::shared_ptr<FdmMesher>& mesher,
         const boost::shared_ptr<GeneralizedBlackScholesProcess> & bsProcess,
@@ -47,7 +56,8 @@ namespace QuantLib {
       mapT_  (direction, mesher),
       strike_(strike),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
-      direction_(direction) {
+      direction_(direction),
+      r_(Null<Rate>()), q_(Null<Rate>()), v_(Null<Real>()) {
     }
 
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
@@ -83,9 +93,20 @@ namespace QuantLib {
         else {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
-            mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
+
+            // with constant coefficients the operator is left as it
+            // is, so that mapT_ can reuse its factorization.
+            if (   r_ == Null<Rate>()
+                || std::fabs(r - r_) > coefficientTolerance
+                || std::fabs(q - q_) > coefficientTolerance
+                || std::fabs(v - v_) > coefficientTolerance) {
+                mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
                         dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
                         Array(1, -r));
+                r_ = r;
+                q_ = q;
+                v_ = v;
+            }
         }
     }
 
@@ -127,6 +148,40 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply(const Array& u, Array& out) const {
+        mapT_.apply(u, out);
+    }
+
+    void FdmBlackScholesOp::apply_direction(Size direction,
+                                            const Array& r,
+                                            Array& out) const {
+        if (direction == direction_)
+            mapT_.apply(r, out);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmBlackScholesOp::apply_mixed(const Array& r, Array& out) const {
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::solve_splitting(Size direction,
+                                            const Array& r, Real dt,
+                                            Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, dt, 1.0, out);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::copy(r.begin(), r.end(), out.begin());
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmBlackScholesOp::toMatrixDecomp() const {
@@ -0,0 +1,144 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/volatility/equityfx/blackvoltermstructure.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholessensitivityop.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    FdmBlackScholesSensitivityOp::FdmBlackScholesSensitivityOp(
+        const boost::shared_ptr<FdmMesher>& mesher,
+        Parameter parameter,
+        const boost::shared_ptr<BlackVolTermStructure>& volTS,
+        Real strike,
+        Size direction)
+    : mesher_(mesher),
+      parameter_(parameter),
+      volTS_(volTS),
+      strike_(strike),
+      direction_(direction),
+      dxMap_ (FirstDerivativeOp(direction, mesher)),
+      dxxMap_(SecondDerivativeOp(direction, mesher)),
+      mapT_  (direction, mesher),
+      dv_(Null<Real>()) {
+
+        if (parameter_ == Volatility) {
+            QL_REQUIRE(volTS_, "volatility term structure needed");
+            QL_REQUIRE(strike_ != Null<Real>(), "strike needed");
+        }
+        else {
+            // d/dr of (r-q-v/2) d/dx - r
+            mapT_.axpyb(Array(), dxMap_, dxMap_, Array(1, -1.0));
+        }
+    }
+
+    void FdmBlackScholesSensitivityOp::setTime(Time t1, Time t2) {
+        if (parameter_ == Volatility) {
+            // the forward variance (s(t2)^2 t2 - s(t1)^2 t1)/(t2-t1)
+            // enters the operator as v/2 (d^2/dx^2 - d/dx)
+            const Real s1t1 =
+                (t1 > 0.0) ? volTS_->blackVol(t1, strike_, true)*t1 : 0.0;
+            const Real s2t2 = volTS_->blackVol(t2, strike_, true)*t2;
+            const Real dv = (s2t2 - s1t1)/(t2 - t1);
+
+            if (dv != dv_) {
+                mapT_.axpyb(Array(1, -dv), dxMap_,
+                        dxxMap_.mult(Array(mesher_->layout()->size(), dv)),
+                        Array());
+                dv_ = dv;
+            }
+        }
+    }
+
+    Size FdmBlackScholesSensitivityOp::size() const {
+        return mesher_->layout()->dim().size();
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::apply(
+                                                    const Array& r) const {
+        return mapT_.apply(r);
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::apply_direction(
+                                    Size direction, const Array& r) const {
+        if (direction == direction_)
+            return mapT_.apply(r);
+        else {
+            Array retVal(r.size(), 0.0);
+            return retVal;
+        }
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::apply_mixed(
+                                                    const Array& r) const {
+        Array retVal(r.size(), 0.0);
+        return retVal;
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::solve_splitting(
+                             Size direction, const Array& r, Real s) const {
+        if (direction == direction_)
+            return mapT_.solve_splitting(r, s, 1.0);
+        else {
+            Array retVal(r);
+            return retVal;
+        }
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::preconditioner(
+                                            const Array& r, Real s) const {
+        return solve_splitting(direction_, r, s);
+    }
+
+    void FdmBlackScholesSensitivityOp::apply(const Array& r,
+                                             Array& out) const {
+        mapT_.apply(r, out);
+    }
+
+    void FdmBlackScholesSensitivityOp::apply_direction(Size direction,
+                                                       const Array& r,
+                                                       Array& out) const {
+        if (direction == direction_)
+            mapT_.apply(r, out);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmBlackScholesSensitivityOp::apply_mixed(const Array& r,
+                                                   Array& out) const {
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    Disposable<std::vector<SparseMatrix> >
+    FdmBlackScholesSensitivityOp::toMatrixDecomp() const {
+        std::vector<SparseMatrix> retVal(1, mapT_.toMatrix());
+        return retVal;
+    }
+#endif
+}
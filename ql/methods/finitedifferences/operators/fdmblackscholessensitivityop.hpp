@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmblackscholessensitivityop.hpp
+    \brief derivatives of the Black-Scholes operator
+*/
+
+#ifndef quantlib_fdm_black_scholes_sensitivity_op_hpp
+#define quantlib_fdm_black_scholes_sensitivity_op_hpp
+
+#include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+
+namespace QuantLib {
+
+    class BlackVolTermStructure;
+
+    //! derivatives of the Black-Scholes operator
+    /*! Derivative of the operator of FdmBlackScholesOp in the log of
+        the underlying with respect to a parallel shift of either
+        the Black volatility or the continuous risk-free zero rate,
+        to be used with FdmSensitivityOp.
+
+        The rate derivative does not depend on the model; it is also
+        the derivative of the equity part of the Heston operator, in
+        which case no volatility term structure is needed.
+
+        \warning local volatility is not supported.
+    */
+    class FdmBlackScholesSensitivityOp : public FdmLinearOpComposite {
+      public:
+        enum Parameter { Volatility, RiskFreeRate };
+
+        FdmBlackScholesSensitivityOp(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            Parameter parameter,
+            const boost::shared_ptr<BlackVolTermStructure>& volTS
+                                = boost::shared_ptr<BlackVolTermStructure>(),
+            Real strike = Null<Real>(),
+            Size direction = 0);
+
+        Size size() const;
+        void setTime(Time t1, Time t2);
+
+        Disposable<Array> apply(const Array& r) const;
+        Disposable<Array> apply_mixed(const Array& r) const;
+        Disposable<Array> apply_direction(Size direction,
+                                          const Array& r) const;
+        Disposable<Array> solve_splitting(Size direction,
+                                          const Array& r, Real s) const;
+        Disposable<Array> preconditioner(const Array& r, Real s) const;
+
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
+#endif
+      private:
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const Parameter parameter_;
+        const boost::shared_ptr<BlackVolTermStructure> volTS_;
+        const Real strike_;
+        const Size direction_;
+        const FirstDerivativeOp dxMap_;
+        const TripleBandLinearOp dxxMap_;
+        TripleBandLinearOp mapT_;
+        Real dv_;
+    };
+}
+
+#endif
@@ -27,6 +27,7 @@
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <algorithm>
 
 
 namespace QuantLib {
@@ -52,6 +53,7 @@ namespace QuantLib {
                           model->rho()*model->sigma()*model->eta()))),
       mapX_(direction1, mesher),
       mapY_(direction2, mesher),
+      shift_(mesher->layout()->size()),
       model_(model) {
     }
 
@@ -67,9 +69,10 @@ namespace QuantLib {
         const Real phi = 0.5*(  dynamics->shortRate(t1, 0.0, 0.0)
                               + dynamics->shortRate(t2, 0.0, 0.0));
 
-        const Array hr = -0.5*(x_ + y_ + phi);
-        mapX_.axpyb(Array(), dxMap_, dxMap_, hr);
-        mapY_.axpyb(Array(), dyMap_, dyMap_, hr);
+        for (Size i=0; i < shift_.size(); ++i)
+            shift_[i] = -0.5*(x_[i] + y_[i] + phi);
+        mapX_.axpyb(Array(), dxMap_, dxMap_, shift_);
+        mapY_.axpyb(Array(), dyMap_, dyMap_, shift_);
     }
 
     Disposable<Array> FdmG2Op::apply(const Array& r) const {
@@ -113,6 +116,48 @@ namespace QuantLib {
         return solve_splitting(direction1_, r, dt);
     }
 
+    void FdmG2Op::apply(const Array& r, Array& out) const {
+        mapX_.apply(r, out);
+        mapY_.apply(r, work_);
+        out += work_;
+        corrMap_.apply(r, work_);
+        out += work_;
+    }
+
+    void FdmG2Op::apply_mixed(const Array& r, Array& out) const {
+        corrMap_.apply(r, out);
+    }
+
+    void FdmG2Op::apply_direction(Size direction,
+                                  const Array& r, Array& out) const {
+        if (direction == direction1_) {
+            mapX_.apply(r, out);
+        }
+        else if (direction == direction2_) {
+            mapY_.apply(r, out);
+        }
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmG2Op::solve_splitting(Size direction, const Array& r,
+                                  Real a, Array& out) const {
+        if (direction == direction1_) {
+            mapX_.solve_splitting(r, a, 1.0, out);
+        }
+        else if (direction == direction2_) {
+            mapY_.solve_splitting(r, a, 1.0, out);
+        }
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> > FdmG2Op::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(3);
@@ -51,6 +51,13 @@ namespace QuantLib {
             solve_splitting(Size direction, const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction,
+                             const Array& r, Real s, Array& out) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -61,6 +68,8 @@ namespace QuantLib {
 
         NinePointLinearOp corrMap_;
         TripleBandLinearOp mapX_, mapY_;
+        Array shift_;
+        mutable Array work_;
 
         const boost::shared_ptr<G2> model_;
     };
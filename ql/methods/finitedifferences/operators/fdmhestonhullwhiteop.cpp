@@ -35,6 +35,7 @@ namespace QuantLib {
         const boost::shared_ptr<YieldTermStructure>& qTS)
     : x_(mesher->locations(2)),
       varianceValues_(0.5*mesher->locations(1)),
+      drift_(mesher->layout()->size()),
       dxMap_ (FirstDerivativeOp(0, mesher)),
       dxxMap_(SecondDerivativeOp(0, mesher).mult(0.5*mesher->locations(1))),
       mapT_   (0, mesher),
@@ -66,7 +67,9 @@ namespace QuantLib {
 
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
-        mapT_.axpyb(x_+phi-varianceValues_-q, dxMap_, dxxMap_, Array());
+        for (Size i=0; i < drift_.size(); ++i)
+            drift_[i] = x_[i] + phi - varianceValues_[i] - q;
+        mapT_.axpyb(drift_, dxMap_, dxxMap_, Array());
     }
 
     const TripleBandLinearOp& FdmHestonHullWhiteEquityPart::getMap() const {
@@ -156,6 +159,51 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonHullWhiteOp::apply(const Array& u, Array& out) const {
+        dyMap_.apply(u, out);
+        dxMap_.getMap().apply(u, work_);
+        out += work_;
+        hullWhiteOp_.apply(u, work_);
+        out += work_;
+        hestonCorrMap_.apply(u, work_);
+        out += work_;
+        equityIrCorrMap_.apply(u, work_);
+        out += work_;
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction(Size direction,
+                                               const Array& r,
+                                               Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, out);
+        else if (direction == 1)
+            dyMap_.apply(r, out);
+        else if (direction == 2)
+            hullWhiteOp_.apply(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixed(const Array& r,
+                                           Array& out) const {
+        hestonCorrMap_.apply(r, out);
+        equityIrCorrMap_.apply(r, work_);
+        out += work_;
+    }
+
+    void FdmHestonHullWhiteOp::solve_splitting(Size direction,
+                                               const Array& r, Real a,
+                                               Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, out);
+        else if (direction == 1)
+            dyMap_.solve_splitting(r, a, 1.0, out);
+        else if (direction == 2)
+            hullWhiteOp_.solve_splitting(2, r, a, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonHullWhiteOp::toMatrixDecomp() const {
@@ -26,6 +26,7 @@
 #include <ql/methods/finitedifferences/operators/fdmhullwhiteop.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -40,6 +41,7 @@ namespace QuantLib {
                     .mult(0.5*model->sigma()*model->sigma()
                           *Array(mesher->layout()->size(), 1.0)))),
       mapT_(direction, mesher),
+      shift_(x_.size()),
       model_(model) {
     }
 
@@ -55,7 +57,9 @@ namespace QuantLib {
         const Real phi = 0.5*(  dynamics->shortRate(t1, 0.0)
                               + dynamics->shortRate(t2, 0.0));
 
-        mapT_.axpyb(Array(), dzMap_, dzMap_, -(x_+phi));
+        for (Size i=0; i < shift_.size(); ++i)
+            shift_[i] = -(x_[i] + phi);
+        mapT_.axpyb(Array(), dzMap_, dzMap_, shift_);
     }
 
     Disposable<Array> FdmHullWhiteOp::apply(const Array& r) const {
@@ -94,6 +98,38 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply(const Array& r, Array& out) const {
+        mapT_.apply(r, out);
+    }
+
+    void FdmHullWhiteOp::apply_mixed(const Array& r, Array& out) const {
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction(Size direction,
+                                         const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.apply(r, out);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmHullWhiteOp::solve_splitting(Size direction, const Array& r,
+                                         Real a, Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, a, 1.0, out);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHullWhiteOp::toMatrixDecomp() const {
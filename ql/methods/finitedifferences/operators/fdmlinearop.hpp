@@ -36,6 +36,14 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() { }
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
+        //! applies the operator to r and stores the result in out
+        /*! out is resized if needed; it must not be the same array
+            as r.  Derived classes can override this method so that
+            no memory is allocated when out has the correct size.
+        */
+        virtual void apply(const array_type& r, array_type& out) const {
+            out = apply(r);
+        }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
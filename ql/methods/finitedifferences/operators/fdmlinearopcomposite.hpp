@@ -51,6 +51,27 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name in-place variants
+            The result is stored in out, which is resized if needed and
+            must not be the same array as r.  The default implementations
+            forward to the methods above; derived classes can override
+            them so that no memory is allocated when out has the
+            correct size.
+        */
+        //@{
+        virtual void apply_mixed(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_direction(Size direction,
+                                     const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splitting(Size direction, const Array& r,
+                                     Real s, Array& out) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const=0;
 
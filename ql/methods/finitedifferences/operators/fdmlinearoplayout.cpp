@@ -19,10 +19,27 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/errors.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        // reflects coordinates beyond the boundaries as done by
+        // FdmLinearOpLayout::neighbourhood
+        Integer reflect(Integer coordinate, Size n) {
+            if (coordinate < 0)
+                return -coordinate;
+            else if (Size(coordinate) >= n)
+                return 2*(n-1) - coordinate;
+            else
+                return coordinate;
+        }
+
+    }
+
     Size FdmLinearOpLayout::neighbourhood(const FdmLinearOpIterator& iterator,
                                           Size i, Integer offset) const {
         Size myIndex = iterator.index()
@@ -85,4 +102,95 @@ namespace QuantLib {
 
         return retVal;
     }
+
+    boost::shared_array<Size> FdmLinearOpLayout::neighbourhoodTable(
+                                            Size i, Integer offset) const {
+        QL_REQUIRE(i < dim_.size(), "direction " << i << " out of range");
+
+        std::vector<Integer> key(2);
+        key[0] = Integer(i); key[1] = offset;
+
+        boost::shared_array<Size> table;
+        #if defined(_OPENMP)
+        #pragma omp critical(ql_fdm_linear_op_layout_tables)
+        #endif
+        {
+            table = tables_[key];
+            if (!table) {
+                table = boost::shared_array<Size>(new Size[size_]);
+                const Size s = spacing_[i], n = dim_[i];
+                for (Size k=0; k < size_; ++k) {
+                    const Size c = (k/s)%n;
+                    table[k] = k - c*s + reflect(Integer(c)+offset, n)*s;
+                }
+                tables_[key] = table;
+            }
+        }
+        return table;
+    }
+
+    boost::shared_array<Size> FdmLinearOpLayout::neighbourhoodTable(
+                                            Size i1, Integer offset1,
+                                            Size i2, Integer offset2) const {
+        QL_REQUIRE(i1 < dim_.size() && i2 < dim_.size(),
+                   "directions " << i1 << ", " << i2 << " out of range");
+
+        std::vector<Integer> key(4);
+        key[0] = Integer(i1); key[1] = offset1;
+        key[2] = Integer(i2); key[3] = offset2;
+
+        boost::shared_array<Size> table;
+        #if defined(_OPENMP)
+        #pragma omp critical(ql_fdm_linear_op_layout_tables)
+        #endif
+        {
+            table = tables_[key];
+            if (!table) {
+                table = boost::shared_array<Size>(new Size[size_]);
+                const Size s1 = spacing_[i1], n1 = dim_[i1];
+                const Size s2 = spacing_[i2], n2 = dim_[i2];
+                for (Size k=0; k < size_; ++k) {
+                    const Size c1 = (k/s1)%n1, c2 = (k/s2)%n2;
+                    table[k] = k - c1*s1 - c2*s2
+                        + reflect(Integer(c1)+offset1, n1)*s1
+                        + reflect(Integer(c2)+offset2, n2)*s2;
+                }
+                tables_[key] = table;
+            }
+        }
+        return table;
+    }
+
+    boost::shared_array<Size> FdmLinearOpLayout::lineTable(Size i) const {
+        QL_REQUIRE(i < dim_.size(), "direction " << i << " out of range");
+
+        const std::vector<Integer> key(1, Integer(i));
+
+        boost::shared_array<Size> table;
+        #if defined(_OPENMP)
+        #pragma omp critical(ql_fdm_linear_op_layout_tables)
+        #endif
+        {
+            table = tables_[key];
+            if (!table) {
+                table = boost::shared_array<Size>(new Size[size_]);
+
+                // spacing of a layout in which direction i comes first
+                std::vector<Size> newDim(dim_);
+                std::iter_swap(newDim.begin(), newDim.begin()+i);
+                std::vector<Size> newSpacing =
+                    FdmLinearOpLayout(newDim).spacing();
+                std::iter_swap(newSpacing.begin(), newSpacing.begin()+i);
+
+                for (Size k=0; k < size_; ++k) {
+                    Size newIndex = 0;
+                    for (Size j=0; j < dim_.size(); ++j)
+                        newIndex += ((k/spacing_[j])%dim_[j])*newSpacing[j];
+                    table[newIndex] = k;
+                }
+                tables_[key] = table;
+            }
+        }
+        return table;
+    }
 }
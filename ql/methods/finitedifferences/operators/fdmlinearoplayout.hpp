@@ -27,7 +27,9 @@
 #define quantlib_linear_op_layout_hpp
 
 #include <ql/methods/finitedifferences/operators/fdmlinearopiterator.hpp>
+#include <boost/shared_array.hpp>
 #include <functional>
+#include <map>
 
 namespace QuantLib {
 
@@ -79,9 +81,34 @@ namespace QuantLib {
         Disposable<FdmLinearOpIterator> iter_neighbourhood(
             const FdmLinearOpIterator& iterator, Size i, Integer offset) const;
 
+        /*! \name index tables
+            The tables below are computed on first use and cached, so
+            that all the operators built on the same layout (and
+            their copies) share them.
+        */
+        //@{
+        //! index of the neighbour of each grid point along direction i
+        boost::shared_array<Size> neighbourhoodTable(Size i,
+                                                     Integer offset) const;
+        //! index of the neighbour of each grid point along i1 and i2
+        boost::shared_array<Size> neighbourhoodTable(Size i1, Integer offset1,
+                                                     Size i2,
+                                                     Integer offset2) const;
+        //! grid points sorted line by line along direction i
+        /*! The k-th line along direction i is stored in the elements
+            \f$ [k n_i, (k+1) n_i) \f$ of the table, where \f$ n_i \f$
+            is the number of points along the direction.
+        */
+        boost::shared_array<Size> lineTable(Size i) const;
+        //@}
+
       private:
         Size size_;
         std::vector<Size> dim_, spacing_;
+
+        typedef std::map<std::vector<Integer>,
+                         boost::shared_array<Size> > table_map;
+        mutable table_map tables_;
     };
 }
 
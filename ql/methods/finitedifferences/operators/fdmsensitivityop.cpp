@@ -0,0 +1,214 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/operators/fdmsensitivityop.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        void addBlock(const SparseMatrix& m, Size row, Size column,
+                      SparseMatrix& to) {
+            for (SparseMatrix::const_iterator1 i1 = m.begin1();
+                 i1 != m.end1(); ++i1) {
+                for (SparseMatrix::const_iterator2 i2 = i1.begin();
+                     i2 != i1.end(); ++i2) {
+                    to(row + i2.index1(), column + i2.index2()) += *i2;
+                }
+            }
+        }
+#endif
+
+    }
+
+    FdmSensitivityOp::FdmSensitivityOp(
+        const boost::shared_ptr<FdmLinearOpComposite>& op,
+        const std::vector<boost::shared_ptr<FdmLinearOpComposite> >&
+                                                             derivativeOps,
+        Size layoutSize)
+    : op_(op), derivativeOps_(derivativeOps), n_(layoutSize),
+      v_(layoutSize), u_(layoutSize), w_(layoutSize), x_(layoutSize) {
+        QL_REQUIRE(!derivativeOps_.empty(), "no derivative operators given");
+    }
+
+    Size FdmSensitivityOp::size() const {
+        return op_->size();
+    }
+
+    void FdmSensitivityOp::setTime(Time t1, Time t2) {
+        op_->setTime(t1, t2);
+        for (Size k=0; k < derivativeOps_.size(); ++k)
+            derivativeOps_[k]->setTime(t1, t2);
+    }
+
+    void FdmSensitivityOp::copyBlock(const Array& from, Size i,
+                                     Array& to) const {
+        std::copy(from.begin() + i*n_, from.begin() + (i+1)*n_, to.begin());
+    }
+
+    void FdmSensitivityOp::setBlock(const Array& from, Array& to,
+                                    Size i) const {
+        std::copy(from.begin(), from.end(), to.begin() + i*n_);
+    }
+
+    void FdmSensitivityOp::apply(const Array& r, Array& out) const {
+        QL_REQUIRE(r.size() == n_*(derivativeOps_.size()+1),
+                   "array size (" << r.size() << ") does not match");
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+
+        copyBlock(r, 0, v_);
+        op_->apply(v_, w_);
+        setBlock(w_, out, 0);
+
+        for (Size k=0; k < derivativeOps_.size(); ++k) {
+            copyBlock(r, k+1, u_);
+            op_->apply(u_, w_);
+            derivativeOps_[k]->apply(v_, x_);
+            for (Size i=0; i < n_; ++i)
+                w_[i] += x_[i];
+            setBlock(w_, out, k+1);
+        }
+    }
+
+    void FdmSensitivityOp::apply_mixed(const Array& r, Array& out) const {
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+
+        copyBlock(r, 0, v_);
+        op_->apply_mixed(v_, w_);
+        setBlock(w_, out, 0);
+
+        for (Size k=0; k < derivativeOps_.size(); ++k) {
+            copyBlock(r, k+1, u_);
+            op_->apply_mixed(u_, w_);
+            derivativeOps_[k]->apply_mixed(v_, x_);
+            for (Size i=0; i < n_; ++i)
+                w_[i] += x_[i];
+            setBlock(w_, out, k+1);
+        }
+    }
+
+    void FdmSensitivityOp::apply_direction(Size direction,
+                                           const Array& r,
+                                           Array& out) const {
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+
+        copyBlock(r, 0, v_);
+        op_->apply_direction(direction, v_, w_);
+        setBlock(w_, out, 0);
+
+        for (Size k=0; k < derivativeOps_.size(); ++k) {
+            copyBlock(r, k+1, u_);
+            op_->apply_direction(direction, u_, w_);
+            derivativeOps_[k]->apply_direction(direction, v_, x_);
+            for (Size i=0; i < n_; ++i)
+                w_[i] += x_[i];
+            setBlock(w_, out, k+1);
+        }
+    }
+
+    void FdmSensitivityOp::solve_splitting(Size direction,
+                                           const Array& r, Real s,
+                                           Array& out) const {
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+
+        // (1 + s L) v = r_0 first, then (1 + s L) u_k = r_k - s D_k v
+        copyBlock(r, 0, w_);
+        op_->solve_splitting(direction, w_, s, v_);
+        setBlock(v_, out, 0);
+
+        for (Size k=0; k < derivativeOps_.size(); ++k) {
+            derivativeOps_[k]->apply_direction(direction, v_, x_);
+            copyBlock(r, k+1, w_);
+            for (Size i=0; i < n_; ++i)
+                w_[i] -= s*x_[i];
+            op_->solve_splitting(direction, w_, s, u_);
+            setBlock(u_, out, k+1);
+        }
+    }
+
+    Disposable<Array> FdmSensitivityOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        apply(r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmSensitivityOp::apply_mixed(const Array& r) const {
+        Array retVal(r.size());
+        apply_mixed(r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmSensitivityOp::apply_direction(Size direction,
+                                                    const Array& r) const {
+        Array retVal(r.size());
+        apply_direction(direction, r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmSensitivityOp::solve_splitting(Size direction,
+                                                const Array& r, Real s) const {
+        Array retVal(r.size());
+        solve_splitting(direction, r, s, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmSensitivityOp::preconditioner(const Array& r,
+                                                       Real s) const {
+        Array retVal(r.size());
+
+        copyBlock(r, 0, w_);
+        v_ = op_->preconditioner(w_, s);
+        setBlock(v_, retVal, 0);
+
+        for (Size k=0; k < derivativeOps_.size(); ++k) {
+            derivativeOps_[k]->apply(v_, x_);
+            copyBlock(r, k+1, w_);
+            for (Size i=0; i < n_; ++i)
+                w_[i] -= s*x_[i];
+            setBlock(op_->preconditioner(w_, s), retVal, k+1);
+        }
+
+        return retVal;
+    }
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    Disposable<std::vector<SparseMatrix> >
+    FdmSensitivityOp::toMatrixDecomp() const {
+        const std::vector<SparseMatrix> decomp = op_->toMatrixDecomp();
+        const Size blocks = derivativeOps_.size()+1;
+
+        std::vector<SparseMatrix> retVal(
+            decomp.size(), SparseMatrix(blocks*n_, blocks*n_));
+        for (Size i=0; i < decomp.size(); ++i) {
+            for (Size j=0; j < blocks; ++j)
+                addBlock(decomp[i], j*n_, j*n_, retVal[i]);
+        }
+        for (Size k=0; k < derivativeOps_.size(); ++k)
+            addBlock(derivativeOps_[k]->toMatrix(), (k+1)*n_, 0, retVal[0]);
+
+        return retVal;
+    }
+#endif
+}
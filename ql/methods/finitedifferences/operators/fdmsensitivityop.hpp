@@ -0,0 +1,107 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmsensitivityop.hpp
+    \brief operator for values and their parameter sensitivities
+*/
+
+#ifndef quantlib_fdm_sensitivity_op_hpp
+#define quantlib_fdm_sensitivity_op_hpp
+
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! operator for values and their parameter sensitivities
+    /*! Given the operator \f$ L(p) \f$ of a pricing PDE and its
+        derivatives \f$ D_k = \partial L / \partial p_k \f$ with
+        respect to a few model parameters, the sensitivities
+        \f$ u_k = \partial V / \partial p_k \f$ of the solution
+        satisfy
+        \f[
+            \frac{\partial u_k}{\partial t} + L u_k + D_k V = 0
+        \f]
+        on the same mesh.  This operator acts on arrays in which the
+        values \f$ V \f$ are followed by the sensitivities
+        \f$ u_1, \dots, u_n \f$, each with the size of the layout, as
+        the block lower-triangular matrix
+        \f[
+            \left( \begin{array}{cccc}
+                L   & 0 & \cdots & 0 \\
+                D_1 & L &        &   \\
+                \vdots & & \ddots &  \\
+                D_n & 0 & \cdots & L
+            \end{array} \right);
+        \f]
+        the splitting solves are thus carried out block by block with
+        the solver of \f$ L \f$, so that any of the ADI schemes can
+        roll back values and sensitivities together.
+
+        The derivative operators must be split into directions as the
+        value operator is.  The in-place methods use work arrays
+        held by the instance, which therefore must not be shared
+        between threads.
+    */
+    class FdmSensitivityOp : public FdmLinearOpComposite {
+      public:
+        FdmSensitivityOp(
+            const boost::shared_ptr<FdmLinearOpComposite>& op,
+            const std::vector<boost::shared_ptr<FdmLinearOpComposite> >&
+                                                             derivativeOps,
+            Size layoutSize);
+
+        Size size() const;
+        void setTime(Time t1, Time t2);
+
+        Disposable<Array> apply(const Array& r) const;
+        Disposable<Array> apply_mixed(const Array& r) const;
+        Disposable<Array> apply_direction(Size direction,
+                                          const Array& r) const;
+        Disposable<Array> solve_splitting(Size direction,
+                                          const Array& r, Real s) const;
+        Disposable<Array> preconditioner(const Array& r, Real s) const;
+
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction,
+                             const Array& r, Real s, Array& out) const;
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        /*! the derivative operators are added to the first component
+            of the decomposition.
+        */
+        Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
+#endif
+
+      private:
+        void copyBlock(const Array& from, Size i, Array& to) const;
+        void setBlock(const Array& from, Array& to, Size i) const;
+
+        const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const std::vector<boost::shared_ptr<FdmLinearOpComposite> >
+                                                              derivativeOps_;
+        const Size n_;
+        mutable Array v_, u_, w_, x_;
+    };
+}
+
+#endif
@@ -29,14 +29,6 @@ namespace QuantLib {
         Size d0, Size d1,
         const boost::shared_ptr<FdmMesher>& mesher)
     : d0_(d0), d1_(d1),
-      i00_(new Size[mesher->layout()->size()]),
-      i10_(new Size[mesher->layout()->size()]),
-      i20_(new Size[mesher->layout()->size()]),
-      i01_(new Size[mesher->layout()->size()]),
-      i21_(new Size[mesher->layout()->size()]),
-      i02_(new Size[mesher->layout()->size()]),
-      i12_(new Size[mesher->layout()->size()]),
-      i22_(new Size[mesher->layout()->size()]),
       a00_(new Real[mesher->layout()->size()]),
       a10_(new Real[mesher->layout()->size()]),
       a20_(new Real[mesher->layout()->size()]),
@@ -54,31 +46,22 @@ namespace QuantLib {
             "inconsistent derivative directions");
 
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i10_[i] = layout->neighbourhood(iter, d1_, -1);
-            i01_[i] = layout->neighbourhood(iter, d0_, -1);
-            i21_[i] = layout->neighbourhood(iter, d0_,  1);
-            i12_[i] = layout->neighbourhood(iter, d1_,  1);
-            i00_[i] = layout->neighbourhood(iter, d0_, -1, d1_, -1);
-            i20_[i] = layout->neighbourhood(iter, d0_,  1, d1_, -1);
-            i02_[i] = layout->neighbourhood(iter, d0_, -1, d1_,  1);
-            i22_[i] = layout->neighbourhood(iter, d0_,  1, d1_,  1);
-        }
+
+        i10_ = layout->neighbourhoodTable(d1_, -1);
+        i01_ = layout->neighbourhoodTable(d0_, -1);
+        i21_ = layout->neighbourhoodTable(d0_,  1);
+        i12_ = layout->neighbourhoodTable(d1_,  1);
+        i00_ = layout->neighbourhoodTable(d0_, -1, d1_, -1);
+        i20_ = layout->neighbourhoodTable(d0_,  1, d1_, -1);
+        i02_ = layout->neighbourhoodTable(d0_, -1, d1_,  1);
+        i22_ = layout->neighbourhoodTable(d0_,  1, d1_,  1);
     }
 
     NinePointLinearOp::NinePointLinearOp(const NinePointLinearOp& m)
-    : i00_(new Size[m.mesher_->layout()->size()]),
-      i10_(new Size[m.mesher_->layout()->size()]),
-      i20_(new Size[m.mesher_->layout()->size()]),
-      i01_(new Size[m.mesher_->layout()->size()]),
-      i21_(new Size[m.mesher_->layout()->size()]),
-      i02_(new Size[m.mesher_->layout()->size()]),
-      i12_(new Size[m.mesher_->layout()->size()]),
-      i22_(new Size[m.mesher_->layout()->size()]),
+    : d0_(m.d0_), d1_(m.d1_),
+      i00_(m.i00_), i10_(m.i10_), i20_(m.i20_),
+      i01_(m.i01_), i21_(m.i21_),
+      i02_(m.i02_), i12_(m.i12_), i22_(m.i22_),
       a00_(new Real[m.mesher_->layout()->size()]),
       a10_(new Real[m.mesher_->layout()->size()]),
       a20_(new Real[m.mesher_->layout()->size()]),
@@ -91,14 +74,6 @@ namespace QuantLib {
       mesher_(m.mesher_) {
 
         const Size size = mesher_->layout()->size();
-        std::copy(m.i00_.get(), m.i00_.get()+size, i00_.get());
-        std::copy(m.i10_.get(), m.i10_.get()+size, i10_.get());
-        std::copy(m.i20_.get(), m.i20_.get()+size, i20_.get());
-        std::copy(m.i01_.get(), m.i01_.get()+size, i01_.get());
-        std::copy(m.i21_.get(), m.i21_.get()+size, i21_.get());
-        std::copy(m.i02_.get(), m.i02_.get()+size, i02_.get());
-        std::copy(m.i12_.get(), m.i12_.get()+size, i12_.get());
-        std::copy(m.i22_.get(), m.i22_.get()+size, i22_.get());
         std::copy(m.a00_.get(), m.a00_.get()+size, a00_.get());
         std::copy(m.a10_.get(), m.a10_.get()+size, a10_.get());
         std::copy(m.a20_.get(), m.a20_.get()+size, a20_.get());
@@ -130,12 +105,20 @@ namespace QuantLib {
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        apply(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply(const Array& u, Array& retVal) const {
 
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(&u != &retVal, "input and output arrays must differ");
 
-        Array retVal(u.size());
+        if (retVal.size() != u.size())
+            Array(u.size()).swap(retVal);
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -155,7 +138,6 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
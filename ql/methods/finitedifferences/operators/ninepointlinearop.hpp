@@ -44,6 +44,7 @@ namespace QuantLib {
         NinePointLinearOp& operator=(const Disposable<NinePointLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        void apply(const Array& r, Array& out) const;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
@@ -56,6 +57,7 @@ namespace QuantLib {
         NinePointLinearOp() {}
 
         Size d0_, d1_;
+        // index tables, shared with the layout and never modified
         boost::shared_array<Size> i00_, i10_, i20_;
         boost::shared_array<Size> i01_, i21_;
         boost::shared_array<Size> i02_, i12_, i22_;
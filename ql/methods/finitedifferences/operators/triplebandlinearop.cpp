@@ -26,54 +26,38 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // below this number of grid points the overhead of
+        // spawning threads exceeds the gain
+        const long minimumParallelSize = 4096;
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
     : direction_(direction),
-      i0_       (new Size[mesher->layout()->size()]),
-      i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
+      i0_       (mesher->layout()->neighbourhoodTable(direction, -1)),
+      i2_       (mesher->layout()->neighbourhoodTable(direction,  1)),
+      reverseIndex_ (mesher->layout()->lineTable(direction)),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
-      mesher_(mesher) {
-
-        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        std::vector<Size> newDim(layout->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i0_[i] = layout->neighbourhood(iter, direction, -1);
-            i2_[i] = layout->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
-        }
-    }
+      mesher_(mesher),
+      factorized_(false) {}
 
     TripleBandLinearOp::TripleBandLinearOp(const TripleBandLinearOp& m)
     : direction_(m.direction_),
-      i0_   (new Size[m.mesher_->layout()->size()]),
-      i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
+      i0_   (m.i0_),
+      i2_   (m.i2_),
+      reverseIndex_(m.reverseIndex_),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
-      mesher_(m.mesher_) {
+      mesher_(m.mesher_),
+      factorized_(false) {
         const Size len = m.mesher_->layout()->size();
-        std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
-        std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -81,7 +65,8 @@ namespace QuantLib {
 
 
     TripleBandLinearOp::TripleBandLinearOp(
-        const Disposable<TripleBandLinearOp>& from) {
+        const Disposable<TripleBandLinearOp>& from)
+    : factorized_(false) {
         swap(const_cast<Disposable<TripleBandLinearOp>&>(from));
     }
 
@@ -105,6 +90,9 @@ namespace QuantLib {
         i0_.swap(m.i0_); i2_.swap(m.i2_);
         reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
+        factorT_.swap(m.factorT_); factorInvBet_.swap(m.factorInvBet_);
+        std::swap(factorA_, m.factorA_); std::swap(factorB_, m.factorB_);
+        std::swap(factorized_, m.factorized_);
     }
 
     void TripleBandLinearOp::axpyb(const Array& a,
@@ -112,6 +100,7 @@ namespace QuantLib {
                                    const TripleBandLinearOp& y,
                                    const Array& b) {
         const Size size = mesher_->layout()->size();
+        factorized_ = false;
 
         Real *diag(diag_.get());
         Real *lower(lower_.get());
@@ -220,9 +209,16 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        array_type retVal(r.size());
+        apply(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply(const Array& r, Array& out) const {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(&r != &out, "input and output arrays must differ");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -230,12 +226,18 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
-        }
+        const long size = static_cast<long>(index->size());
 
-        return retVal;
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(static) \
+            if(size >= minimumParallelSize)
+        #endif
+        for (long i=0; i < size; ++i) {
+            out[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        }
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -257,50 +259,129 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size());
+        solve_splitting(r, a, b, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::factorize(Real a, Real b) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
-        QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
-        for (FdmLinearOpIterator iter = layout->begin();
-             iter!=layout->end(); ++iter) {
-            const std::vector<Size>& coordinates = iter.coordinates();
-            QL_REQUIRE(   coordinates[direction_] != 0
-                       || lower_[iter.index()] == 0,"removing non zero entry!");
-            QL_REQUIRE(   coordinates[direction_] != layout->dim()[direction_]-1
-                       || upper_[iter.index()] == 0,"removing non zero entry!");
+        {
+            const Size n = layout->dim()[direction_];
+            for (Size k=0; k < layout->size(); k+=n) {
+                QL_REQUIRE(lower_[reverseIndex_[k]] == 0,
+                           "removing non zero entry!");
+                QL_REQUIRE(upper_[reverseIndex_[k+n-1]] == 0,
+                           "removing non zero entry!");
+            }
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        factorized_ = false;
+        if (factorT_.size() != layout->size()) {
+            Array(layout->size()).swap(factorT_);
+            Array(layout->size()).swap(factorInvBet_);
+        }
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        // The grid decomposes into independent lines along direction_,
+        // which are contiguous in reverseIndex_. Each one is a separate
+        // tridiagonal system, since the entries coupling it to its
+        // neighbours are zero (see the checks above). The coefficients
+        // of the Thomson algorithm are stored in the same order.
+        const Size n = layout->dim()[direction_];
+        const long size = static_cast<long>(layout->size());
+        const long nLines = size/static_cast<long>(n);
+        long failures = 0;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(static) reduction(+:failures) \
+            if(nLines > 1 && size >= minimumParallelSize)
+        #endif
+        for (long k=0; k < nLines; ++k) {
+            const Size offset = static_cast<Size>(k)*n;
+            const Size* ri = rptr + offset;
+            Real* t = factorT_.begin() + offset;
+            Real* invBet = factorInvBet_.begin() + offset;
+
+            Size rim1 = ri[0];
+            Real bet = a*dptr[rim1]+b;
+            if (bet == 0.0) {
+                ++failures;
+                continue;
+            }
+            invBet[0] = 1.0/bet;
+
+            for (Size j=1; j < n; ++j) {
+                const Size rj = ri[j];
+                t[j] = a*uptr[rim1]*invBet[j-1];
+
+                bet = b+a*(dptr[rj]-t[j]*lptr[rj]);
+                if (bet == 0.0) {
+                    ++failures;
+                    break;
+                }
+                invBet[j] = 1.0/bet;
+                rim1 = rj;
+            }
+        }
+        QL_ENSURE(failures == 0, "division by zero");
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        factorA_ = a;
+        factorB_ = b;
+        factorized_ = true;
+    }
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+    void TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b,
+                                             Array& retVal) const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(&r != &retVal, "input and output arrays must differ");
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+        if (!factorized_ || a != factorA_ || b != factorB_)
+            factorize(a, b);
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
-        }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        if (retVal.size() != r.size())
+            Array(r.size()).swap(retVal);
 
-        return retVal;
+        const Real* lptr = lower_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        // forward and back substitution, line by line; the results
+        // do not depend on how the lines are shared among threads.
+        const Size n = layout->dim()[direction_];
+        const long size = static_cast<long>(layout->size());
+        const long nLines = size/static_cast<long>(n);
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(static) \
+            if(nLines > 1 && size >= minimumParallelSize)
+        #endif
+        for (long k=0; k < nLines; ++k) {
+            const Size offset = static_cast<Size>(k)*n;
+            const Size* ri = rptr + offset;
+            const Real* t = factorT_.begin() + offset;
+            const Real* invBet = factorInvBet_.begin() + offset;
+
+            Size rim1 = ri[0];
+            retVal[rim1] = r[rim1]*invBet[0];
+
+            Size j;
+            for (j=1; j < n; ++j) {
+                const Size rj = ri[j];
+                retVal[rj] = (r[rj]-a*lptr[rj]*retVal[rim1])*invBet[j];
+                rim1 = rj;
+            }
+
+            // cannot be j>=0 with Size j
+            for (j=n-1; j > 0; --j)
+                retVal[ri[j-1]] -= t[j]*retVal[ri[j]];
+        }
     }
 }
@@ -48,8 +48,19 @@ namespace QuantLib {
         TripleBandLinearOp& operator=(const Disposable<TripleBandLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        void apply(const Array& r, Array& out) const;
+        /*! The coefficients of the Thomas algorithm are kept by the
+            instance and reused as long as neither the operator nor
+            a and b change, which saves most of the work when the
+            same system is solved at each time step.  As a
+            consequence, different threads must not call the solver
+            on the same instance at the same time.
+        */
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
+        //! in-place variant; out must not be the same array as r
+        void solve_splitting(const Array& r, Real a, Real b,
+                             Array& out) const;
 
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         Disposable<TripleBandLinearOp> add(const TripleBandLinearOp& m) const;
@@ -66,14 +77,22 @@ namespace QuantLib {
 #endif
 
       protected:
-        TripleBandLinearOp() {}
+        TripleBandLinearOp() : factorized_(false) {}
 
         Size direction_;
+        // index tables, shared with the layout and never modified
         boost::shared_array<Size> i0_, i2_;
         boost::shared_array<Size> reverseIndex_;
         boost::shared_array<Real> lower_, diag_, upper_;
 
         boost::shared_ptr<FdmMesher> mesher_;
+
+      private:
+        void factorize(Real a, Real b) const;
+        // Thomas coefficients for the last (a, b), if still valid
+        mutable Array factorT_, factorInvBet_;
+        mutable Real factorA_, factorB_;
+        mutable bool factorized_;
     };
 }
 
@@ -0,0 +1,49 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
+
+namespace QuantLib {
+
+    CrankNicolsonScheme::CrankNicolsonScheme(
+        Real theta,
+        const boost::shared_ptr<FdmLinearOpComposite>& map,
+        const bc_set& bcSet,
+        Real relTol,
+        ImplicitEulerScheme::SolverType solverType)
+    : theta_   (theta),
+      explicit_(map, bcSet),
+      implicit_(map, bcSet, relTol, solverType) {
+        QL_REQUIRE(theta_ >= 0.0 && theta_ <= 1.0,
+                   "theta (" << theta_ << ") must be in [0, 1]");
+    }
+
+    void CrankNicolsonScheme::step(array_type& a, Time t) {
+        if (theta_ != 1.0)
+            explicit_.step(a, t, 1.0-theta_);
+
+        if (theta_ != 0.0)
+            implicit_.step(a, t, theta_);
+    }
+
+    void CrankNicolsonScheme::setStep(Time dt) {
+        explicit_.setStep(dt);
+        implicit_.setStep(dt);
+    }
+}
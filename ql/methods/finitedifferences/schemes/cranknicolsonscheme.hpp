@@ -0,0 +1,67 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cranknicolsonscheme.hpp
+    \brief Crank-Nicolson scheme
+*/
+
+#ifndef quantlib_crank_nicolson_scheme_hpp
+#define quantlib_crank_nicolson_scheme_hpp
+
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
+
+namespace QuantLib {
+
+    //! Crank-Nicolson scheme
+    /*! Unlike the operator-splitting schemes, the implicit part of
+        the step is solved for the full operator, mixed derivatives
+        included, by means of the iterative solvers used by
+        ImplicitEulerScheme.  A theta different from 0.5 gives the
+        general theta-scheme.
+    */
+    class CrankNicolsonScheme  {
+      public:
+        // typedefs
+        typedef OperatorTraits<FdmLinearOp> traits;
+        typedef traits::operator_type operator_type;
+        typedef traits::array_type array_type;
+        typedef traits::bc_set bc_set;
+        typedef traits::condition_type condition_type;
+
+        // constructors
+        CrankNicolsonScheme(
+            Real theta,
+            const boost::shared_ptr<FdmLinearOpComposite>& map,
+            const bc_set& bcSet = bc_set(),
+            Real relTol = 1e-8,
+            ImplicitEulerScheme::SolverType solverType
+                = ImplicitEulerScheme::BiCGstab);
+
+        void step(array_type& a, Time t);
+        void setStep(Time dt);
+
+      protected:
+        const Real theta_;
+        ExplicitEulerScheme explicit_;
+        ImplicitEulerScheme implicit_;
+    };
+}
+
+#endif
@@ -54,6 +54,9 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> & map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // work arrays, kept across steps to avoid reallocations
+        Array y_, rhs_, work_;
     };
 }
 
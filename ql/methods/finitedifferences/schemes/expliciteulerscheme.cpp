@@ -29,12 +29,16 @@ namespace QuantLib {
     }
 
     void ExplicitEulerScheme::step(array_type& a, Time t) {
+        step(a, t, 1.0);
+    }
+
+    void ExplicitEulerScheme::step(array_type& a, Time t, Real theta) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t - dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        a += dt_ * map_->apply(a);
+        a += (theta*dt_) * map_->apply(a);
         bcSet_.applyAfterApplying(a);
     }
 
@@ -49,9 +49,12 @@ namespace QuantLib {
         void step(array_type& a, Time t);
         void setStep(Time dt);
 
+        //! computes \f$ a' = (1 + \theta \Delta t L) a \f$
+        void step(array_type& a, Time t, Real theta);
+
       protected:
         Time dt_;
-        const boost::shared_ptr<FdmLinearOpComposite> & map_;
+        const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
     };
 }
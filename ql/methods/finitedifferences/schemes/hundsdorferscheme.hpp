@@ -59,6 +59,9 @@ namespace QuantLib {
 
         const boost::shared_ptr<FdmLinearOpComposite> & map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // work arrays, kept across steps to avoid reallocations
+        Array y_, y0_, rhs_, work_;
     };
 }
 
@@ -20,6 +20,7 @@
 */
 
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 
 #include <boost/bind.hpp>
@@ -27,36 +28,60 @@
 
 namespace QuantLib {
 
+    namespace {
+        // dimension of the Krylov space and maximum number of
+        // restarts for GMRES; this bounds the memory used to
+        // gmresRestartSize work arrays regardless of the grid size.
+        const Size gmresRestartSize = 50;
+        const Size gmresMaxRestarts = 20;
+    }
+
     ImplicitEulerScheme::ImplicitEulerScheme(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const bc_set& bcSet,
-        Real relTol)
+        Real relTol,
+        SolverType solverType)
     : dt_    (Null<Real>()),
+      theta_ (1.0),
       relTol_(relTol),
+      solverType_(solverType),
       map_   (map),
       bcSet_ (bcSet) {
     }
 
     Disposable<Array> ImplicitEulerScheme::apply(const Array& r) const {
-        return r - dt_*map_->apply(r);
+        return r - (theta_*dt_)*map_->apply(r);
     }
 
     void ImplicitEulerScheme::step(array_type& a, Time t) {
+        step(a, t, 1.0);
+    }
+
+    void ImplicitEulerScheme::step(array_type& a, Time t, Real theta) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeSolving(*map_, a);
 
-        a = BiCGstab(
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&ImplicitEulerScheme::apply, this, _1)), 
-                10*a.size(), relTol_,
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&FdmLinearOpComposite::preconditioner, 
-                                map_, _1, -dt_))
-            ).solve(a).x;
-        
+        theta_ = theta;
+
+        const boost::function<Disposable<Array>(const Array&)>
+            applyF(boost::bind(&ImplicitEulerScheme::apply, this, _1));
+        const boost::function<Disposable<Array>(const Array&)>
+            preconditionerF(boost::bind(&FdmLinearOpComposite::preconditioner,
+                                        map_, _1, -theta_*dt_));
+
+        // the values at the previous time level are a good first guess
+        if (solverType_ == BiCGstab) {
+            a = QuantLib::BiCGstab(applyF, 10*a.size(), relTol_,
+                                   preconditionerF).solve(a, a).x;
+        } else {
+            a = QuantLib::GMRES(applyF, std::min(gmresRestartSize, a.size()),
+                                relTol_, preconditionerF)
+                .solveWithRestart(gmresMaxRestarts, a, a).x;
+        }
+
         bcSet_.applyAfterSolving(a);
     }
 
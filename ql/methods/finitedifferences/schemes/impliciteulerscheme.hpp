@@ -32,8 +32,19 @@
 
 namespace QuantLib {
 
+    //! implicit-Euler scheme
+    /*! The coupled system is never assembled; each step is solved
+        by a Krylov method (BiCGStab or restarted GMRES) using only
+        the action of the operator, preconditioned by the operator's
+        own preconditioner and warm-started from the values at the
+        previous time level.
+
+        The theta-weighted step is used by the Crank-Nicolson scheme.
+    */
     class ImplicitEulerScheme {
       public:
+        enum SolverType { BiCGstab, GMRES };
+
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
         typedef traits::operator_type operator_type;
@@ -45,16 +56,22 @@ namespace QuantLib {
         ImplicitEulerScheme(
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const bc_set& bcSet = bc_set(),
-            Real relTol = 1e-8);
+            Real relTol = 1e-8,
+            SolverType solverType = BiCGstab);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
 
+        //! solves \f$ (1 - \theta \Delta t L) a' = a \f$
+        void step(array_type& a, Time t, Real theta);
+
       protected:
-        Disposable<Array> apply(const Array& r) const;   
-          
+        Disposable<Array> apply(const Array& r) const;
+
         Time dt_;
+        Real theta_;
         const Real relTol_;
+        const SolverType solverType_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
     };
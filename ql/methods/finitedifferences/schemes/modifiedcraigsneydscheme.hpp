@@ -60,6 +60,9 @@ namespace QuantLib {
         const Real mu_;
         const boost::shared_ptr<FdmLinearOpComposite> & map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // work arrays, kept across steps to avoid reallocations
+        Array y_, y0_, rhs_, work_;
     };
 }
 
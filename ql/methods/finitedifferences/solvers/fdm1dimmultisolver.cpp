@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimmultisolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+
+namespace QuantLib {
+
+    Fdm1DimMultiSolver::Fdm1DimMultiSolver(
+        const boost::shared_ptr<FdmMesher>& mesher,
+        const FdmBoundaryConditionSet& bcSet,
+        const std::vector<boost::shared_ptr<FdmStepConditionComposite> >&
+                                                                   conditions,
+        const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >&
+                                                                  calculators,
+        Time maturity, Size timeSteps, Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc,
+        const boost::shared_ptr<FdmLinearOpComposite>& op)
+    : mesher_(mesher),
+      bcSet_(bcSet),
+      calculators_(calculators),
+      maturity_(maturity),
+      timeSteps_(timeSteps),
+      dampingSteps_(dampingSteps),
+      schemeDesc_(schemeDesc),
+      op_(op),
+      x_(mesher->layout()->size()) {
+
+        QL_REQUIRE(conditions.size() == calculators.size(),
+                   "number of conditions (" << conditions.size()
+                   << ") and of calculators (" << calculators.size()
+                   << ") do not match");
+
+        for (Size i=0; i < conditions.size(); ++i) {
+            const std::vector<Time>& stoppingTimes
+                = conditions[i]->stoppingTimes();
+            thetaConditions_.push_back(
+                boost::shared_ptr<FdmSnapshotCondition>(
+                    new FdmSnapshotCondition(
+                        0.99*std::min(1.0/365.0,
+                                      stoppingTimes.empty()
+                                      ? maturity : stoppingTimes.front()))));
+            conditions_.push_back(FdmStepConditionComposite::joinConditions(
+                                      thetaConditions_.back(), conditions[i]));
+        }
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            x_[iter.index()] = mesher->location(iter, 0);
+        }
+    }
+
+
+    void Fdm1DimMultiSolver::performCalculations() const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const FdmLinearOpIterator endIter = layout->end();
+
+        std::vector<Array> rhs(calculators_.size(), Array(layout->size()));
+        for (Size i=0; i < calculators_.size(); ++i) {
+            for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+                 ++iter) {
+                rhs[i][iter.index()]
+                    = calculators_[i]->avgInnerValue(iter, maturity_);
+            }
+        }
+
+        FdmBackwardSolver(op_, bcSet_,
+                          boost::shared_ptr<FdmStepConditionComposite>(),
+                          schemeDesc_)
+            .rollback(rhs, conditions_, maturity_, 0.0,
+                      timeSteps_, dampingSteps_);
+
+        resultValues_.swap(rhs);
+        interpolations_.resize(resultValues_.size());
+        for (Size i=0; i < resultValues_.size(); ++i) {
+            interpolations_[i] = boost::shared_ptr<CubicInterpolation>(new
+                MonotonicCubicNaturalSpline(x_.begin(), x_.end(),
+                                            resultValues_[i].begin()));
+        }
+    }
+
+    Real Fdm1DimMultiSolver::interpolateAt(Size i, Real x) const {
+        QL_REQUIRE(i < size(), "instrument index (" << i
+                   << ") out of range [0, " << size() << ")");
+        calculate();
+        return interpolations_[i]->operator()(x);
+    }
+
+    Real Fdm1DimMultiSolver::thetaAt(Size i, Real x) const {
+        QL_REQUIRE(i < size(), "instrument index (" << i
+                   << ") out of range [0, " << size() << ")");
+        QL_REQUIRE(conditions_[i]->stoppingTimes().front() > 0.0,
+                   "stopping time at zero-> can't calculate theta");
+
+        calculate();
+        const Array& thetaValues = thetaConditions_[i]->getValues();
+
+        Real temp = MonotonicCubicNaturalSpline(
+            x_.begin(), x_.end(), thetaValues.begin())(x);
+        return ( temp - interpolateAt(i, x) ) / thetaConditions_[i]->getTime();
+    }
+
+
+    Real Fdm1DimMultiSolver::derivativeX(Size i, Real x) const {
+        QL_REQUIRE(i < size(), "instrument index (" << i
+                   << ") out of range [0, " << size() << ")");
+        calculate();
+        return interpolations_[i]->derivative(x);
+    }
+
+    Real Fdm1DimMultiSolver::derivativeXX(Size i, Real x) const {
+        QL_REQUIRE(i < size(), "instrument index (" << i
+                   << ") out of range [0, " << size() << ")");
+        calculate();
+        return interpolations_[i]->secondDerivative(x);
+    }
+}
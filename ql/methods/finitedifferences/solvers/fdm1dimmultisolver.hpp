@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdm1dimmultisolver.hpp
+    \brief 1-d solver for several instruments sharing mesh and operator
+*/
+
+#ifndef quantlib_fdm_1_dim_multi_solver_hpp
+#define quantlib_fdm_1_dim_multi_solver_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+
+namespace QuantLib {
+
+    class CubicInterpolation;
+    class FdmSnapshotCondition;
+
+    //! 1-d solver for several instruments on the same mesh
+    /*! The payoffs of all instruments are rolled back together
+        through a single operator, so that the operator set-up at
+        each time step is shared among them; each instrument keeps
+        its own step conditions.  Values and derivatives of the i-th
+        instrument are read from its own column of results.
+    */
+    class Fdm1DimMultiSolver : public LazyObject {
+      public:
+        Fdm1DimMultiSolver(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const FdmBoundaryConditionSet& bcSet,
+            const std::vector<boost::shared_ptr<FdmStepConditionComposite> >&
+                                                                   conditions,
+            const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >&
+                                                                  calculators,
+            Time maturity, Size timeSteps, Size dampingSteps,
+            const FdmSchemeDesc& schemeDesc,
+            const boost::shared_ptr<FdmLinearOpComposite>& op);
+
+        //! number of instruments
+        Size size() const { return calculators_.size(); }
+
+        Real interpolateAt(Size i, Real x) const;
+        Real thetaAt(Size i, Real x) const;
+
+        Real derivativeX(Size i, Real x) const;
+        Real derivativeXX(Size i, Real x) const;
+
+      protected:
+        void performCalculations() const;
+
+      private:
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const FdmBoundaryConditionSet bcSet_;
+        const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >
+                                                                 calculators_;
+        const Time maturity_;
+        const Size timeSteps_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+        const boost::shared_ptr<FdmLinearOpComposite> op_;
+
+        std::vector<boost::shared_ptr<FdmSnapshotCondition> >
+                                                            thetaConditions_;
+        std::vector<boost::shared_ptr<FdmStepConditionComposite> >
+                                                                 conditions_;
+
+        std::vector<Real> x_;
+        mutable std::vector<Array> resultValues_;
+        mutable std::vector<boost::shared_ptr<CubicInterpolation> >
+                                                              interpolations_;
+    };
+}
+
+#endif
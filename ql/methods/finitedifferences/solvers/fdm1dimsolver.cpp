@@ -31,10 +31,15 @@ namespace QuantLib {
     Fdm1DimSolver::Fdm1DimSolver(
                              const FdmSolverDesc& solverDesc,
                              const FdmSchemeDesc& schemeDesc,
-                             const boost::shared_ptr<FdmLinearOpComposite>& op)
+                             const boost::shared_ptr<FdmLinearOpComposite>& op,
+                             const std::vector<boost::shared_ptr<
+                                    FdmLinearOpComposite> >& derivativeOps,
+                             Real adaptiveTolerance)
     : solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       op_(op),
+      derivativeOps_(derivativeOps),
+      adaptiveTolerance_(adaptiveTolerance),
       thetaCondition_(new FdmSnapshotCondition(
         0.99*std::min(1.0/365.0,
            solverDesc.condition->stoppingTimes().empty()
@@ -44,7 +49,13 @@ namespace QuantLib {
                                                          solverDesc.condition)),
       x_            (solverDesc.mesher->layout()->size()),
       initialValues_(solverDesc.mesher->layout()->size()),
-      resultValues_ (solverDesc.mesher->layout()->size()) {
+      resultValues_ (solverDesc.mesher->layout()->size()),
+      acceptedSteps_(0), rejectedSteps_(0), errorEstimate_(0.0) {
+
+        QL_REQUIRE(adaptiveTolerance_ == Null<Real>()
+                   || derivativeOps_.empty(),
+                   "sensitivities not available "
+                   "with adaptive time stepping");
 
         const boost::shared_ptr<FdmMesher> mesher = solverDesc.mesher;
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
@@ -64,9 +75,28 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        FdmBackwardSolver solver(op_, solverDesc_.bcSet,
+                                 conditions_, schemeDesc_);
+        if (adaptiveTolerance_ != Null<Real>()) {
+            solver.rollbackAdaptive(rhs, solverDesc_.maturity, 0.0,
+                                    solverDesc_.timeSteps,
+                                    solverDesc_.dampingSteps,
+                                    adaptiveTolerance_);
+            acceptedSteps_ = solver.acceptedSteps();
+            rejectedSteps_ = solver.rejectedSteps();
+            errorEstimate_ = solver.errorEstimate();
+        }
+        else if (derivativeOps_.empty()) {
+            solver.rollback(rhs, solverDesc_.maturity, 0.0,
+                            solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        }
+        else {
+            sensitivities_.assign(derivativeOps_.size(), Array());
+            solver.rollbackSensitivities(rhs, sensitivities_, derivativeOps_,
+                                         solverDesc_.maturity, 0.0,
+                                         solverDesc_.timeSteps,
+                                         solverDesc_.dampingSteps);
+        }
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = boost::shared_ptr<CubicInterpolation>(new
@@ -104,4 +134,35 @@ namespace QuantLib {
         calculate();
         return interpolation_->secondDerivative(x);
     }
+
+    Real Fdm1DimSolver::sensitivityAt(Size i, Real x) const {
+        QL_REQUIRE(i < derivativeOps_.size(),
+                   "no derivative operator for sensitivity " << i);
+        calculate();
+        // the natural spline is linear in the data, hence it is the
+        // sensitivity of the interpolated values on the mesh
+        return CubicNaturalSpline(x_.begin(), x_.end(),
+                                  sensitivities_[i].begin())(x);
+    }
+
+    Size Fdm1DimSolver::acceptedSteps() const {
+        QL_REQUIRE(adaptiveTolerance_ != Null<Real>(),
+                   "adaptive time stepping not requested");
+        calculate();
+        return acceptedSteps_;
+    }
+
+    Size Fdm1DimSolver::rejectedSteps() const {
+        QL_REQUIRE(adaptiveTolerance_ != Null<Real>(),
+                   "adaptive time stepping not requested");
+        calculate();
+        return rejectedSteps_;
+    }
+
+    Real Fdm1DimSolver::errorEstimate() const {
+        QL_REQUIRE(adaptiveTolerance_ != Null<Real>(),
+                   "adaptive time stepping not requested");
+        calculate();
+        return errorEstimate_;
+    }
 }
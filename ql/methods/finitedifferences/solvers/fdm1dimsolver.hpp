@@ -37,9 +37,25 @@ namespace QuantLib {
 
     class Fdm1DimSolver : public LazyObject {
       public:
+        /*! If derivative operators are given, the sensitivities of
+            the values with respect to the corresponding parameters
+            are rolled back together with the values (see
+            FdmBackwardSolver::rollbackSensitivities).
+
+            If a tolerance is given, the values are rolled back with
+            error-controlled step sizes starting from the time steps
+            of the solver description (see
+            FdmBackwardSolver::rollbackAdaptive); this is not
+            available together with sensitivities.
+        */
         Fdm1DimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      const boost::shared_ptr<FdmLinearOpComposite>& op);
+                      const boost::shared_ptr<FdmLinearOpComposite>& op,
+                      const std::vector<boost::shared_ptr<
+                          FdmLinearOpComposite> >& derivativeOps
+                            = std::vector<boost::shared_ptr<
+                                                  FdmLinearOpComposite> >(),
+                      Real adaptiveTolerance = Null<Real>());
 
         Real interpolateAt(Real x) const;
         Real thetaAt(Real x) const;
@@ -47,6 +63,18 @@ namespace QuantLib {
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
 
+        //! sensitivity with respect to the i-th parameter
+        Real sensitivityAt(Size i, Real x) const;
+
+        /*! \name adaptive time stepping
+            available if a tolerance was given in the constructor
+        */
+        //@{
+        Size acceptedSteps() const;
+        Size rejectedSteps() const;
+        Real errorEstimate() const;
+        //@}
+
       protected:
         void performCalculations() const;
 
@@ -54,6 +82,9 @@ namespace QuantLib {
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const std::vector<boost::shared_ptr<FdmLinearOpComposite> >
+                                                              derivativeOps_;
+        const Real adaptiveTolerance_;
 
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
@@ -61,6 +92,9 @@ namespace QuantLib {
         std::vector<Real> x_, initialValues_;
         mutable Array resultValues_;
         mutable boost::shared_ptr<CubicInterpolation> interpolation_;
+        mutable std::vector<Array> sensitivities_;
+        mutable Size acceptedSteps_, rejectedSteps_;
+        mutable Real errorEstimate_;
     };
 }
 
@@ -31,10 +31,13 @@ namespace QuantLib {
     Fdm2DimSolver::Fdm2DimSolver(
                              const FdmSolverDesc& solverDesc,
                              const FdmSchemeDesc& schemeDesc,
-                             const boost::shared_ptr<FdmLinearOpComposite>& op)
+                             const boost::shared_ptr<FdmLinearOpComposite>& op,
+                             const std::vector<boost::shared_ptr<
+                                    FdmLinearOpComposite> >& derivativeOps)
     : solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       op_(op),
+      derivativeOps_(derivativeOps),
       thetaCondition_(new FdmSnapshotCondition(
         0.99*std::min(1.0/365.0,
            solverDesc.condition->stoppingTimes().empty()
@@ -73,15 +76,26 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        FdmBackwardSolver solver(op_, solverDesc_.bcSet,
+                                 conditions_, schemeDesc_);
+        if (derivativeOps_.empty()) {
+            solver.rollback(rhs, solverDesc_.maturity, 0.0,
+                            solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        }
+        else {
+            sensitivities_.assign(derivativeOps_.size(), Array());
+            solver.rollbackSensitivities(rhs, sensitivities_, derivativeOps_,
+                                         solverDesc_.maturity, 0.0,
+                                         solverDesc_.timeSteps,
+                                         solverDesc_.dampingSteps);
+        }
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = boost::shared_ptr<BicubicSpline> (
             new BicubicSpline(x_.begin(), x_.end(),
                               y_.begin(), y_.end(),
                               resultValues_));
+        thetaInterpolation_.reset();
     }
 
     Real Fdm2DimSolver::interpolateAt(Real x, Real y) const {
@@ -89,18 +103,38 @@ namespace QuantLib {
         return interpolation_->operator()(x, y);
     }
 
+    Disposable<Array> Fdm2DimSolver::interpolateAt(
+                                        const std::vector<Real>& x,
+                                        const std::vector<Real>& y) const {
+        QL_REQUIRE(x.size() == y.size(),
+                   "coordinate vectors have different sizes");
+        calculate();
+
+        Array retVal(x.size());
+        for (Size i=0; i < x.size(); ++i)
+            retVal[i] = interpolation_->operator()(x[i], y[i]);
+
+        return retVal;
+    }
+
     Real Fdm2DimSolver::thetaAt(Real x, Real y) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
 
         calculate();
-        Matrix thetaValues(resultValues_.rows(), resultValues_.columns());
 
-        const Array& rhs = thetaCondition_->getValues();
-        std::copy(rhs.begin(), rhs.end(), thetaValues.begin());
+        if (!thetaInterpolation_) {
+            thetaValues_ = Matrix(resultValues_.rows(),
+                                  resultValues_.columns());
+            const Array& rhs = thetaCondition_->getValues();
+            std::copy(rhs.begin(), rhs.end(), thetaValues_.begin());
 
-        return (BicubicSpline(x_.begin(), x_.end(), y_.begin(), y_.end(),
-                              thetaValues)(x, y) - interpolateAt(x, y))
+            thetaInterpolation_ = boost::shared_ptr<BicubicSpline>(
+                new BicubicSpline(x_.begin(), x_.end(),
+                                  y_.begin(), y_.end(), thetaValues_));
+        }
+
+        return ((*thetaInterpolation_)(x, y) - interpolateAt(x, y))
               / thetaCondition_->getTime();
     }
 
@@ -130,4 +164,16 @@ namespace QuantLib {
         return interpolation_->derivativeXY(x, y);
     }
 
+    Real Fdm2DimSolver::sensitivityAt(Size i, Real x, Real y) const {
+        QL_REQUIRE(i < derivativeOps_.size(),
+                   "no derivative operator for sensitivity " << i);
+        calculate();
+        Matrix values(resultValues_.rows(), resultValues_.columns());
+        std::copy(sensitivities_[i].begin(), sensitivities_[i].end(),
+                  values.begin());
+
+        return BicubicSpline(x_.begin(), x_.end(),
+                             y_.begin(), y_.end(), values)(x, y);
+    }
+
 }
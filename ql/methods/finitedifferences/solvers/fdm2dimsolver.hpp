@@ -37,19 +37,35 @@ namespace QuantLib {
 
     class Fdm2DimSolver : public LazyObject {
       public:
+        /*! If derivative operators are given, the sensitivities of
+            the values with respect to the corresponding parameters
+            are rolled back together with the values (see
+            FdmBackwardSolver::rollbackSensitivities).
+        */
         Fdm2DimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      const boost::shared_ptr<FdmLinearOpComposite>& op);
+                      const boost::shared_ptr<FdmLinearOpComposite>& op,
+                      const std::vector<boost::shared_ptr<
+                          FdmLinearOpComposite> >& derivativeOps
+                            = std::vector<boost::shared_ptr<
+                                                  FdmLinearOpComposite> >());
 
         Real interpolateAt(Real x, Real y) const;
         Real thetaAt(Real x, Real y) const;
 
+        //! values at the points (x[i], y[i])
+        Disposable<Array> interpolateAt(const std::vector<Real>& x,
+                                        const std::vector<Real>& y) const;
+
         Real derivativeX(Real x, Real y) const;
         Real derivativeY(Real x, Real y) const;
         Real derivativeXX(Real x, Real y) const;
         Real derivativeYY(Real x, Real y) const;
         Real derivativeXY(Real x, Real y) const;
 
+        //! sensitivity with respect to the i-th parameter
+        Real sensitivityAt(Size i, Real x, Real y) const;
+
       protected:
         void performCalculations() const;
 
@@ -57,6 +73,8 @@ namespace QuantLib {
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const std::vector<boost::shared_ptr<FdmLinearOpComposite> >
+                                                              derivativeOps_;
 
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
@@ -64,6 +82,10 @@ namespace QuantLib {
         std::vector<Real> x_, y_, initialValues_;
         mutable Matrix resultValues_;
         mutable boost::shared_ptr<BicubicSpline> interpolation_;
+        // built at the first call to thetaAt after each calculation
+        mutable Matrix thetaValues_;
+        mutable boost::shared_ptr<BicubicSpline> thetaInterpolation_;
+        mutable std::vector<Array> sensitivities_;
     };
 }
 
@@ -30,6 +30,14 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // below this number of slices the overhead of spawning
+        // threads exceeds the gain
+        const long minimumParallelSlices = 4;
+
+    }
+
     Fdm3DimSolver::Fdm3DimSolver(
                         const FdmSolverDesc& solverDesc,
                         const FdmSchemeDesc& schemeDesc,
@@ -85,50 +93,83 @@ namespace QuantLib {
              .rollback(rhs, solverDesc_.maturity, 0.0,
                        solverDesc_.timeSteps, solverDesc_.dampingSteps);
 
-        for (Size i=0; i < z_.size(); ++i) {
-            std::copy(rhs.begin()+i    *y_.size()*x_.size(),
-                      rhs.begin()+(i+1)*y_.size()*x_.size(),
-                      resultValues_[i].begin());
-
-            interpolation_[i] = boost::shared_ptr<BicubicSpline> (
-                new BicubicSpline(x_.begin(), x_.end(),
-                                  y_.begin(), y_.end(),
-                                  resultValues_[i]));
-        }
+        buildSlices(rhs, resultValues_, interpolation_);
+        thetaInterpolation_.clear();
     }
 
-    Real Fdm3DimSolver::interpolateAt(Real x, Real y, Rate z) const {
-        calculate();
+    void Fdm3DimSolver::buildSlices(
+            const Array& values, std::vector<Matrix>& slices,
+            std::vector<boost::shared_ptr<BicubicSpline> >& splines) const {
+        const Size sliceSize = y_.size()*x_.size();
+        const long nSlices = static_cast<long>(z_.size());
+
+        slices.resize(z_.size(), Matrix(y_.size(), x_.size()));
+        splines.resize(z_.size());
+
+        // the slices are independent; exceptions must not escape
+        // from the parallel region and are reported afterwards
+        long failures = 0;
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(static) reduction(+:failures) \
+            if(nSlices >= minimumParallelSlices)
+        #endif
+        for (long i=0; i < nSlices; ++i) {
+            std::copy(values.begin()+i*sliceSize,
+                      values.begin()+(i+1)*sliceSize,
+                      slices[i].begin());
+            try {
+                splines[i] = boost::shared_ptr<BicubicSpline>(
+                    new BicubicSpline(x_.begin(), x_.end(),
+                                      y_.begin(), y_.end(), slices[i]));
+            } catch (...) {
+                ++failures;
+            }
+        }
+        QL_REQUIRE(failures == 0, "could not build the interpolation on "
+                   << failures << " of " << nSlices << " slices");
+    }
 
+    Real Fdm3DimSolver::interpolateSlices(
+            const std::vector<boost::shared_ptr<BicubicSpline> >& splines,
+            Real x, Real y, Rate z) const {
         Array zArray(z_.size());
         for (Size i=0; i < z_.size(); ++i) {
-            zArray[i] = interpolation_[i]->operator()(x, y);
+            zArray[i] = splines[i]->operator()(x, y);
         }
         return MonotonicCubicNaturalSpline(z_.begin(), z_.end(),
                                            zArray.begin())(z);
     }
 
+    Real Fdm3DimSolver::interpolateAt(Real x, Real y, Rate z) const {
+        calculate();
+        return interpolateSlices(interpolation_, x, y, z);
+    }
+
+    Disposable<Array> Fdm3DimSolver::interpolateAt(
+                                        const std::vector<Real>& x,
+                                        const std::vector<Real>& y,
+                                        const std::vector<Rate>& z) const {
+        QL_REQUIRE(x.size() == y.size() && x.size() == z.size(),
+                   "coordinate vectors have different sizes");
+        calculate();
+
+        Array retVal(x.size());
+        for (Size i=0; i < x.size(); ++i)
+            retVal[i] = interpolateSlices(interpolation_, x[i], y[i], z[i]);
+
+        return retVal;
+    }
+
     Real Fdm3DimSolver::thetaAt(Real x, Real y, Rate z) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
         calculate();
 
-        const Array& rhs = thetaCondition_->getValues();
-        std::vector<Matrix> thetaValues(z_.size(), Matrix(y_.size(),x_.size()));
-        for (Size i=0; i < z_.size(); ++i) {
-            std::copy(rhs.begin()+i    *y_.size()*x_.size(),
-                      rhs.begin()+(i+1)*y_.size()*x_.size(),
-                      thetaValues[i].begin());
-        }
-
-        Array zArray(z_.size());
-        for (Size i=0; i < z_.size(); ++i) {
-            zArray[i] = BicubicSpline(x_.begin(),x_.end(),
-                                      y_.begin(),y_.end(), thetaValues[i])(x,y);
-        }
+        if (thetaInterpolation_.empty())
+            buildSlices(thetaCondition_->getValues(),
+                        thetaValues_, thetaInterpolation_);
 
-        return (MonotonicCubicNaturalSpline(z_.begin(), z_.end(),
-                                            zArray.begin())(z)
+        return (interpolateSlices(thetaInterpolation_, x, y, z)
                 - interpolateAt(x, y, z)) / thetaCondition_->getTime();
     }
 }
@@ -45,7 +45,20 @@ namespace QuantLib {
         Real interpolateAt(Real x, Real y, Rate z) const;
         Real thetaAt(Real x, Real y, Rate z) const;
 
+        //! values at the points (x[i], y[i], z[i])
+        Disposable<Array> interpolateAt(const std::vector<Real>& x,
+                                        const std::vector<Real>& y,
+                                        const std::vector<Rate>& z) const;
+
       private:
+        // one bicubic spline for each z-slice of the given values
+        void buildSlices(
+            const Array& values, std::vector<Matrix>& slices,
+            std::vector<boost::shared_ptr<BicubicSpline> >& splines) const;
+        Real interpolateSlices(
+            const std::vector<boost::shared_ptr<BicubicSpline> >& splines,
+            Real x, Real y, Rate z) const;
+
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<FdmLinearOpComposite> op_;
@@ -56,6 +69,10 @@ namespace QuantLib {
         std::vector<Real> x_, y_, z_, initialValues_;
         mutable std::vector<Matrix> resultValues_;
         mutable std::vector<boost::shared_ptr<BicubicSpline> > interpolation_;
+        // built at the first call to thetaAt after each calculation
+        mutable std::vector<Matrix> thetaValues_;
+        mutable std::vector<boost::shared_ptr<BicubicSpline> >
+                                                         thetaInterpolation_;
     };
 }
 
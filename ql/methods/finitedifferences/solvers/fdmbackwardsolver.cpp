@@ -26,14 +26,210 @@
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/operators/fdmsensitivityop.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsensitivitystepcondition.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
 
 namespace QuantLib {
-    
+
+    namespace {
+
+        // forwards to the given operator, but sets its time only
+        // when the time interval changes.
+        class TimeCachingOp : public FdmLinearOpComposite {
+          public:
+            explicit TimeCachingOp(
+                        const boost::shared_ptr<FdmLinearOpComposite>& map)
+            : map_(map), t1_(Null<Time>()), t2_(Null<Time>()) {}
+
+            Size size() const { return map_->size(); }
+            void setTime(Time t1, Time t2) {
+                if (t1 != t1_ || t2 != t2_) {
+                    map_->setTime(t1, t2);
+                    t1_ = t1;
+                    t2_ = t2;
+                }
+            }
+
+            Disposable<Array> apply(const Array& r) const {
+                return map_->apply(r);
+            }
+            void apply(const Array& r, Array& out) const {
+                map_->apply(r, out);
+            }
+            Disposable<Array> apply_mixed(const Array& r) const {
+                return map_->apply_mixed(r);
+            }
+            void apply_mixed(const Array& r, Array& out) const {
+                map_->apply_mixed(r, out);
+            }
+            Disposable<Array> apply_direction(Size direction,
+                                              const Array& r) const {
+                return map_->apply_direction(direction, r);
+            }
+            void apply_direction(Size direction,
+                                 const Array& r, Array& out) const {
+                map_->apply_direction(direction, r, out);
+            }
+            Disposable<Array> solve_splitting(Size direction,
+                                              const Array& r, Real s) const {
+                return map_->solve_splitting(direction, r, s);
+            }
+            void solve_splitting(Size direction, const Array& r,
+                                 Real s, Array& out) const {
+                map_->solve_splitting(direction, r, s, out);
+            }
+            Disposable<Array> preconditioner(const Array& r, Real s) const {
+                return map_->preconditioner(r, s);
+            }
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+            Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
+                return map_->toMatrixDecomp();
+            }
+#endif
+          private:
+            const boost::shared_ptr<FdmLinearOpComposite> map_;
+            Time t1_, t2_;
+        };
+
+        // error-controlled rollback; the evolver is passed to the call
+        // operator so that the same code can drive any scheme.
+        class AdaptiveRollback {
+          public:
+            AdaptiveRollback(
+                        const boost::shared_ptr<FdmLinearOpComposite>& map,
+                        const FdmBoundaryConditionSet& bcSet,
+                        const StepCondition<Array>& condition,
+                        const std::vector<Time>& stoppingTimes,
+                        Size dampingSteps, Real tolerance)
+            : accepted(0), rejected(0), error(0.0),
+              damper_(map, bcSet), condition_(condition),
+              stoppingTimes_(stoppingTimes),
+              dampingSteps_(dampingSteps), tolerance_(tolerance) {}
+
+            template <class Evolver>
+            void operator()(Evolver& evolver, Real order,
+                            Array& a, Time from, Time to, Time initialStep);
+
+            Size accepted, rejected;
+            Real error;
+
+          private:
+            ImplicitEulerScheme damper_;
+            const StepCondition<Array>& condition_;
+            const std::vector<Time> stoppingTimes_;
+            const Size dampingSteps_;
+            const Real tolerance_;
+        };
+
+        template <class Evolver>
+        void AdaptiveRollback::operator()(Evolver& evolver, Real order,
+                                          Array& a, Time from, Time to,
+                                          Time initialStep) {
+            // step-size control parameters
+            const Real safety = 0.9, maxGrowth = 2.0, maxShrink = 0.2;
+            const Time minStep = 1e-3*initialStep;
+
+            // the ends of the segments are the stopping times between
+            // from and to, in decreasing order, followed by to itself
+            std::vector<Time> ends;
+            for (Size i=0; i < stoppingTimes_.size(); ++i) {
+                if (stoppingTimes_[i] < from && stoppingTimes_[i] > to)
+                    ends.push_back(stoppingTimes_[i]);
+            }
+            std::sort(ends.begin(), ends.end(), std::greater<Time>());
+            ends.erase(std::unique(ends.begin(), ends.end()), ends.end());
+            ends.push_back(to);
+
+            if (std::find(stoppingTimes_.begin(), stoppingTimes_.end(), from)
+                                                    != stoppingTimes_.end())
+                condition_.applyTo(a, from);
+
+            // The damping steps can't be error-controlled: on the
+            // non-smooth data they are meant to smooth, the estimate
+            // doesn't decrease with the step size.  They are confined
+            // instead to the first half of an initial step, since
+            // their error, which dominates that of the Greeks close
+            // to the discontinuity, shrinks with the span they cover.
+            const Time dampingStep =
+                0.5*initialStep/std::max<Size>(dampingSteps_, 1);
+
+            Array y1, y2;
+            Time t = from, dt = initialStep;
+            for (Size i=0; i < ends.size(); ++i) {
+                const Time end = ends[i];
+                // start afresh after a possible discontinuity
+                dt = std::min(dt, initialStep);
+                Size damping = dampingSteps_;
+
+                while (t > end) {
+                    const Time step =
+                        (damping > 0) ? std::min(dt, dampingStep) : dt;
+                    const Time h =
+                        (t - step - end < minStep) ? t - end : step;
+                    const Time next = (h == t - end) ? end : t - h;
+
+                    if (damping > 0) {
+                        damper_.setStep(h);
+                        damper_.step(a, t);
+                        condition_.applyTo(a, next);
+                        t = next;
+                        --damping;
+                        ++accepted;
+                        continue;
+                    }
+
+                    // one full step and two half steps
+                    y1 = a;
+                    evolver.setStep(h);
+                    evolver.step(y1, t);
+                    y2 = a;
+                    evolver.setStep(0.5*h);
+                    evolver.step(y2, t);
+                    evolver.step(y2, t - 0.5*h);
+
+                    Real diff = 0.0;
+                    for (Size j=0; j < y1.size(); ++j)
+                        diff = std::max(diff, std::fabs(y1[j] - y2[j]));
+                    // Richardson estimate of the error of the half steps
+                    const Real err = diff/(std::pow(2.0, order) - 1.0);
+
+                    const bool ok = (err <= tolerance_ || h <= minStep);
+                    if (ok) {
+                        a.swap(y2);
+                        condition_.applyTo(a, next);
+                        t = next;
+                        ++accepted;
+                        error += err;
+                    } else {
+                        ++rejected;
+                    }
+
+                    const Real factor = (err > 0.0)
+                        ? safety*std::pow(tolerance_/err, 1.0/(order+1.0))
+                        : maxGrowth;
+                    const Time newStep =
+                        h*std::min(maxGrowth, std::max(maxShrink, factor));
+                    // a step shortened to hit the end of the segment
+                    // says little about the size of the following ones
+                    dt = (ok && h < dt) ? std::max(dt, newStep) : newStep;
+                    dt = std::max(dt, minStep);
+                }
+            }
+        }
+
+    }
+
     FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
     : type(aType), theta(aTheta), mu(aMu) { }
 
@@ -68,6 +264,10 @@ namespace QuantLib {
         return FdmSchemeDesc(FdmSchemeDesc::ImplicitEulerType, 0.0, 0.0);
     }
 
+    FdmSchemeDesc FdmSchemeDesc::CrankNicolson() {
+        return FdmSchemeDesc(FdmSchemeDesc::CrankNicolsonType, 0.5, 0.0);
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const FdmBoundaryConditionSet& bcSet,
@@ -79,12 +279,50 @@ namespace QuantLib {
                                  new FdmStepConditionComposite(
                                      std::list<std::vector<Time> >(),
                                      FdmStepConditionComposite::Conditions()))),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc),
+      acceptedSteps_(0), rejectedSteps_(0), errorEstimate_(0.0) {
      }
         
     void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
                                      Time from, Time to,
                                      Size steps, Size dampingSteps) {
+        std::vector<array_type> a(1);
+        a.front().swap(rhs);
+        const std::vector<boost::shared_ptr<FdmStepConditionComposite> >
+            conditions(1);
+        rollback(a, conditions, from, to, steps, dampingSteps);
+        rhs.swap(a.front());
+    }
+
+    void FdmBackwardSolver::rollback(
+            std::vector<FdmBackwardSolver::array_type>& a,
+            const std::vector<boost::shared_ptr<FdmStepConditionComposite> >&
+                                                                   conditions,
+            Time from, Time to,
+            Size steps, Size dampingSteps) {
+
+        QL_REQUIRE(a.size() == conditions.size(),
+                   "number of arrays (" << a.size()
+                   << ") and of conditions (" << conditions.size()
+                   << ") do not match");
+
+        std::vector<const StepCondition<array_type>*> c(a.size());
+        std::vector<Time> stoppingTimes;
+        for (Size i=0; i < a.size(); ++i) {
+            const FdmStepConditionComposite& condition =
+                (conditions[i]) ? *conditions[i] : *condition_;
+            c[i] = &condition;
+            stoppingTimes.insert(stoppingTimes.end(),
+                                 condition.stoppingTimes().begin(),
+                                 condition.stoppingTimes().end());
+        }
+
+        // with more than one array, the operator would be set to
+        // the same time once per array; the wrapper avoids that.
+        const boost::shared_ptr<FdmLinearOpComposite> map =
+            (a.size() > 1)
+            ? boost::shared_ptr<FdmLinearOpComposite>(new TimeCachingOp(map_))
+            : map_;
 
         const Time deltaT = from - to;
         const Size allSteps = steps + dampingSteps;
@@ -92,68 +330,198 @@ namespace QuantLib {
                     
         if (   dampingSteps 
             && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
+            ImplicitEulerScheme implicitEvolver(map, bcSet_);    
             FiniteDifferenceModel<ImplicitEulerScheme> 
-                    dampingModel(implicitEvolver, condition_->stoppingTimes());
-            dampingModel.rollback(rhs, from, dampingTo, 
-                                  dampingSteps, *condition_);
+                    dampingModel(implicitEvolver, stoppingTimes);
+            dampingModel.rollback(a, from, dampingTo, 
+                                  dampingSteps, c);
         }
         
         switch (schemeDesc_.type) {
           case FdmSchemeDesc::HundsdorferType:
             {
                 HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu, 
-                                            map_, bcSet_);
+                                            map, bcSet_);
                 FiniteDifferenceModel<HundsdorferScheme> 
-                               hsModel(hsEvolver, condition_->stoppingTimes());
-                hsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                               hsModel(hsEvolver, stoppingTimes);
+                hsModel.rollback(a, dampingTo, to, steps, c);
             }
             break;
           case FdmSchemeDesc::DouglasType:
             {
-                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
+                DouglasScheme dsEvolver(schemeDesc_.theta, map, bcSet_);
                 FiniteDifferenceModel<DouglasScheme> 
-                               dsModel(dsEvolver, condition_->stoppingTimes());
-                dsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                               dsModel(dsEvolver, stoppingTimes);
+                dsModel.rollback(a, dampingTo, to, steps, c);
             }
             break;
           case FdmSchemeDesc::CraigSneydType:
             {
                 CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu, 
-                                           map_, bcSet_);
+                                           map, bcSet_);
                 FiniteDifferenceModel<CraigSneydScheme> 
-                               csModel(csEvolver, condition_->stoppingTimes());
-                csModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                               csModel(csEvolver, stoppingTimes);
+                csModel.rollback(a, dampingTo, to, steps, c);
             }
             break;
           case FdmSchemeDesc::ModifiedCraigSneydType:
             {
                 ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta, 
                                                    schemeDesc_.mu,
-                                                   map_, bcSet_);
+                                                   map, bcSet_);
                 FiniteDifferenceModel<ModifiedCraigSneydScheme> 
-                              mcsModel(csEvolver, condition_->stoppingTimes());
-                mcsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                              mcsModel(csEvolver, stoppingTimes);
+                mcsModel.rollback(a, dampingTo, to, steps, c);
             }
             break;
           case FdmSchemeDesc::ImplicitEulerType:
             {
-                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                ImplicitEulerScheme implicitEvolver(map, bcSet_);
                 FiniteDifferenceModel<ImplicitEulerScheme> 
-                   implicitModel(implicitEvolver, condition_->stoppingTimes());
-                implicitModel.rollback(rhs, from, to, allSteps, *condition_);
+                   implicitModel(implicitEvolver, stoppingTimes);
+                implicitModel.rollback(a, from, to, allSteps, c);
             }
             break;
           case FdmSchemeDesc::ExplicitEulerType:
             {
-                ExplicitEulerScheme explicitEvolver(map_, bcSet_);
+                ExplicitEulerScheme explicitEvolver(map, bcSet_);
                 FiniteDifferenceModel<ExplicitEulerScheme> 
-                   explicitModel(explicitEvolver, condition_->stoppingTimes());
-                explicitModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                   explicitModel(explicitEvolver, stoppingTimes);
+                explicitModel.rollback(a, dampingTo, to, steps, c);
+            }
+            break;
+          case FdmSchemeDesc::CrankNicolsonType:
+            {
+                CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map, bcSet_);
+                FiniteDifferenceModel<CrankNicolsonScheme>
+                               cnModel(cnEvolver, stoppingTimes);
+                cnModel.rollback(a, dampingTo, to, steps, c);
             }
             break;
           default:
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    void FdmBackwardSolver::rollbackSensitivities(
+            FdmBackwardSolver::array_type& values,
+            std::vector<FdmBackwardSolver::array_type>& sensitivities,
+            const std::vector<boost::shared_ptr<FdmLinearOpComposite> >&
+                                                              derivativeOps,
+            Time from, Time to,
+            Size steps, Size dampingSteps) {
+
+        QL_REQUIRE(sensitivities.size() == derivativeOps.size(),
+                   "number of sensitivities (" << sensitivities.size()
+                   << ") and of derivative operators ("
+                   << derivativeOps.size() << ") do not match");
+        QL_REQUIRE(bcSet_.empty(), "boundary conditions are not supported "
+                   "when rolling back sensitivities");
+
+        const Size n = values.size();
+        const Size m = sensitivities.size();
+
+        array_type a(n*(m+1), 0.0);
+        std::copy(values.begin(), values.end(), a.begin());
+        for (Size k=0; k < m; ++k) {
+            if (!sensitivities[k].empty()) {
+                QL_REQUIRE(sensitivities[k].size() == n,
+                           "wrong size of sensitivity array " << k);
+                std::copy(sensitivities[k].begin(), sensitivities[k].end(),
+                          a.begin() + (k+1)*n);
+            }
+        }
+
+        const boost::shared_ptr<FdmLinearOpComposite> op(
+                              new FdmSensitivityOp(map_, derivativeOps, n));
+        const boost::shared_ptr<FdmStepConditionComposite> condition(
+            new FdmStepConditionComposite(
+                std::list<std::vector<Time> >(1, condition_->stoppingTimes()),
+                FdmStepConditionComposite::Conditions(1,
+                    boost::shared_ptr<StepCondition<array_type> >(
+                        new FdmSensitivityStepCondition(condition_, n)))));
+
+        FdmBackwardSolver(op, bcSet_, condition, schemeDesc_)
+            .rollback(a, from, to, steps, dampingSteps);
+
+        std::copy(a.begin(), a.begin() + n, values.begin());
+        for (Size k=0; k < m; ++k) {
+            sensitivities[k] = array_type(n);
+            std::copy(a.begin() + (k+1)*n, a.begin() + (k+2)*n,
+                      sensitivities[k].begin());
+        }
+    }
+
+    void FdmBackwardSolver::rollbackAdaptive(
+                                        FdmBackwardSolver::array_type& a,
+                                        Time from, Time to,
+                                        Size steps, Size dampingSteps,
+                                        Real tolerance) {
+        QL_REQUIRE(from >= to,
+                   "trying to roll back from " << from << " to " << to);
+        QL_REQUIRE(steps > 0, "at least one time step required");
+        QL_REQUIRE(tolerance > 0.0,
+                   "positive tolerance required (" << tolerance << ")");
+
+        AdaptiveRollback rollback(map_, bcSet_, *condition_,
+                                  condition_->stoppingTimes(),
+                                  dampingSteps, tolerance);
+        const Time initialStep = (from - to)/steps;
+
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+            {
+                HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                            map_, bcSet_);
+                rollback(hsEvolver, 2.0, a, from, to, initialStep);
+            }
+            break;
+          case FdmSchemeDesc::DouglasType:
+            {
+                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
+                rollback(dsEvolver, 2.0, a, from, to, initialStep);
+            }
+            break;
+          case FdmSchemeDesc::CraigSneydType:
+            {
+                CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                           map_, bcSet_);
+                rollback(csEvolver, 2.0, a, from, to, initialStep);
+            }
+            break;
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            {
+                ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta,
+                                                   schemeDesc_.mu,
+                                                   map_, bcSet_);
+                rollback(csEvolver, 2.0, a, from, to, initialStep);
+            }
+            break;
+          case FdmSchemeDesc::ImplicitEulerType:
+            {
+                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                rollback(implicitEvolver, 1.0, a, from, to, initialStep);
+            }
+            break;
+          case FdmSchemeDesc::ExplicitEulerType:
+            {
+                ExplicitEulerScheme explicitEvolver(map_, bcSet_);
+                rollback(explicitEvolver, 1.0, a, from, to, initialStep);
+            }
+            break;
+          case FdmSchemeDesc::CrankNicolsonType:
+            {
+                CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_);
+                rollback(cnEvolver, (schemeDesc_.theta == 0.5) ? 2.0 : 1.0,
+                         a, from, to, initialStep);
+            }
+            break;
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+
+        acceptedSteps_ = rollback.accepted;
+        rejectedSteps_ = rollback.rejected;
+        errorEstimate_ = rollback.error;
+    }
 }
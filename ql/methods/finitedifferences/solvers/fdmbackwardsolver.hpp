@@ -35,7 +35,8 @@ namespace QuantLib {
     struct FdmSchemeDesc {
         enum FdmSchemeType { HundsdorferType, DouglasType, 
                              CraigSneydType, ModifiedCraigSneydType, 
-                             ImplicitEulerType, ExplicitEulerType };
+                             ImplicitEulerType, ExplicitEulerType,
+                             CrankNicolsonType };
 
         FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
 
@@ -50,6 +51,7 @@ namespace QuantLib {
         static FdmSchemeDesc ModifiedCraigSneyd(); 
         static FdmSchemeDesc Hundsdorfer();
         static FdmSchemeDesc ModifiedHundsdorfer();
+        static FdmSchemeDesc CrankNicolson();
     };
         
     class FdmBackwardSolver {
@@ -66,11 +68,85 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        //! rolls back several arrays through the same operator
+        /*! The i-th array is subject to the i-th condition or, if
+            the latter is null, to the condition passed to the
+            constructor.  All arrays go through the same time steps,
+            which include the stopping times of all conditions, and
+            the operator is set to each of them only once, which
+            makes this considerably cheaper than separate rollbacks
+            when pricing several instruments on the same mesh.
+        */
+        void rollback(std::vector<array_type>& a,
+                      const std::vector<boost::shared_ptr<
+                                  FdmStepConditionComposite> >& conditions,
+                      Time from, Time to,
+                      Size steps, Size dampingSteps);
+
+        //! rolls back values together with their parameter sensitivities
+        /*! The i-th derivative operator is the derivative of the
+            operator passed to the constructor with respect to the
+            i-th parameter; the corresponding sensitivity is rolled
+            back on the same mesh and time grid by means of
+            FdmSensitivityOp.  Empty sensitivity arrays are
+            initialized to zero, as is appropriate when the payoff
+            does not depend on the parameter.  Boundary conditions
+            are not supported.
+        */
+        void rollbackSensitivities(
+            array_type& values,
+            std::vector<array_type>& sensitivities,
+            const std::vector<boost::shared_ptr<FdmLinearOpComposite> >&
+                                                              derivativeOps,
+            Time from, Time to,
+            Size steps, Size dampingSteps);
+
+        //! rolls back with error-controlled step sizes
+        /*! Each step is compared with two half steps; their
+            difference, measured in the maximum norm, gives an
+            estimate of the local error of the latter.  The step is
+            accepted if the estimate is below the given tolerance, in
+            which case the result of the two half steps is kept, and
+            the next step size is increased or decreased according to
+            the order of the scheme.
+
+            Steps end exactly on the stopping times of the condition.
+            At the start of the rollback and after each stopping
+            time, where the condition can introduce a discontinuity,
+            the step size is reset to (from-to)/steps and the given
+            number of implicit-Euler damping steps is taken
+            (Rannacher smoothing).  The damping steps are not
+            error-controlled, as the error estimate is meaningless on
+            non-smooth data; they are confined to the first half of
+            the initial step, which keeps their error, usually
+            dominating that of the Greeks close to a payoff
+            discontinuity, small.
+
+            The number of steps taken and the estimated error are
+            available through the inspectors below.
+        */
+        void rollbackAdaptive(array_type& a,
+                              Time from, Time to,
+                              Size steps, Size dampingSteps,
+                              Real tolerance);
+
+        //! \name adaptive rollback results
+        //@{
+        //! accepted steps, damping steps included
+        Size acceptedSteps() const { return acceptedSteps_; }
+        Size rejectedSteps() const { return rejectedSteps_; }
+        //! sum of the estimated errors of the accepted steps
+        Real errorEstimate() const { return errorEstimate_; }
+        //@}
+
       protected:
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const boost::shared_ptr<FdmStepConditionComposite> condition_;
         const FdmSchemeDesc schemeDesc_;
+
+        Size acceptedSteps_, rejectedSteps_;
+        Real errorEstimate_;
     };
 }
 
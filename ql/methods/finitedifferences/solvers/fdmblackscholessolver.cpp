@@ -22,6 +22,7 @@
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholessensitivityop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
 
 namespace QuantLib {
@@ -32,14 +33,20 @@ namespace QuantLib {
         const FdmSolverDesc& solverDesc,
         const FdmSchemeDesc& schemeDesc,
         bool localVol,
-        Real illegalLocalVolOverwrite)
+        Real illegalLocalVolOverwrite,
+        bool sensitivities,
+        Real adaptiveTolerance)
     : process_(process),
       strike_(strike),
       solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      sensitivities_(sensitivities),
+      adaptiveTolerance_(adaptiveTolerance) {
 
+        QL_REQUIRE(!(sensitivities_ && localVol_),
+                   "sensitivities not available with local volatility");
         registerWith(process_);
     }
 
@@ -48,8 +55,25 @@ namespace QuantLib {
                 solverDesc_.mesher, process_.currentLink(), strike_,
                 localVol_, illegalLocalVolOverwrite_));
 
+        std::vector<boost::shared_ptr<FdmLinearOpComposite> > derivativeOps;
+        if (sensitivities_) {
+            derivativeOps.push_back(
+                boost::shared_ptr<FdmLinearOpComposite>(
+                    new FdmBlackScholesSensitivityOp(
+                        solverDesc_.mesher,
+                        FdmBlackScholesSensitivityOp::Volatility,
+                        process_->blackVolatility().currentLink(),
+                        strike_)));
+            derivativeOps.push_back(
+                boost::shared_ptr<FdmLinearOpComposite>(
+                    new FdmBlackScholesSensitivityOp(
+                        solverDesc_.mesher,
+                        FdmBlackScholesSensitivityOp::RiskFreeRate)));
+        }
+
         solver_ = boost::shared_ptr<Fdm1DimSolver>(
-            new Fdm1DimSolver(solverDesc_, schemeDesc_, op));
+            new Fdm1DimSolver(solverDesc_, schemeDesc_, op, derivativeOps,
+                              adaptiveTolerance_));
     }
 
     Real FdmBlackScholesSolver::valueAt(Real s) const {
@@ -71,4 +95,31 @@ namespace QuantLib {
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
         return solver_->thetaAt(std::log(s));
     }
+
+    Real FdmBlackScholesSolver::vegaAt(Real s) const {
+        QL_REQUIRE(sensitivities_, "sensitivities not requested");
+        calculate();
+        return solver_->sensitivityAt(0, std::log(s));
+    }
+
+    Real FdmBlackScholesSolver::rhoAt(Real s) const {
+        QL_REQUIRE(sensitivities_, "sensitivities not requested");
+        calculate();
+        return solver_->sensitivityAt(1, std::log(s));
+    }
+
+    Size FdmBlackScholesSolver::acceptedSteps() const {
+        calculate();
+        return solver_->acceptedSteps();
+    }
+
+    Size FdmBlackScholesSolver::rejectedSteps() const {
+        calculate();
+        return solver_->rejectedSteps();
+    }
+
+    Real FdmBlackScholesSolver::errorEstimate() const {
+        calculate();
+        return solver_->errorEstimate();
+    }
 }
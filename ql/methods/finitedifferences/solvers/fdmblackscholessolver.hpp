@@ -44,13 +44,35 @@ namespace QuantLib {
             const FdmSolverDesc& solverDesc,
             const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
             bool localVol = false,
-            Real illegalLocalVolOverwrite = -Null<Real>());
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            bool sensitivities = false,
+            Real adaptiveTolerance = Null<Real>());
 
         Real valueAt(Real s) const;
         Real deltaAt(Real s) const;
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
 
+        /*! \name sensitivities
+            available if requested in the constructor; they are
+            obtained by solving the tangent equations on the same
+            mesh, see FdmSensitivityOp.
+        */
+        //@{
+        Real vegaAt(Real s) const;
+        Real rhoAt(Real s) const;
+        //@}
+
+        /*! \name adaptive time stepping
+            available if a tolerance was given in the constructor,
+            see Fdm1DimSolver.
+        */
+        //@{
+        Size acceptedSteps() const;
+        Size rejectedSteps() const;
+        Real errorEstimate() const;
+        //@}
+
       protected:
         void performCalculations() const;
 
@@ -61,6 +83,8 @@ namespace QuantLib {
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+        const bool sensitivities_;
+        const Real adaptiveTolerance_;
 
         mutable boost::shared_ptr<Fdm1DimSolver> solver_;
     };
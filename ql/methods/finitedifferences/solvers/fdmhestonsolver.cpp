@@ -21,6 +21,7 @@
 
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholessensitivityop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm2dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 
@@ -30,11 +31,13 @@ namespace QuantLib {
         const Handle<HestonProcess>& process,
         const FdmSolverDesc& solverDesc,
         const FdmSchemeDesc& schemeDesc,
-        const Handle<FdmQuantoHelper>& quantoHelper)
+        const Handle<FdmQuantoHelper>& quantoHelper,
+        bool sensitivities)
     : process_(process),
       solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
-      quantoHelper_(quantoHelper) {
+      quantoHelper_(quantoHelper),
+      sensitivities_(sensitivities) {
 
         registerWith(process_);
         registerWith(quantoHelper_);
@@ -47,8 +50,19 @@ namespace QuantLib {
                         (!quantoHelper_.empty()) ? quantoHelper_.currentLink()
                                      : boost::shared_ptr<FdmQuantoHelper>()));
 
+        // the equity part depends on the rate as in the
+        // Black-Scholes operator
+        std::vector<boost::shared_ptr<FdmLinearOpComposite> > derivativeOps;
+        if (sensitivities_) {
+            derivativeOps.push_back(
+                boost::shared_ptr<FdmLinearOpComposite>(
+                    new FdmBlackScholesSensitivityOp(
+                        solverDesc_.mesher,
+                        FdmBlackScholesSensitivityOp::RiskFreeRate)));
+        }
+
         solver_ = boost::shared_ptr<Fdm2DimSolver>(
-                               new Fdm2DimSolver(solverDesc_, schemeDesc_, op));
+            new Fdm2DimSolver(solverDesc_, schemeDesc_, op, derivativeOps));
     }
 
     Real FdmHestonSolver::valueAt(Real s, Real v) const {
@@ -88,4 +102,10 @@ namespace QuantLib {
         calculate();
         return solver_->thetaAt(std::log(s), v);
     }
+
+    Real FdmHestonSolver::rhoAt(Real s, Real v) const {
+        QL_REQUIRE(sensitivities_, "sensitivities not requested");
+        calculate();
+        return solver_->sensitivityAt(0, std::log(s), v);
+    }
 }
@@ -44,7 +44,8 @@ namespace QuantLib {
             const FdmSolverDesc& solverDesc,
             const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
             const Handle<FdmQuantoHelper>& quantoHelper
-                                                = Handle<FdmQuantoHelper>());
+                                                = Handle<FdmQuantoHelper>(),
+            bool sensitivities = false);
 
         Real valueAt(Real s, Real v) const;
         Real thetaAt(Real s, Real v) const;
@@ -60,6 +61,13 @@ namespace QuantLib {
         Real meanVarianceDeltaAt(Real s, Real v) const;
         Real meanVarianceGammaAt(Real s, Real v) const;
 
+        /*! sensitivity with respect to the risk-free zero rate,
+            available if requested in the constructor; it is obtained
+            by solving the tangent equation on the same mesh, see
+            FdmSensitivityOp.
+        */
+        Real rhoAt(Real s, Real v) const;
+
       protected:
         void performCalculations() const;
         
@@ -68,6 +76,7 @@ namespace QuantLib {
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const Handle<FdmQuantoHelper> quantoHelper_;
+        const bool sensitivities_;
 
         mutable boost::shared_ptr<Fdm2DimSolver> solver_;
     };
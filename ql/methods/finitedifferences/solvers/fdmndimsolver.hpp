@@ -50,6 +50,10 @@ namespace QuantLib {
         Real interpolateAt(const std::vector<Real>& x) const;
         Real thetaAt(const std::vector<Real>& x) const;
 
+        //! values at several points, with a single check for recalculation
+        Disposable<Array> interpolateAt(
+                        const std::vector<std::vector<Real> >& x) const;
+
         // template meta programming
         typedef typename MultiCubicSpline<N>::data_table data_table;
         void static setValue(data_table& f,
@@ -69,6 +73,9 @@ namespace QuantLib {
 
         mutable boost::shared_ptr<data_table> f_;
         mutable boost::shared_ptr<MultiCubicSpline<N> > interp_;
+        // built at the first call to thetaAt after each calculation
+        mutable boost::shared_ptr<data_table> thetaF_;
+        mutable boost::shared_ptr<MultiCubicSpline<N> > thetaInterp_;
     };
 
 
@@ -140,6 +147,7 @@ namespace QuantLib {
 
         interp_ = boost::shared_ptr<MultiCubicSpline<N> >(
             new MultiCubicSpline<N>(x_, *f_, extrapolation_));
+        thetaInterp_.reset();
     }
 
 
@@ -148,20 +156,27 @@ namespace QuantLib {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
         calculate();
-        const Array& rhs = thetaCondition_->getValues();
-        const boost::shared_ptr<FdmLinearOpLayout> layout
-                                            = solverDesc_.mesher->layout();
 
-        data_table f(x_);
+        if (!thetaInterp_) {
+            const Array& rhs = thetaCondition_->getValues();
+            const boost::shared_ptr<FdmLinearOpLayout> layout
+                                                = solverDesc_.mesher->layout();
 
-        const FdmLinearOpIterator endIter = layout->end();
-        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-             ++iter) {
-            setValue(f, iter.coordinates(), rhs[iter.index()]);
+            if (!thetaF_)
+                thetaF_ = boost::shared_ptr<data_table>(new data_table(x_));
+
+            const FdmLinearOpIterator endIter = layout->end();
+            for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+                 ++iter) {
+                setValue(*thetaF_, iter.coordinates(), rhs[iter.index()]);
+            }
+
+            thetaInterp_ = boost::shared_ptr<MultiCubicSpline<N> >(
+                new MultiCubicSpline<N>(x_, *thetaF_, extrapolation_));
         }
 
-        return (MultiCubicSpline<N>(x_, f)(x)
-                        - interpolateAt(x)) / thetaCondition_->getTime();
+        return ((*thetaInterp_)(x) - interpolateAt(x))
+                                                / thetaCondition_->getTime();
     }
 
     template <Size N> inline
@@ -171,6 +186,18 @@ namespace QuantLib {
         return (*interp_)(x);
     }
 
+    template <Size N> inline
+    Disposable<Array> FdmNdimSolver<N>::interpolateAt(
+                        const std::vector<std::vector<Real> >& x) const {
+        calculate();
+
+        Array retVal(x.size());
+        for (Size i=0; i < x.size(); ++i)
+            retVal[i] = (*interp_)(x[i]);
+
+        return retVal;
+    }
+
     template <Size N> inline
     void FdmNdimSolver<N>::setValue(data_table& f,
                                     const std::vector<Size>& x, Real value) {
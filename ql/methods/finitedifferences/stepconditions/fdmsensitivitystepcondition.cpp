@@ -0,0 +1,69 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/stepconditions/fdmsensitivitystepcondition.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace QuantLib {
+
+    FdmSensitivityStepCondition::FdmSensitivityStepCondition(
+            const boost::shared_ptr<StepCondition<Array> >& condition,
+            Size layoutSize)
+    : condition_(condition), n_(layoutSize),
+      v_(layoutSize), w_(layoutSize) {}
+
+    void FdmSensitivityStepCondition::applyTo(Array& a, Time t) const {
+        QL_REQUIRE(a.size() % n_ == 0 && a.size() > n_,
+                   "array size (" << a.size() << ") does not match");
+        const Size m = a.size()/n_ - 1;
+
+        std::copy(a.begin(), a.begin() + n_, v_.begin());
+        Real vMax = 0.0;
+        for (Size i=0; i < n_; ++i)
+            vMax = std::max(vMax, std::fabs(v_[i]));
+
+        // the perturbed values C(V + h u) are stored in place of u
+        std::vector<Real> h(m);
+        for (Size k=0; k < m; ++k) {
+            const Array::iterator u = a.begin() + (k+1)*n_;
+
+            Real uMax = 0.0;
+            for (Size i=0; i < n_; ++i)
+                uMax = std::max(uMax, std::fabs(u[i]));
+            h[k] = std::sqrt(QL_EPSILON)*(1.0 + vMax)
+                 / ((uMax > 0.0) ? uMax : 1.0);
+
+            for (Size i=0; i < n_; ++i)
+                w_[i] = v_[i] + h[k]*u[i];
+            condition_->applyTo(w_, t);
+            std::copy(w_.begin(), w_.end(), u);
+        }
+
+        condition_->applyTo(v_, t);
+        std::copy(v_.begin(), v_.end(), a.begin());
+
+        for (Size k=0; k < m; ++k) {
+            const Array::iterator u = a.begin() + (k+1)*n_;
+            for (Size i=0; i < n_; ++i)
+                u[i] = (u[i] - v_[i])/h[k];
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmsensitivitystepcondition.hpp
+    \brief step condition for values and their sensitivities
+*/
+
+#ifndef quantlib_fdm_sensitivity_step_condition_hpp
+#define quantlib_fdm_sensitivity_step_condition_hpp
+
+#include <ql/methods/finitedifferences/stepcondition.hpp>
+
+namespace QuantLib {
+
+    //! step condition for values and their sensitivities
+    /*! Applies a condition to arrays laid out as for
+        FdmSensitivityOp, i.e., values followed by the sensitivities.
+        The condition is applied to the values; each sensitivity
+        \f$ u \f$ is replaced by the directional derivative
+        \f$ (C(V + h u) - C(V))/h \f$ of the condition, which is
+        exact for linear conditions such as dividend shifts and
+        vanishes where an early exercise takes place.
+
+        The condition is applied to the values last, so that
+        snapshot conditions record the values.
+    */
+    class FdmSensitivityStepCondition : public StepCondition<Array> {
+      public:
+        FdmSensitivityStepCondition(
+            const boost::shared_ptr<StepCondition<Array> >& condition,
+            Size layoutSize);
+
+        void applyTo(Array& a, Time t) const;
+
+      private:
+        const boost::shared_ptr<StepCondition<Array> > condition_;
+        const Size n_;
+        mutable Array v_, w_;
+    };
+}
+
+#endif
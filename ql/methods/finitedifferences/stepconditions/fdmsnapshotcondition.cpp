@@ -20,27 +20,48 @@
 */
 
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
     FdmSnapshotCondition::FdmSnapshotCondition(Time t)
-    : t_(t) {
+    : times_(1, t), values_(1) {
+    }
+
+    FdmSnapshotCondition::FdmSnapshotCondition(const std::vector<Time>& times)
+    : times_(times), values_(times.size()) {
+        QL_REQUIRE(!times_.empty(), "no snapshot times given");
     }
 
 
     void FdmSnapshotCondition::applyTo(Array& a, Time t) const {
-        if (t == t_)
-            values_ = a;
+        const std::vector<Time>::const_iterator iter
+            = std::find(times_.begin(), times_.end(), t);
+        if (iter != times_.end())
+            values_[iter - times_.begin()] = a;
     }
 
 
     Time FdmSnapshotCondition::getTime() const {
-        return t_;
+        return times_.front();
     }
 
 
     const Array& FdmSnapshotCondition::getValues() const {
-        return values_;
+        return values_.front();
+    }
+
+
+    const std::vector<Time>& FdmSnapshotCondition::getTimes() const {
+        return times_;
+    }
+
+
+    const Array& FdmSnapshotCondition::getValues(Time t) const {
+        const std::vector<Time>::const_iterator iter
+            = std::find(times_.begin(), times_.end(), t);
+        QL_REQUIRE(iter != times_.end(), "no snapshot at time " << t);
+        return values_[iter - times_.begin()];
     }
 
 }
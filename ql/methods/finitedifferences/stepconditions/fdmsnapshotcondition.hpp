@@ -27,20 +27,34 @@
 #define quantlib_fdm_snapshot_condition_hpp
 
 #include <ql/methods/finitedifferences/stepcondition.hpp>
+#include <vector>
 
 namespace QuantLib {
 
+    //! step condition recording the values at given times
+    /*! When joined with other conditions (see
+        FdmStepConditionComposite::joinConditions) the values are
+        recorded before the other conditions are applied; together
+        with FdmArrayInnerValue, they can be used to resume a later
+        rollback from any of the given times.
+    */
     class FdmSnapshotCondition : public StepCondition<Array> {
     public:
         FdmSnapshotCondition(Time t);
+        FdmSnapshotCondition(const std::vector<Time>& times);
 
         void applyTo(Array& a, Time t) const;
+        //! first of the given times
         Time getTime() const;       
         const Array& getValues() const;
 
+        const std::vector<Time>& getTimes() const;
+        //! values recorded at the given time
+        const Array& getValues(Time t) const;
+
     private:
-        const Time t_;
-        mutable Array values_;
+        const std::vector<Time> times_;
+        mutable std::vector<Array> values_;
     };
 }
 #endif
@@ -29,6 +29,7 @@
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmbermudanstepcondition.hpp>
 
+#include <algorithm>
 #include <set>
 
 namespace QuantLib {
@@ -70,7 +71,7 @@ namespace QuantLib {
                 const boost::shared_ptr<FdmStepConditionComposite>& c2) {
 
         std::list<std::vector<Time> > stoppingTimes;
-        stoppingTimes.push_back(std::vector<Time>(1, c1->getTime()));
+        stoppingTimes.push_back(c1->getTimes());
         stoppingTimes.push_back(c2->stoppingTimes());
 
         FdmStepConditionComposite::Conditions conditions;
@@ -81,6 +82,21 @@ namespace QuantLib {
             new FdmStepConditionComposite(stoppingTimes, conditions));
     }
 
+    boost::shared_ptr<FdmStepConditionComposite>
+    FdmStepConditionComposite::resumeConditions(
+                const boost::shared_ptr<FdmStepConditionComposite>& c,
+                Time t) {
+
+        const std::vector<Time>& times = c->stoppingTimes();
+        std::list<std::vector<Time> > stoppingTimes;
+        stoppingTimes.push_back(std::vector<Time>(
+            times.begin(),
+            std::upper_bound(times.begin(), times.end(), t)));
+
+        return boost::shared_ptr<FdmStepConditionComposite>(
+            new FdmStepConditionComposite(stoppingTimes, Conditions(1, c)));
+    }
+
     boost::shared_ptr<FdmStepConditionComposite> 
     FdmStepConditionComposite::vanillaComposite(
                  const DividendSchedule& cashFlow,
@@ -56,6 +56,15 @@ namespace QuantLib {
                     const boost::shared_ptr<FdmSnapshotCondition>& c1,
                     const boost::shared_ptr<FdmStepConditionComposite>& c2);
 
+        /*! conditions for a rollback resumed at time t from values
+            recorded before the conditions were applied: the stopping
+            times after t are dropped, so that the conditions at t
+            are applied to the initial values.
+        */
+        static boost::shared_ptr<FdmStepConditionComposite> resumeConditions(
+                    const boost::shared_ptr<FdmStepConditionComposite>& c,
+                    Time t);
+
         static boost::shared_ptr<FdmStepConditionComposite> vanillaComposite(
              const DividendSchedule& schedule,
              const boost::shared_ptr<Exercise>& exercise,
@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/null.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcheckpointcache.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    Size FdmCheckpointCache::resumeIndex(
+                                const boost::shared_ptr<Observable>& key,
+                                const std::vector<Date>& dates) const {
+        if (!key_ || key_ != key || dates.empty()
+            || dates_.back() != dates.back())
+            return Null<Size>();
+
+        for (Size i=0; i < dates_.size(); ++i) {
+            // the stored values at dates_[i] already include the
+            // conditions at all later dates, which must thus agree
+            const std::vector<Date>::const_iterator later
+                = std::upper_bound(dates.begin(), dates.end(), dates_[i]);
+            if (Size(dates.end() - later) == dates_.size() - i - 1
+                && std::equal(later, dates.end(), dates_.begin() + i + 1))
+                return i;
+        }
+        return Null<Size>();
+    }
+
+    const std::vector<Date>& FdmCheckpointCache::dates() const {
+        return dates_;
+    }
+
+    const Array& FdmCheckpointCache::values(Size i) const {
+        QL_REQUIRE(i < values_.size(), "no checkpoint " << i);
+        return values_[i];
+    }
+
+    void FdmCheckpointCache::store(const boost::shared_ptr<Observable>& key,
+                                   const std::vector<Date>& dates,
+                                   const std::vector<Array>& values) {
+        QL_REQUIRE(dates.size() == values.size(),
+                   "number of dates (" << dates.size()
+                   << ") and of values (" << values.size()
+                   << ") do not match");
+        if (key != key_) {
+            if (key_)
+                unregisterWith(key_);
+            key_ = key;
+            registerWith(key_);
+        }
+        dates_ = dates;
+        values_ = values;
+    }
+
+    void FdmCheckpointCache::clear() {
+        dates_.clear();
+        values_.clear();
+        if (key_) {
+            unregisterWith(key_);
+            key_.reset();
+        }
+    }
+
+    void FdmCheckpointCache::update() {
+        clear();
+    }
+}
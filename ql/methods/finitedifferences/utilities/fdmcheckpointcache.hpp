@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmcheckpointcache.hpp
+    \brief values recorded during a rollback for resuming later ones
+*/
+
+#ifndef quantlib_fdm_checkpoint_cache_hpp
+#define quantlib_fdm_checkpoint_cache_hpp
+
+#include <ql/time/date.hpp>
+#include <ql/math/array.hpp>
+#include <ql/patterns/observable.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! values recorded during a rollback for resuming later ones
+    /*! The cache stores the values on the mesh recorded at the
+        stopping dates of a rollback, before the step conditions at
+        those dates were applied (see FdmSnapshotCondition).  A later
+        rollback of the same instrument on the same mesh can be
+        resumed from any stored date after which its stopping dates
+        agree with the stored ones, e.g., for a Bermudan swaption
+        whose exercise dates are a tail of those of a swaption priced
+        before.
+
+        The cache is cleared when the instrument passed as key
+        notifies a change.  Pricing engines should also clear it
+        when they are notified of a change in the model.
+    */
+    class FdmCheckpointCache : public Observer {
+      public:
+        /*! returns the index of the earliest stored date from which a
+            rollback of the given key with the given stopping dates
+            can be resumed, or Null<Size>() if there is none.
+        */
+        Size resumeIndex(const boost::shared_ptr<Observable>& key,
+                         const std::vector<Date>& dates) const;
+
+        const std::vector<Date>& dates() const;
+        const Array& values(Size i) const;
+
+        void store(const boost::shared_ptr<Observable>& key,
+                   const std::vector<Date>& dates,
+                   const std::vector<Array>& values);
+        void clear();
+
+        void update();
+
+      private:
+        boost::shared_ptr<Observable> key_;
+        std::vector<Date> dates_;
+        std::vector<Array> values_;
+    };
+}
+
+#endif
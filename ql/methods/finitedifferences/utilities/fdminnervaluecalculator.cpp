@@ -123,4 +123,19 @@ namespace QuantLib {
                                     const FdmLinearOpIterator& iter, Time t) {
         return innerValue(iter, t);
     }
+
+
+    FdmArrayInnerValue::FdmArrayInnerValue(const Array& values)
+    : values_(values) {
+    }
+
+    Real FdmArrayInnerValue::innerValue(const FdmLinearOpIterator& iter,
+                                        Time) {
+        return values_[iter.index()];
+    }
+
+    Real FdmArrayInnerValue::avgInnerValue(const FdmLinearOpIterator& iter,
+                                           Time t) {
+        return innerValue(iter, t);
+    }
 }
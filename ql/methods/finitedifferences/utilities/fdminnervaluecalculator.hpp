@@ -27,6 +27,7 @@
 #define quantlib_fdm_inner_value_calculator_hpp
 
 #include <ql/types.hpp>
+#include <ql/math/array.hpp>
 #include <boost/shared_ptr.hpp>
 #include <vector>
 
@@ -83,6 +84,21 @@ namespace QuantLib {
         Real innerValue(const FdmLinearOpIterator&, Time)    { return 0.0; }
         Real avgInnerValue(const FdmLinearOpIterator&, Time) { return 0.0; }
     };
+
+    //! values given on the mesh
+    /*! Used as the initial values of a rollback resumed from the
+        values recorded by a FdmSnapshotCondition.
+    */
+    class FdmArrayInnerValue : public FdmInnerValueCalculator {
+      public:
+        explicit FdmArrayInnerValue(const Array& values);
+
+        Real innerValue(const FdmLinearOpIterator& iter, Time);
+        Real avgInnerValue(const FdmLinearOpIterator& iter, Time);
+
+      private:
+        const Array values_;
+    };
 }
 
 #endif
@@ -98,7 +98,8 @@ namespace QuantLib {
     void TreeLattice<Impl>::computeStatePrices(Size until) const {
         for (Size i=statePricesLimit_; i<until; i++) {
             statePrices_.push_back(Array(this->impl().size(i+1), 0.0));
-            for (Size j=0; j<this->impl().size(i); j++) {
+            const Size size = this->impl().size(i);
+            for (Size j=0; j<size; j++) {
                 DiscountFactor disc = this->impl().discount(i,j);
                 Real statePrice = statePrices_[i][j];
                 for (Size l=0; l<n_; l++) {
@@ -152,11 +153,15 @@ namespace QuantLib {
         Integer iFrom = Integer(t_.index(from));
         Integer iTo = Integer(t_.index(to));
 
+        Array newValues;
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
+            const Size size = this->impl().size(i);
+            if (newValues.size() != size)
+                Array(size).swap(newValues);
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            // the old values are reused as storage for the next step
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
@@ -166,7 +171,8 @@ namespace QuantLib {
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
-        for (Size j=0; j<this->impl().size(i); j++) {
+        const Size size = this->impl().size(i);
+        for (Size j=0; j<size; j++) {
             Real value = 0.0;
             for (Size l=0; l<n_; l++) {
                 value += this->impl().probability(i,j,l) *
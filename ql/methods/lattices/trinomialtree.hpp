@@ -26,6 +26,7 @@
 #define quantlib_trinomial_tree_hpp
 
 #include <ql/methods/lattices/tree.hpp>
+#include <ql/math/array.hpp>
 #include <ql/timegrid.hpp>
 
 namespace QuantLib {
@@ -53,6 +54,16 @@ namespace QuantLib {
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
 
+        /*! rolls back the given values from step i+1 to step i,
+            multiplying the expectation at each node by the given
+            discount factor; this is equivalent to, but faster than,
+            the use of descendant() and probability() for each node.
+        */
+        void stepback(Size i,
+                      const Array& values,
+                      const Array& discounts,
+                      Array& newValues) const;
+
       protected:
         std::vector<Branching> branchings_;
         Real x0_;
@@ -72,9 +83,14 @@ namespace QuantLib {
             Integer jMin() const;
             Integer jMax() const;
             void add(Integer k, Real p1, Real p2, Real p3);
+            void stepback(const Array& values,
+                          const Array& discounts,
+                          Array& newValues) const;
           private:
             std::vector<Integer> k_;
-            std::vector<std::vector<Real> > probs_;
+            // the three probabilities of each node are stored
+            // contiguously, node after node
+            std::vector<Real> probs_;
             Integer kMin_, jMin_, kMax_, jMax_;
         };
     };
@@ -102,9 +118,16 @@ namespace QuantLib {
         return branchings_[i].probability(j, b);
     }
 
+    inline void TrinomialTree::stepback(Size i,
+                                        const Array& values,
+                                        const Array& discounts,
+                                        Array& newValues) const {
+        branchings_[i].stepback(values, discounts, newValues);
+    }
+
     inline TrinomialTree::Branching::Branching()
-    : probs_(3), kMin_(QL_MAX_INTEGER), jMin_(QL_MAX_INTEGER),
-                 kMax_(QL_MIN_INTEGER), jMax_(QL_MIN_INTEGER) {}
+    : kMin_(QL_MAX_INTEGER), jMin_(QL_MAX_INTEGER),
+      kMax_(QL_MIN_INTEGER), jMax_(QL_MIN_INTEGER) {}
 
     inline Size TrinomialTree::Branching::descendant(Size index,
                                                      Size branch) const {
@@ -113,7 +136,7 @@ namespace QuantLib {
 
     inline Real TrinomialTree::Branching::probability(Size index,
                                                       Size branch) const {
-        return probs_[branch][index];
+        return probs_[3*index + branch];
     }
 
     inline Size TrinomialTree::Branching::size() const {
@@ -132,9 +155,9 @@ namespace QuantLib {
                                               Real p1, Real p2, Real p3) {
         // store
         k_.push_back(k);
-        probs_[0].push_back(p1);
-        probs_[1].push_back(p2);
-        probs_[2].push_back(p3);
+        probs_.push_back(p1);
+        probs_.push_back(p2);
+        probs_.push_back(p3);
         // maintain invariants
         kMin_ = std::min(kMin_, k);
         jMin_ = kMin_ - 1;
@@ -142,6 +165,22 @@ namespace QuantLib {
         jMax_ = kMax_ + 1;
     }
 
+    inline void TrinomialTree::Branching::stepback(const Array& values,
+                                                   const Array& discounts,
+                                                   Array& newValues) const {
+        const Size n = k_.size();
+        QL_REQUIRE(discounts.size() == n && newValues.size() == n,
+                   "wrong number of nodes");
+        // the descendants of node j are k_[j]-jMin_-1 and the next two
+        const Integer offset = jMin_ + 1;
+        const Real* p = &probs_[0];
+        const Real* v = values.begin();
+        for (Size j=0; j<n; ++j, p+=3) {
+            const Real* d = v + (k_[j] - offset);
+            newValues[j] = discounts[j]*(p[0]*d[0] + p[1]*d[1] + p[2]*d[2]);
+        }
+    }
+
 }
 
 
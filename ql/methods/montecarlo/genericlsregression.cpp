@@ -2,6 +2,7 @@
 
 /*
  Copyright (C) 2006 Mark Joshi
+ Copyright (C) 2013 StatPro Italia srl
 
  This file is part of QuantLib, a free-software/open-source library
  for financial quantitative analysts and developers - http://quantlib.org/
@@ -18,14 +19,83 @@
 */
 
 #include <ql/methods/montecarlo/genericlsregression.hpp>
-#include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
+    void GenericLSRegressionWorkspace::reset(Size rows, Size basisSize) {
+        // std::vector never gives back capacity on shrinking
+        rows_ = rows;
+        basisSize_ = basisSize;
+        design_.resize(rows*(basisSize+1));
+        estimates_.resize(rows);
+        paths_.resize(rows);
+        if (normalMatrix_.rows() != basisSize) {
+            normalMatrix_ = Matrix(basisSize, basisSize);
+            factor_ = Matrix(basisSize, basisSize);
+            target_ = Array(basisSize);
+            means_ = Array(basisSize+1);
+            alphas_ = Array(basisSize);
+        }
+    }
+
+    bool GenericLSRegressionWorkspace::solve() {
+        const Size N = basisSize_;
+        const Matrix& C = normalMatrix_;
+        Matrix& L = factor_;
+
+        // Cholesky decomposition C = L L^T; a vanishing pivot means
+        // that the basis functions are linearly dependent
+        Real maxDiagonal = 0.0;
+        for (Size k=0; k<N; ++k)
+            maxDiagonal = std::max(maxDiagonal, C[k][k]);
+        const Real threshold = N*QL_EPSILON*maxDiagonal;
+        for (Size k=0; k<N; ++k) {
+            Real pivot = C[k][k];
+            for (Size p=0; p<k; ++p)
+                pivot -= L[k][p]*L[k][p];
+            if (pivot <= threshold)
+                return false;
+            L[k][k] = std::sqrt(pivot);
+            for (Size r=k+1; r<N; ++r) {
+                Real sum = C[r][k];
+                for (Size p=0; p<k; ++p)
+                    sum -= L[r][p]*L[k][p];
+                L[r][k] = sum/L[k][k];
+            }
+        }
+
+        // forward and back substitution
+        for (Size k=0; k<N; ++k) {
+            Real sum = target_[k];
+            for (Size p=0; p<k; ++p)
+                sum -= L[k][p]*alphas_[p];
+            alphas_[k] = sum/L[k][k];
+        }
+        for (Size k=N; k>0; --k) {
+            Real sum = alphas_[k-1];
+            for (Size p=k; p<N; ++p)
+                sum -= L[p][k-1]*alphas_[p];
+            alphas_[k-1] = sum/L[k-1][k-1];
+        }
+        return true;
+    }
+
     Real genericLongstaffSchwartzRegression(
                 std::vector<std::vector<NodeData> >& simulationData,
                 std::vector<std::vector<Real> >& basisCoefficients) {
+        GenericLSRegressionWorkspace workspace;
+        return genericLongstaffSchwartzRegression(simulationData,
+                                                  basisCoefficients,
+                                                  workspace);
+    }
+
+    Real genericLongstaffSchwartzRegression(
+                std::vector<std::vector<NodeData> >& simulationData,
+                std::vector<std::vector<Real> >& basisCoefficients,
+                GenericLSRegressionWorkspace& workspace) {
 
         Size steps = simulationData.size();
         basisCoefficients.resize(steps-1);
@@ -34,77 +104,101 @@ namespace QuantLib {
 
             std::vector<NodeData>& exerciseData = simulationData[i];
 
-            // 1) find the covariance matrix of basis function values and
-            //    deflated cash-flows
+            // 1) collect basis function values and deflated cash-flows
+            //    of the valid paths into the design matrix...
             Size N = exerciseData.front().values.size();
-            std::vector<Real> temp(N+1);
-            SequenceStatistics stats(N+1);
-
-            Size j;
-            for (j=0; j<exerciseData.size(); ++j) {
-                if (exerciseData[j].isValid) {
-                    std::copy(exerciseData[j].values.begin(),
-                              exerciseData[j].values.end(),
-                              temp.begin());
-                    temp.back() = exerciseData[j].cumulatedCashFlows
-                                - exerciseData[j].controlValue;
-
-                    stats.add(temp);
+            Size n = 0, j, k, l, r;
+            for (j=0; j<exerciseData.size(); ++j)
+                if (exerciseData[j].isValid)
+                    ++n;
+            QL_REQUIRE(n > 1,
+                       "not enough valid paths (" << n << ") at exercise "
+                       << i-1 << " for the regression");
+
+            workspace.reset(n, N);
+            std::vector<Size>& paths = workspace.paths_;
+            std::vector<Real>& estimates = workspace.estimates_;
+            for (j=0, r=0; j<exerciseData.size(); ++j) {
+                const NodeData& data = exerciseData[j];
+                if (data.isValid) {
+                    paths[r] = j;
+                    for (k=0; k<N; ++k)
+                        workspace.column(k)[r] = data.values[k];
+                    workspace.column(N)[r] =
+                        data.cumulatedCashFlows - data.controlValue;
+                    estimates[r] = data.controlValue;
+                    ++r;
                 }
             }
 
-            std::vector<Real> means = stats.mean();
-            Matrix covariance = stats.covariance();
+            // ...and find their covariance matrix
+            Array& means = workspace.means_;
+            for (k=0; k<=N; ++k) {
+                const Real* x = workspace.column(k);
+                means[k] = std::accumulate(x, x+n, 0.0)/n;
+            }
 
-            Matrix C(N,N);
-            Array target(N);
-            for (Size k=0; k<N; ++k) {
-                target[k] = covariance[k][N] + means[k]*means[N];
-                for (Size l=0; l<=k; ++l)
-                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
+            Matrix& C = workspace.normalMatrix_;
+            Array& target = workspace.target_;
+            const Real* y = workspace.column(N);
+            for (k=0; k<N; ++k) {
+                const Real* xk = workspace.column(k);
+                Real sum = 0.0;
+                for (r=0; r<n; ++r)
+                    sum += (xk[r]-means[k])*(y[r]-means[N]);
+                target[k] = sum/(n-1) + means[k]*means[N];
+                for (l=0; l<=k; ++l) {
+                    const Real* xl = workspace.column(l);
+                    sum = 0.0;
+                    for (r=0; r<n; ++r)
+                        sum += (xk[r]-means[k])*(xl[r]-means[l]);
+                    C[k][l] = C[l][k] = sum/(n-1) + means[k]*means[l];
+                }
             }
 
             // 2) solve for least squares regression
-            Array alphas = SVD(C).solveFor(target);
+            Array& alphas = workspace.alphas_;
+            if (!workspace.solve())
+                alphas = SVD(C).solveFor(target);
             basisCoefficients[i-1].resize(N);
             std::copy(alphas.begin(), alphas.end(),
                       basisCoefficients[i-1].begin());
 
             // 3) use exercise strategy to divide paths into exercise and
             //    non-exercise domains
-            for (j=0; j<exerciseData.size(); ++j) {
-                if (exerciseData[j].isValid) {
-                    Real exerciseValue = exerciseData[j].exerciseValue;
-                    Real continuationValue =
-                        exerciseData[j].cumulatedCashFlows;
-                    Real estimatedContinuationValue =
-                        std::inner_product(
-                                 exerciseData[j].values.begin(),
-                                 exerciseData[j].values.end(),
-                                 alphas.begin(),
-                                 exerciseData[j].controlValue);
-
-                    // for exercise paths, add deflated rebate to
-                    // deflated cash-flows at previous time frame;
-                    // for non-exercise paths, add deflated cash-flows to
-                    // deflated cash-flows at previous time frame
-                    Real value = estimatedContinuationValue <= exerciseValue ?
-                                 exerciseValue :
-                                 continuationValue;
-
-                    simulationData[i-1][j].cumulatedCashFlows += value;
-                }
+            for (k=0; k<N; ++k) {
+                const Real* x = workspace.column(k);
+                const Real alpha = alphas[k];
+                for (r=0; r<n; ++r)
+                    estimates[r] += x[r]*alpha;
+            }
+
+            for (r=0; r<n; ++r) {
+                j = paths[r];
+                Real exerciseValue = exerciseData[j].exerciseValue;
+                Real continuationValue = exerciseData[j].cumulatedCashFlows;
+                Real estimatedContinuationValue = estimates[r];
+
+                // for exercise paths, add deflated rebate to
+                // deflated cash-flows at previous time frame;
+                // for non-exercise paths, add deflated cash-flows to
+                // deflated cash-flows at previous time frame
+                Real value = estimatedContinuationValue <= exerciseValue ?
+                             exerciseValue :
+                             continuationValue;
+
+                simulationData[i-1][j].cumulatedCashFlows += value;
             }
         }
 
         // the value of the product can now be estimated by averaging
         // over all paths
-        Statistics estimate;
-        std::vector<NodeData>& estimatedData = simulationData[0];
+        const std::vector<NodeData>& estimatedData = simulationData[0];
+        Real sum = 0.0;
         for (Size j=0; j<estimatedData.size(); ++j)
-            estimate.add(estimatedData[j].cumulatedCashFlows);
+            sum += estimatedData[j].cumulatedCashFlows;
 
-        return estimate.mean();
+        return sum/estimatedData.size();
     }
 
 }
@@ -2,6 +2,7 @@
 
 /*
  Copyright (C) 2006 Mark Joshi
+ Copyright (C) 2013 StatPro Italia srl
 
  This file is part of QuantLib, a free-software/open-source library
  for financial quantitative analysts and developers - http://quantlib.org/
@@ -22,9 +23,12 @@
 #define quantlib_generic_longstaff_schwartz_hpp
 
 #include <ql/methods/montecarlo/nodedata.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
+    class GenericLSRegressionWorkspace;
+
     //! returns the biased estimate obtained while regressing
     /* TODO document:
        n exercises, n+1 elements in simulationData
@@ -39,6 +43,48 @@ namespace QuantLib {
         std::vector<std::vector<NodeData> >& simulationData,
         std::vector<std::vector<Real> >& basisCoefficients);
 
+    //! same as above, using the given workspace
+    /*! No memory is allocated for the path data once the workspace
+        has been used for a regression of the same size; this is
+        useful when the regression is performed repeatedly.
+    */
+    Real genericLongstaffSchwartzRegression(
+        std::vector<std::vector<NodeData> >& simulationData,
+        std::vector<std::vector<Real> >& basisCoefficients,
+        GenericLSRegressionWorkspace& workspace);
+
+
+    //! storage for genericLongstaffSchwartzRegression
+    /*! The workspace holds the design matrix of the regression at a
+        given exercise time, stored by columns (one column for each
+        basis function, plus one for the deflated cash flows) so that
+        each of its entries is filled in a single pass over the paths
+        and the normal equations are obtained by inner products of
+        contiguous columns.  The equations are solved in place by a
+        Cholesky decomposition, unless the basis functions are
+        degenerate on the valid paths; in that case, the minimum-norm
+        solution is obtained by singular value decomposition.  The
+        storage is kept between regressions and only grows when
+        needed.
+    */
+    class GenericLSRegressionWorkspace {
+      public:
+        GenericLSRegressionWorkspace() : rows_(0), basisSize_(0) {}
+      private:
+        friend Real genericLongstaffSchwartzRegression(
+                            std::vector<std::vector<NodeData> >&,
+                            std::vector<std::vector<Real> >&,
+                            GenericLSRegressionWorkspace&);
+        void reset(Size rows, Size basisSize);
+        bool solve();
+        Real* column(Size k) { return &design_[k*rows_]; }
+        Size rows_, basisSize_;
+        std::vector<Real> design_, estimates_;
+        std::vector<Size> paths_;
+        Matrix normalMatrix_, factor_;
+        Array target_, means_, alphas_;
+    };
+
 }
 
 
@@ -2,6 +2,7 @@
 
 /*
  Copyright (C) 2006 Klaus Spanderen
+ Copyright (C) 2013 StatPro Italia srl
 
  This file is part of QuantLib, a free-software/open-source library
  for financial quantitative analysts and developers - http://quantlib.org/
@@ -26,11 +27,13 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
-#include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -41,6 +44,21 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        The calibration paths are stored during the calibration
+        phase and released by calibrate(); the backward induction
+        needs the state of each path at every exercise date, so
+        their memory grows with the number of calibration samples.
+        What is bounded is the regression at each exercise date: the
+        in-the-money observations are fed to an incremental QR
+        decomposition rather than collected into a design matrix,
+        which takes \f$ O(m^2) \f$ memory per block of paths for
+        \f$ m \f$ basis functions.  The paths are processed in
+        blocks of fixed size, each block being regressed separately
+        and the partial results being merged in block order; if more
+        than one worker is given, the blocks are processed in
+        parallel (when OpenMP is enabled) and the results don't
+        depend on the number of workers.
+
         \ingroup mcarlo
 
         \test the correctness of the returned value is tested by
@@ -54,10 +72,17 @@ namespace QuantLib {
         LongstaffSchwartzPathPricer(
             const TimeGrid& times,
             const boost::shared_ptr<EarlyExercisePathPricer<PathType> >& ,
-            const boost::shared_ptr<YieldTermStructure>& termStructure);
+            const boost::shared_ptr<YieldTermStructure>& termStructure,
+            Size workers = 1);
 
         Real operator()(const PathType& path) const;
         virtual void calibrate();
+        //! moves the calibration paths collected by another pricer
+        /*! The paths are appended to the ones already collected and
+            removed from the other pricer.  This allows the calibration
+            paths to be generated by several pricers in parallel.
+        */
+        void addCalibrationPaths(LongstaffSchwartzPathPricer& other);
 
       protected:
         bool  calibrationPhase_;
@@ -69,6 +94,7 @@ namespace QuantLib {
 
         mutable std::vector<PathType> paths_;
         const   std::vector<boost::function1<Real, StateType> > v_;
+        const Size workers_;
     };
 
     template <class PathType> inline
@@ -76,12 +102,15 @@ namespace QuantLib {
         const TimeGrid& times,
         const boost::shared_ptr<EarlyExercisePathPricer<PathType> >&
             pathPricer,
-        const boost::shared_ptr<YieldTermStructure>& termStructure)
+        const boost::shared_ptr<YieldTermStructure>& termStructure,
+        Size workers)
     : calibrationPhase_(true),
       pathPricer_(pathPricer),
       coeff_     (new Array[times.size()-1]),
       dF_        (new DiscountFactor[times.size()-1]),
-      v_         (pathPricer_->basisSystem()) {
+      v_         (pathPricer_->basisSystem()),
+      workers_   (workers) {
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -122,53 +151,120 @@ namespace QuantLib {
         return price*dF_[0];
     }
 
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::addCalibrationPaths(
+                                        LongstaffSchwartzPathPricer& other) {
+        QL_REQUIRE(calibrationPhase_ && other.calibrationPhase_,
+                   "pricers already calibrated");
+        if (paths_.empty()) {
+            paths_.swap(other.paths_);
+        } else {
+            paths_.insert(paths_.end(),
+                          other.paths_.begin(), other.paths_.end());
+        }
+        std::vector<PathType> empty;
+        other.paths_.swap(empty);
+    }
+
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
         const Size n = paths_.size();
-        Array prices(n), exercise(n);
+        QL_REQUIRE(n > 0, "no calibration paths");
+        const Size m = v_.size();
         const Size len = EarlyExerciseTraits<PathType>::pathLength(paths_[0]);
 
-        for (Size i=0; i<n; ++i)
-            prices[i] = (*pathPricer_)(paths_[i], len-1);
+        // the block size is fixed so that the regression results
+        // don't depend on the number of workers
+        const Size blockSize = 1024;
+        const Size nBlocks = (n + blockSize - 1)/blockSize;
 
-        std::vector<Real>      y;
-        std::vector<StateType> x;
-        for (Size i=len-2; i>0; --i) {
-            y.clear();
-            x.clear();
+        Array prices(n), exercise(n);
+        for (Size j=0; j<n; ++j)
+            prices[j] = (*pathPricer_)(paths_[j], len-1);
 
-            //roll back step
-            for (Size j=0; j<n; ++j) {
-                exercise[j]=(*pathPricer_)(paths_[j], i);
+        std::vector<IncrementalLinearLeastSquares> regressions(
+                                nBlocks, IncrementalLinearLeastSquares(m));
+        std::vector<Array> basis(nBlocks, Array(m));
+        std::vector<std::string> errors(nBlocks);
 
-                if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
-                    y.push_back(dF_[i]*prices[j]);
+        for (Size i=len-2; i>0; --i) {
+            const DiscountFactor dF = dF_[i];
+
+            // regress the discounted prices of in-the-money paths
+            #if defined(_OPENMP)
+            #pragma omp parallel for schedule(static) \
+                if(workers_ > 1) num_threads(static_cast<int>(workers_))
+            #endif
+            for (long b=0; b<static_cast<long>(nBlocks); ++b) {
+                IncrementalLinearLeastSquares& regression = regressions[b];
+                Array& v = basis[b];
+                try {
+                    regression.reset();
+                    const Size begin = static_cast<Size>(b)*blockSize;
+                    const Size end = std::min(begin+blockSize, n);
+                    for (Size j=begin; j<end; ++j) {
+                        exercise[j] = (*pathPricer_)(paths_[j], i);
+                        if (exercise[j] > 0.0) {
+                            const StateType x =
+                                pathPricer_->state(paths_[j], i);
+                            for (Size l=0; l<m; ++l)
+                                v[l] = v_[l](x);
+                            regression.add(v.begin(), dF*prices[j]);
+                        }
+                    }
+                } catch (std::exception& e) {
+                    errors[b] = e.what();
+                } catch (...) {
+                    errors[b] = "unknown error";
                 }
             }
+            for (Size b=0; b<nBlocks; ++b)
+                QL_REQUIRE(errors[b].empty(),
+                           "block " << b << " failed: " << errors[b]);
+
+            for (Size b=1; b<nBlocks; ++b)
+                regressions[0].merge(regressions[b]);
 
-            if (v_.size() <=  x.size()) {
-                coeff_[i] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            if (m <= regressions[0].size()) {
+                coeff_[i] = regressions[0].coefficients();
             }
             else {
             // if number of itm paths is smaller then the number of
             // calibration functions then early exercise if exerciseValue > 0
-                coeff_[i] = Array(v_.size(), 0.0);
+                coeff_[i] = Array(m, 0.0);
             }
 
-            for (Size j=0, k=0; j<n; ++j) {
-                prices[j]*=dF_[i];
-                if (exercise[j]>0.0) {
-                    Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i][l] * v_[l](x[k]);
-                    }
-                    if (continuationValue < exercise[j]) {
-                        prices[j] = exercise[j];
+            // roll back step
+            const Array& c = coeff_[i];
+            #if defined(_OPENMP)
+            #pragma omp parallel for schedule(static) \
+                if(workers_ > 1) num_threads(static_cast<int>(workers_))
+            #endif
+            for (long b=0; b<static_cast<long>(nBlocks); ++b) {
+                try {
+                    const Size begin = static_cast<Size>(b)*blockSize;
+                    const Size end = std::min(begin+blockSize, n);
+                    for (Size j=begin; j<end; ++j) {
+                        prices[j]*=dF;
+                        if (exercise[j] > 0.0) {
+                            const StateType x =
+                                pathPricer_->state(paths_[j], i);
+                            Real continuationValue = 0.0;
+                            for (Size l=0; l<m; ++l)
+                                continuationValue += c[l] * v_[l](x);
+                            if (continuationValue < exercise[j])
+                                prices[j] = exercise[j];
+                        }
                     }
-                    ++k;
+                } catch (std::exception& e) {
+                    errors[b] = e.what();
+                } catch (...) {
+                    errors[b] = "unknown error";
                 }
             }
+            for (Size b=0; b<nBlocks; ++b)
+                QL_REQUIRE(errors[b].empty(),
+                           "block " << b << " failed: " << errors[b]);
         }
 
         // remove calibration paths and release memory
@@ -26,8 +26,13 @@
 #define quantlib_montecarlo_model_hpp
 
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/multipathblock.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <vector>
+#include <string>
 
 namespace QuantLib {
 
@@ -45,6 +50,31 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        Optionally, the model can be given a set of worker path
+        pricers.  In this case, the samples requested by addSamples()
+        are split in contiguous slices among the workers, which can
+        run in parallel when the library is compiled with OpenMP
+        support.  Each worker uses a copy of the path generator,
+        skipped ahead to the beginning of its slice, and collects its
+        samples in a separate accumulator; the partial results are
+        then merged into the model accumulator in worker order.  As a
+        consequence, the samples are the same that would be drawn by a
+        serial run; with an accumulator storing the samples, such as
+        Statistics, the results are identical to the serial ones.
+        This requires the statistics class to provide a merge()
+        method.  The workers are only used if the path generator can
+        skip ahead efficiently (see has_fast_skip); otherwise, the
+        skips would cost as much as a serial run, and the samples
+        are drawn serially instead.
+
+        When the path generator can draw paths in blocks (see
+        has_block_generation) and the path pricer (and the
+        control-variate pricer, if any) provides batch pricing (see
+        has_batch_pricing and PathPricer::providesBatch), paths are
+        generated and priced in blocks; the samples and their order
+        are the same as in the path-by-path simulation, which is
+        used otherwise.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,20 +97,76 @@ namespace QuantLib {
                         = boost::shared_ptr<path_pricer_type>(),
                   result_type cvOptionValue = result_type(),
                   const boost::shared_ptr<path_generator_type>& cvPathGenerator
-                        = boost::shared_ptr<path_generator_type>())
+                        = boost::shared_ptr<path_generator_type>(),
+                  const std::vector<boost::shared_ptr<path_pricer_type> >&
+                      workerPathPricers =
+                        std::vector<boost::shared_ptr<path_pricer_type> >(),
+                  const std::vector<boost::shared_ptr<path_pricer_type> >&
+                      workerCvPathPricers =
+                        std::vector<boost::shared_ptr<path_pricer_type> >())
         : pathGenerator_(pathGenerator), pathPricer_(pathPricer),
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
+          cvPathGenerator_(cvPathGenerator),
+          workerPathPricers_(workerPathPricers),
+          workerCvPathPricers_(workerCvPathPricers) {
             if (!cvPathPricer_)
                 isControlVariate_ = false;
             else
                 isControlVariate_ = true;
+            if (!workerPathPricers_.empty()) {
+                QL_REQUIRE(!cvPathGenerator_,
+                           "separate control-variate path generator "
+                           "not supported with multiple workers");
+                if (isControlVariate_) {
+                    QL_REQUIRE(workerCvPathPricers_.size() ==
+                               workerPathPricers_.size(),
+                               "mismatch between number of worker path "
+                               "pricers (" << workerPathPricers_.size()
+                               << ") and control-variate path pricers ("
+                               << workerCvPathPricers_.size() << ")");
+                }
+            }
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        //! number of workers the samples are split among
+        Size workers() const;
       private:
+        typedef std::pair<result_type,Real> weighted_sample;
+        weighted_sample nextSample(path_generator_type& pathGenerator,
+                                   const path_pricer_type& pathPricer,
+                                   const path_pricer_type* cvPathPricer,
+                                   path_generator_type* cvPathGenerator) const;
+        void accumulate(path_generator_type& pathGenerator,
+                        const path_pricer_type& pathPricer,
+                        const path_pricer_type* cvPathPricer,
+                        path_generator_type* cvPathGenerator,
+                        Size samples,
+                        stats_type& accumulator) const;
+        void accumulate(path_generator_type& pathGenerator,
+                        const path_pricer_type& pathPricer,
+                        const path_pricer_type* cvPathPricer,
+                        path_generator_type* cvPathGenerator,
+                        Size samples,
+                        stats_type& accumulator,
+                        const boost::true_type&) const;
+        void accumulate(path_generator_type& pathGenerator,
+                        const path_pricer_type& pathPricer,
+                        const path_pricer_type* cvPathPricer,
+                        path_generator_type* cvPathGenerator,
+                        Size samples,
+                        stats_type& accumulator,
+                        const boost::false_type&) const;
+        void accumulateBatches(path_generator_type& pathGenerator,
+                               const path_pricer_type& pathPricer,
+                               const path_pricer_type* cvPathPricer,
+                               path_generator_type* cvPathGenerator,
+                               Size samples,
+                               stats_type& accumulator) const;
+        void addSamplesInParallel(Size samples, const boost::true_type&);
+        void addSamplesInParallel(Size samples, const boost::false_type&);
         boost::shared_ptr<path_generator_type> pathGenerator_;
         boost::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -89,43 +175,235 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         boost::shared_ptr<path_generator_type> cvPathGenerator_;
+        std::vector<boost::shared_ptr<path_pricer_type> > workerPathPricers_;
+        std::vector<boost::shared_ptr<path_pricer_type> > workerCvPathPricers_;
     };
 
     // inline definitions
+    template <template <class> class MC, class RNG, class S>
+    inline typename MonteCarloModel<MC,RNG,S>::weighted_sample
+    MonteCarloModel<MC,RNG,S>::nextSample(
+                                      path_generator_type& pathGenerator,
+                                      const path_pricer_type& pathPricer,
+                                      const path_pricer_type* cvPathPricer,
+                                path_generator_type* cvPathGenerator) const {
+        sample_type path = pathGenerator.next();
+        result_type price = pathPricer(path.value);
+
+        if (cvPathPricer) {
+            if (!cvPathGenerator) {
+                price += cvOptionValue_-(*cvPathPricer)(path.value);
+            }
+            else {
+                sample_type cvPath = cvPathGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer)(cvPath.value);
+            }
+        }
+
+        if (isAntitheticVariate_) {
+            path = pathGenerator.antithetic();
+            result_type price2 = pathPricer(path.value);
+            if (cvPathPricer) {
+                if (!cvPathGenerator)
+                    price2 += cvOptionValue_-(*cvPathPricer)(path.value);
+                else {
+                    sample_type cvPath = cvPathGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer)(cvPath.value);
+                }
+            }
+
+            return weighted_sample((price+price2)/2.0, path.weight);
+        } else {
+            return weighted_sample(price, path.weight);
+        }
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        if (!workerPathPricers_.empty()) {
+            addSamplesInParallel(samples,
+                                 has_fast_skip<path_generator_type>());
+            return;
+        }
+
+        const path_pricer_type* cvPathPricer =
+            isControlVariate_ ? cvPathPricer_.get() : 0;
+        accumulate(*pathGenerator_, *pathPricer_,
+                   cvPathPricer, cvPathGenerator_.get(),
+                   samples, sampleAccumulator_);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::accumulate(
+                                      path_generator_type& pathGenerator,
+                                      const path_pricer_type& pathPricer,
+                                      const path_pricer_type* cvPathPricer,
+                                      path_generator_type* cvPathGenerator,
+                                      Size samples,
+                                      stats_type& accumulator) const {
+        typedef boost::integral_constant<bool,
+            has_block_generation<path_generator_type>::value &&
+            has_batch_pricing<path_pricer_type>::value> batch_support;
+        accumulate(pathGenerator, pathPricer, cvPathPricer, cvPathGenerator,
+                   samples, accumulator, batch_support());
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::accumulate(
+                                      path_generator_type& pathGenerator,
+                                      const path_pricer_type& pathPricer,
+                                      const path_pricer_type* cvPathPricer,
+                                      path_generator_type* cvPathGenerator,
+                                      Size samples,
+                                      stats_type& accumulator,
+                                      const boost::true_type&) const {
+        if (pathPricer.providesBatch() &&
+            (!cvPathPricer || cvPathPricer->providesBatch()))
+            accumulateBatches(pathGenerator, pathPricer,
+                              cvPathPricer, cvPathGenerator,
+                              samples, accumulator);
+        else
+            accumulate(pathGenerator, pathPricer,
+                       cvPathPricer, cvPathGenerator,
+                       samples, accumulator, boost::false_type());
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::accumulate(
+                                      path_generator_type& pathGenerator,
+                                      const path_pricer_type& pathPricer,
+                                      const path_pricer_type* cvPathPricer,
+                                      path_generator_type* cvPathGenerator,
+                                      Size samples,
+                                      stats_type& accumulator,
+                                      const boost::false_type&) const {
         for(Size j = 1; j <= samples; j++) {
+            weighted_sample sample =
+                nextSample(pathGenerator, pathPricer,
+                           cvPathPricer, cvPathGenerator);
+            accumulator.add(sample.first, sample.second);
+        }
+    }
 
-            sample_type path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+    template <template <class> class MC, class RNG, class S>
+    void MonteCarloModel<MC,RNG,S>::accumulateBatches(
+                                      path_generator_type& pathGenerator,
+                                      const path_pricer_type& pathPricer,
+                                      const path_pricer_type* cvPathPricer,
+                                      path_generator_type* cvPathGenerator,
+                                      Size samples,
+                                      stats_type& accumulator) const {
+        // the blocks are allocated once and reused for all batches
+        const Size batchSize = 1024;
+        MultiPathBlock paths, cvPaths;
+        std::vector<result_type> prices, antitheticPrices, cvPrices;
 
-            if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
-                else {
-                    sample_type cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+        for (Size done = 0; done < samples; ) {
+            const Size n = std::min(batchSize, samples-done);
+            prices.resize(n);
+
+            pathGenerator.nextBlock(n, paths);
+            pathPricer.priceBatch(paths, prices);
+            if (cvPathPricer) {
+                cvPrices.resize(n);
+                if (!cvPathGenerator) {
+                    cvPathPricer->priceBatch(paths, cvPrices);
+                } else {
+                    cvPathGenerator->nextBlock(n, cvPaths);
+                    cvPathPricer->priceBatch(cvPaths, cvPrices);
                 }
+                for (Size k=0; k<n; ++k)
+                    prices[k] += cvOptionValue_-cvPrices[k];
             }
 
             if (isAntitheticVariate_) {
-                path = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(path.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
-                    else {
-                        sample_type cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                antitheticPrices.resize(n);
+                pathGenerator.antitheticBlock(paths);
+                pathPricer.priceBatch(paths, antitheticPrices);
+                if (cvPathPricer) {
+                    if (!cvPathGenerator) {
+                        cvPathPricer->priceBatch(paths, cvPrices);
+                    } else {
+                        cvPathGenerator->antitheticBlock(cvPaths);
+                        cvPathPricer->priceBatch(cvPaths, cvPrices);
                     }
+                    for (Size k=0; k<n; ++k)
+                        antitheticPrices[k] += cvOptionValue_-cvPrices[k];
                 }
+                for (Size k=0; k<n; ++k)
+                    prices[k] = (prices[k]+antitheticPrices[k])/2.0;
+            }
+
+            for (Size k=0; k<n; ++k)
+                accumulator.add(prices[k], paths.weight(k));
+            done += n;
+        }
+    }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesInParallel(
+                                                Size samples,
+                                                const boost::false_type&) {
+        // the workers would have to generate the paths they skip;
+        // a serial run draws the same samples at a fraction of the cost
+        const path_pricer_type* cvPathPricer =
+            isControlVariate_ ? cvPathPricer_.get() : 0;
+        accumulate(*pathGenerator_, *pathPricer_,
+                   cvPathPricer, 0, samples, sampleAccumulator_);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesInParallel(
+                                                Size samples,
+                                                const boost::true_type&) {
+        // Worker k draws the k-th contiguous slice of the paths that
+        // a serial run would draw; the partial results are merged in
+        // worker order.  This makes the results independent of the
+        // number of threads and of scheduling.
+        const Size n = workerPathPricers_.size();
+        std::vector<boost::shared_ptr<path_generator_type> > generators(n);
+        for (Size k=0, offset=0; k<n; ++k) {
+            generators[k] = boost::shared_ptr<path_generator_type>(
+                                     new path_generator_type(*pathGenerator_));
+            generators[k]->skip(offset);
+            offset += samples/n + (k < samples%n ? 1 : 0);
+        }
+        pathGenerator_->skip(samples);
+
+        // The generators share the underlying process, whose lazy
+        // state (e.g., the local volatility of a Black-Scholes
+        // process, or the curves it depends on) is set up when a path
+        // is first evolved.  This must not happen concurrently; a
+        // throw-away path is drawn beforehand to do it serially.
+        path_generator_type(*pathGenerator_).next();
+
+        std::vector<stats_type> results(n);
+        std::vector<std::string> errors(n);
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(static,1)
+        #endif
+        for (long i=0; i<static_cast<long>(n); ++i) {
+            const Size k = static_cast<Size>(i);
+            const Size m = samples/n + (k < samples%n ? 1 : 0);
+            const path_pricer_type* cvPathPricer =
+                isControlVariate_ ? workerCvPathPricers_[k].get() : 0;
+            try {
+                accumulate(*generators[k], *workerPathPricers_[k],
+                           cvPathPricer, 0, m, results[k]);
+            } catch (std::exception& e) {
+                errors[k] = e.what();
+            } catch (...) {
+                errors[k] = "unknown error";
             }
         }
+
+        for (Size k=0; k<n; ++k)
+            QL_REQUIRE(errors[k].empty(),
+                       "worker " << k << " failed: " << errors[k]);
+
+        for (Size k=0; k<n; ++k)
+            sampleAccumulator_.merge(results[k]);
     }
 
     template <template <class> class MC, class RNG, class S>
@@ -134,6 +412,11 @@ namespace QuantLib {
         return sampleAccumulator_;
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline Size MonteCarloModel<MC,RNG,S>::workers() const {
+        return std::max<Size>(workerPathPricers_.size(), 1);
+    }
+
 }
 
 
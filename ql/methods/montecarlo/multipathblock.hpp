@@ -0,0 +1,144 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathblock.hpp
+    \brief Block of correlated multiple asset paths
+*/
+
+#ifndef quantlib_montecarlo_multi_path_block_hpp
+#define quantlib_montecarlo_multi_path_block_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Block of correlated multiple asset paths
+    /*! MultiPathBlock stores a number of multi-asset paths in a
+        single contiguous buffer, laid out as assets \f$ \times \f$
+        times \f$ \times \f$ paths. That is, the values of a given
+        asset at a given time are contiguous across the paths of the
+        block, which is the layout needed by pricers working on many
+        paths at once.
+
+        The buffer is allocated once; resizing the block to a smaller
+        or equal number of paths reuses the existing storage, so that
+        the same block can be passed to a generator batch after batch
+        without further allocations.
+
+        \ingroup mcarlo
+    */
+    class MultiPathBlock {
+      public:
+        MultiPathBlock() : nAsset_(0), nPaths_(0) {}
+        MultiPathBlock(Size nAsset,
+                       const TimeGrid& timeGrid,
+                       Size nPaths = 0);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return nAsset_; }
+        Size pathSize() const { return timeGrid_.size(); }
+        Size pathNumber() const { return nPaths_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+        //! \name read/write access to components
+        //@{
+        /*! returns the values of the \f$ j \f$-th asset at the
+            \f$ i \f$-th time for all the paths in the block.
+        */
+        const Real* operator()(Size j, Size i) const;
+        Real* operator()(Size j, Size i);
+        //! value of the \f$ j \f$-th asset at the \f$ i \f$-th time
+        Real operator()(Size j, Size i, Size path) const;
+        Real& operator()(Size j, Size i, Size path);
+        Real weight(Size path) const { return weights_[path]; }
+        Real& weight(Size path) { return weights_[path]; }
+        //! copies the given path into a multi-path
+        /*! No allocation takes place if the multi-path already has
+            the correct dimensions.
+        */
+        void copyPath(Size path, MultiPath& multiPath) const;
+        //@}
+        //! \name modifiers
+        //@{
+        //! changes the number of paths, keeping the storage if possible
+        void resize(Size nPaths);
+        //@}
+      private:
+        Size nAsset_, nPaths_;
+        TimeGrid timeGrid_;
+        std::vector<Real> values_, weights_;
+    };
+
+
+    // inline definitions
+
+    inline MultiPathBlock::MultiPathBlock(Size nAsset,
+                                          const TimeGrid& timeGrid,
+                                          Size nPaths)
+    : nAsset_(nAsset), nPaths_(0), timeGrid_(timeGrid) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+        resize(nPaths);
+    }
+
+    inline const Real* MultiPathBlock::operator()(Size j, Size i) const {
+        return &values_[(j*timeGrid_.size()+i)*nPaths_];
+    }
+
+    inline Real* MultiPathBlock::operator()(Size j, Size i) {
+        return &values_[(j*timeGrid_.size()+i)*nPaths_];
+    }
+
+    inline Real MultiPathBlock::operator()(Size j, Size i,
+                                           Size path) const {
+        return values_[(j*timeGrid_.size()+i)*nPaths_+path];
+    }
+
+    inline Real& MultiPathBlock::operator()(Size j, Size i, Size path) {
+        return values_[(j*timeGrid_.size()+i)*nPaths_+path];
+    }
+
+    inline void MultiPathBlock::copyPath(Size path,
+                                         MultiPath& multiPath) const {
+        QL_REQUIRE(path < nPaths_,
+                   "path " << path << " out of range [0, "
+                   << nPaths_ << ")");
+        if (multiPath.assetNumber() != nAsset_ ||
+            multiPath[0].length() != timeGrid_.size())
+            multiPath = MultiPath(nAsset_, timeGrid_);
+        const Size n = timeGrid_.size();
+        for (Size j=0; j<nAsset_; ++j) {
+            Path& p = multiPath[j];
+            const Real* v = &values_[j*n*nPaths_+path];
+            for (Size i=0; i<n; ++i, v+=nPaths_)
+                p[i] = *v;
+        }
+    }
+
+    inline void MultiPathBlock::resize(Size nPaths) {
+        // std::vector never gives back capacity on shrinking
+        values_.resize(nAsset_*timeGrid_.size()*nPaths);
+        weights_.resize(nPaths, 1.0);
+        nPaths_ = nPaths;
+    }
+
+}
+
+
+#endif
@@ -28,6 +28,8 @@
 #define quantlib_multi_path_generator_hpp
 
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/multipathblock.hpp>
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/stochasticprocess.hpp>
 
@@ -44,7 +46,10 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
-        \test the generated paths are checked against cached results
+        \test
+        - the generated paths are checked against cached results.
+        - the paths generated in blocks are checked against the ones
+          generated one at a time.
     */
     template <class GSG>
     class MultiPathGenerator {
@@ -56,14 +61,44 @@ namespace QuantLib {
                            bool brownianBridge = false);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! generates the next \f$ n \f$ paths into the given block
+        /*! The paths are the same that would be returned by
+            \f$ n \f$ successive calls to next(); the block is
+            resized to hold them and its storage is reused if
+            possible. A default-constructed block is initialized
+            with the dimensions of the generated paths.
+
+            The random numbers for the whole block are drawn at once
+            and the process is evolved one time step at a time across
+            all the paths in the block.
+
+            \pre GSG must provide a
+                 <tt>nextBlock(Size, Real*, Real*)</tt> method
+        */
+        void nextBlock(Size n, MultiPathBlock& block) const;
+        //! antithetic paths of the last generated block
+        void antitheticBlock(MultiPathBlock& block) const;
+        //! skip the next \f$ n \f$ paths
+        /*! \pre GSG must provide a <tt>skip(BigNatural)</tt> method */
+        void skip(BigNatural n) { generator_.skip(n); }
       private:
         const sample_type& next(bool antithetic) const;
+        void evolve(MultiPathBlock& block, bool antithetic) const;
         bool brownianBridge_;
         boost::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        mutable std::vector<Real> randoms_, increments_;
+        mutable Size blockSize_;
     };
 
+    template <class GSG>
+    struct has_fast_skip<MultiPathGenerator<GSG> > : has_fast_skip<GSG> {};
+
+    template <class GSG>
+    struct has_block_generation<MultiPathGenerator<GSG> >
+        : has_block_generation<GSG> {};
+
 
     // template definitions
 
@@ -74,7 +109,8 @@ namespace QuantLib {
                    GSG generator,
                    bool brownianBridge)
     : brownianBridge_(brownianBridge), process_(process),
-      generator_(generator), next_(MultiPath(process->size(), times), 1.0) {
+      generator_(generator), next_(MultiPath(process->size(), times), 1.0),
+      blockSize_(0) {
 
         QL_REQUIRE(generator_.dimension() ==
                    process->factors()*(times.size()-1),
@@ -150,6 +186,73 @@ namespace QuantLib {
         }
     }
 
+    template <class GSG>
+    void MultiPathGenerator<GSG>::nextBlock(Size n,
+                                            MultiPathBlock& block) const {
+
+        QL_REQUIRE(!brownianBridge_, "Brownian bridge not supported");
+
+        const TimeGrid& timeGrid = next_.value[0].timeGrid();
+        if (block.assetNumber() == 0)
+            block = MultiPathBlock(process_->size(), timeGrid);
+        QL_REQUIRE(block.assetNumber() == process_->size() &&
+                   block.pathSize() == timeGrid.size(),
+                   "block dimensions (" << block.assetNumber() << " x "
+                   << block.pathSize() << ") do not match the paths ("
+                   << process_->size() << " x " << timeGrid.size() << ")");
+        block.resize(n);
+
+        randoms_.resize(n*generator_.dimension());
+        if (n > 0)
+            generator_.nextBlock(n, &randoms_[0], &block.weight(0));
+        blockSize_ = n;
+
+        evolve(block, false);
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::antitheticBlock(
+                                            MultiPathBlock& block) const {
+        QL_REQUIRE(block.pathNumber() == blockSize_,
+                   "block size (" << block.pathNumber()
+                   << ") does not match the last generated block ("
+                   << blockSize_ << ")");
+        evolve(block, true);
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::evolve(MultiPathBlock& block,
+                                         bool antithetic) const {
+
+        const Size m = process_->size();
+        const Size n = process_->factors();
+        const Size paths = block.pathNumber();
+        const Size dimension = generator_.dimension();
+        if (paths == 0)
+            return;
+
+        const Array asset = process_->initialValues();
+        for (Size j=0; j<m; j++)
+            std::fill(block(j,0), block(j,0)+paths, asset[j]);
+
+        // the increments of a single step, stored factor by factor
+        increments_.resize(n*paths);
+        const Real sign = antithetic ? -1.0 : 1.0;
+        const Size stride = block.pathSize()*paths;
+        const TimeGrid& timeGrid = block.timeGrid();
+        for (Size i = 1; i < block.pathSize(); i++) {
+            Size offset = (i-1)*n;
+            for (Size k = 0; k < paths; k++) {
+                const Real* dw = &randoms_[k*dimension+offset];
+                for (Size l = 0; l < n; l++)
+                    increments_[l*paths+k] = sign*dw[l];
+            }
+            process_->evolveBlock(timeGrid[i-1], timeGrid.dt(i-1), paths,
+                                  block(0,i-1), &increments_[0],
+                                  block(0,i), stride);
+        }
+    }
+
 }
 
 #endif
@@ -27,6 +27,8 @@
 #define quantlib_montecarlo_path_generator_hpp
 
 #include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/multipathblock.hpp>
+#include <ql/math/randomnumbers/generatortraits.hpp>
 #include <ql/stochasticprocess.hpp>
 
 namespace QuantLib {
@@ -38,7 +40,10 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
-        \test the generated paths are checked against cached results
+        \test
+        - the generated paths are checked against cached results.
+        - the paths generated in blocks are checked against the ones
+          generated one at a time.
     */
     template <class GSG>
     class PathGenerator {
@@ -61,8 +66,25 @@ namespace QuantLib {
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        //! generates the next \f$ n \f$ paths into the given block
+        /*! The paths are the same that would be returned by
+            \f$ n \f$ successive calls to next() and are stored as
+            the single asset of the block, which is resized to hold
+            them. A default-constructed block is initialized with the
+            dimensions of the generated paths.
+
+            \pre GSG must provide a
+                 <tt>nextBlock(Size, Real*, Real*)</tt> method
+        */
+        void nextBlock(Size n, MultiPathBlock& block) const;
+        //! antithetic paths of the last generated block
+        void antitheticBlock(MultiPathBlock& block) const;
+        //! skip the next \f$ n \f$ paths
+        /*! \pre GSG must provide a <tt>skip(BigNatural)</tt> method */
+        void skip(BigNatural n) { generator_.skip(n); }
       private:
         const sample_type& next(bool antithetic) const;
+        void evolve(MultiPathBlock& block, bool antithetic) const;
         bool brownianBridge_;
         GSG generator_;
         Size dimension_;
@@ -71,8 +93,17 @@ namespace QuantLib {
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
         BrownianBridge bb_;
+        mutable std::vector<Real> randoms_;
+        mutable Size blockSize_;
     };
 
+    template <class GSG>
+    struct has_fast_skip<PathGenerator<GSG> > : has_fast_skip<GSG> {};
+
+    template <class GSG>
+    struct has_block_generation<PathGenerator<GSG> >
+        : has_block_generation<GSG> {};
+
 
     // template definitions
 
@@ -86,7 +117,8 @@ namespace QuantLib {
     : brownianBridge_(brownianBridge), generator_(generator),
       dimension_(generator_.dimension()), timeGrid_(length, timeSteps),
       process_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)),
-      next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_) {
+      next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_),
+      blockSize_(0) {
         QL_REQUIRE(dimension_==timeSteps,
                    "sequence generator dimensionality (" << dimension_
                    << ") != timeSteps (" << timeSteps << ")");
@@ -101,7 +133,8 @@ namespace QuantLib {
     : brownianBridge_(brownianBridge), generator_(generator),
       dimension_(generator_.dimension()), timeGrid_(timeGrid),
       process_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)),
-      next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_) {
+      next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_),
+      blockSize_(0) {
         QL_REQUIRE(dimension_==timeGrid_.size()-1,
                    "sequence generator dimensionality (" << dimension_
                    << ") != timeSteps (" << timeGrid_.size()-1 << ")");
@@ -154,6 +187,66 @@ namespace QuantLib {
         return next_;
     }
 
+    template <class GSG>
+    void PathGenerator<GSG>::nextBlock(Size n, MultiPathBlock& block) const {
+
+        if (block.assetNumber() == 0)
+            block = MultiPathBlock(1, timeGrid_);
+        QL_REQUIRE(block.assetNumber() == 1 &&
+                   block.pathSize() == timeGrid_.size(),
+                   "block dimensions (" << block.assetNumber() << " x "
+                   << block.pathSize() << ") do not match the paths (1 x "
+                   << timeGrid_.size() << ")");
+        block.resize(n);
+
+        randoms_.resize(n*dimension_);
+        if (n > 0)
+            generator_.nextBlock(n, &randoms_[0], &block.weight(0));
+        if (brownianBridge_) {
+            // the bridge can't work in place, hence the copy
+            for (Size k=0; k<n; ++k) {
+                std::vector<Real>::iterator row =
+                    randoms_.begin()+k*dimension_;
+                bb_.transform(row, row+dimension_, temp_.begin());
+                std::copy(temp_.begin(), temp_.end(), row);
+            }
+        }
+        blockSize_ = n;
+
+        evolve(block, false);
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::antitheticBlock(MultiPathBlock& block) const {
+        QL_REQUIRE(block.pathNumber() == blockSize_,
+                   "block size (" << block.pathNumber()
+                   << ") does not match the last generated block ("
+                   << blockSize_ << ")");
+        evolve(block, true);
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::evolve(MultiPathBlock& block,
+                                    bool antithetic) const {
+
+        const Size paths = block.pathNumber();
+        if (paths == 0)
+            return;
+        std::fill(block(0,0), block(0,0)+paths, process_->x0());
+
+        for (Size i=1; i<block.pathSize(); i++) {
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            const Real* previous = block(0,i-1);
+            Real* current = block(0,i);
+            for (Size k=0; k<paths; k++) {
+                Real dw = randoms_[k*dimension_+i-1];
+                current[k] = process_->evolve(t, previous[k], dt,
+                                              antithetic ? -dw : dw);
+            }
+        }
+    }
+
 }
 
 
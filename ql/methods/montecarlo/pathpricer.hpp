@@ -27,13 +27,22 @@
 
 #include <ql/option.hpp>
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <boost/type_traits.hpp>
 #include <functional>
+#include <vector>
 
 namespace QuantLib {
 
+    class MultiPathBlock;
+
     //! base class for path pricers
     /*! Returns the value of an option on a given path.
 
+        Derived classes can also price a whole block of paths at once
+        by overriding priceBatch() and providesBatch(); Monte Carlo
+        models use the batch interface when it is available.
+
         \ingroup mcarlo
     */
     template<class PathType, class ValueType=Real>
@@ -41,8 +50,36 @@ namespace QuantLib {
       public:
         virtual ~PathPricer() {}
         virtual ValueType operator()(const PathType& path) const=0;
+        //! whether priceBatch() is implemented
+        virtual bool providesBatch() const { return false; }
+        //! values of the option on a block of paths
+        /*! The results must be the same that operator() would
+            return on each path. When PathType is Path, the block
+            holds a single asset.
+
+            \pre values has as many elements as there are paths
+                 in the block.
+        */
+        virtual void priceBatch(const MultiPathBlock& paths,
+                                std::vector<ValueType>& values) const {
+            QL_FAIL("batch pricing not implemented");
+        }
     };
 
+    //! whether a path pricer type declares the batch interface
+    /*! True for PathPricer, whose instances can still opt out at
+        run time through providesBatch().  Path pricer types defined
+        by custom Monte Carlo traits are only required to provide
+        operator(); they can specialize this class if they also
+        implement providesBatch() and priceBatch().
+    */
+    template <class P>
+    struct has_batch_pricing : boost::false_type {};
+
+    template <class PathType, class ValueType>
+    struct has_batch_pricing<PathPricer<PathType, ValueType> >
+        : boost::true_type {};
+
 }
 
 
@@ -89,6 +89,20 @@ namespace QuantLib {
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
       tree_(tree), dynamics_(dynamics) {}
 
+    void OneFactorModel::ShortRateTree::stepback(Size i,
+                                                 const Array& values,
+                                                 Array& newValues) const {
+        if (discounts_.empty())
+            discounts_.resize(timeGrid().size());
+        Array& discounts = discounts_[i];
+        if (discounts.empty()) {
+            Array(size(i)).swap(discounts);
+            for (Size j=0; j<discounts.size(); ++j)
+                discounts[j] = discount(i, j);
+        }
+        tree_->stepback(i, values, discounts, newValues);
+    }
+
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
 
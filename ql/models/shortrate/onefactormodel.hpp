@@ -103,9 +103,16 @@ namespace QuantLib {
         Real probability(Size i, Size index, Size branch) const {
             return tree_->probability(i, index, branch);
         }
+        /*! The discount factors of each level are computed the
+            first time the level is rolled back and reused
+            afterwards; the tree must therefore be fitted before any
+            asset is rolled back on it.
+        */
+        void stepback(Size i, const Array& values, Array& newValues) const;
       private:
         boost::shared_ptr<TrinomialTree> tree_;
         boost::shared_ptr<ShortRateDynamics> dynamics_;
+        mutable std::vector<Array> discounts_;
         class Helper;
     };
 
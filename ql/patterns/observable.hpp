@@ -4,6 +4,7 @@
  Copyright (C) 2000, 2001, 2002, 2003 RiskMap srl
  Copyright (C) 2003, 2004, 2005, 2006 StatPro Italia srl
  Copyright (C) 2011, 2012 Ferdinando Ametrano
+ Copyright (C) 2013 StatPro Italia srl
 
  This file is part of QuantLib, a free-software/open-source library
  for financial quantitative analysts and developers - http://quantlib.org/
@@ -28,17 +29,30 @@
 
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
+#include <ql/patterns/singleton.hpp>
 
 #include <boost/shared_ptr.hpp>
 
 #include <set>
+#include <vector>
+#include <algorithm>
+#include <iterator>
 
 namespace QuantLib {
 
     class Observer;
 
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! The observers are kept in a vector sorted by address, which
+        is cheaper to walk than a node-based set.  Since insertion and
+        removal in the vector take linear time, the observers are
+        moved to a set when their number grows past a few dozen (as
+        for the evaluation date) and back to the vector when it
+        shrinks again.  Either way, they are notified in address
+        order.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
       public:
@@ -52,10 +66,14 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        typedef std::set<Observer*>::iterator iterator;
-        std::pair<iterator, bool> registerObserver(Observer*);
+        typedef std::vector<Observer*>::iterator iterator;
+        bool registerObserver(Observer*);
         Size unregisterObserver(Observer*);
-        std::set<Observer*> observers_;
+        // observers are moved to the set past this number
+        static const Size maxVectorSize = 64;
+        // only one of the two is used at any given time
+        std::vector<Observer*> observers_;
+        std::set<Observer*> observerSet_;
     };
 
     //! Object that gets notified when a given observable changes
@@ -84,6 +102,83 @@ namespace QuantLib {
     };
 
 
+    //! Global settings for the observer/observable pattern
+    /*! Keeps track of the notifications deferred by any living
+        NotificationBatch instance.
+
+        \ingroup patterns
+    */
+    class ObservableSettings : public Singleton<ObservableSettings> {
+        friend class Singleton<ObservableSettings>;
+        friend class Observable;
+        friend class Observer;
+        friend class NotificationBatch;
+      public:
+        //! whether notifications are currently being deferred
+        bool updatesDeferred() const { return depth_ > 0; }
+      private:
+        ObservableSettings() : depth_(0) {}
+        void deferUpdates() { ++depth_; ++activeBatches(); }
+        void resumeUpdates();
+        /* Number of batches alive in any session.  Being a plain
+           static, it can be checked without accessing the instance;
+           this keeps the common case cheap and is safe even when
+           observers are destroyed during program termination. */
+        static Size& activeBatches() {
+            static Size n = 0;
+            return n;
+        }
+        template <class Iterator>
+        void defer(Iterator begin, Iterator end);
+        void remove(Observer* o);
+        Size depth_;
+        std::vector<Observer*> deferred_, pending_, delivered_;
+    };
+
+
+    //! Scoped batch of deferred notifications
+    /*! While at least one batch is alive, the notifications sent by
+        any observable are not delivered; instead, the observers to be
+        notified are collected.  When the last batch ends, each of
+        them receives a single update() call, in address order; the
+        notifications they send in turn are collected in the same way,
+        and so on until no more observers are left to notify.  This
+        avoids update storms when a large number of observables (e.g.,
+        the quotes underlying a curve) are changed at once:
+        \code
+        {
+            NotificationBatch batch;
+            for (Size i=0; i<quotes.size(); ++i)
+                quotes[i]->setValue(values[i]);
+        }   // each observer is notified at most once here
+        \endcode
+
+        Batches can be nested; only the outermost one delivers the
+        notifications.
+
+        \warning Each observer is updated at most once per batch.
+                 Observers should follow the advice of only raising a
+                 flag in their update() method (as LazyObject does)
+                 rather than reading their observables' data, which
+                 might not be notified yet.
+
+        \note Errors raised by update() methods are swallowed when
+              the batch is destroyed; call end() explicitly to have
+              them reported.
+
+        \ingroup patterns
+    */
+    class NotificationBatch : private boost::noncopyable {
+      public:
+        NotificationBatch();
+        ~NotificationBatch();
+        //! ends the batch, delivering notifications if outermost
+        void end();
+      private:
+        bool ended_;
+    };
+
+
     // inline definitions
 
     inline Observable::Observable(const Observable&) {
@@ -107,21 +202,65 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<std::set<Observer*>::iterator, bool>
-    Observable::registerObserver(Observer* o) {
-        return observers_.insert(o);
+    inline bool Observable::registerObserver(Observer* o) {
+        if (!observerSet_.empty())
+            return observerSet_.insert(o).second;
+        iterator i = std::lower_bound(observers_.begin(),
+                                      observers_.end(), o);
+        if (i != observers_.end() && *i == o)
+            return false;
+        if (observers_.size() < maxVectorSize) {
+            observers_.insert(i, o);
+        } else {
+            observerSet_.insert(observers_.begin(), observers_.end());
+            observerSet_.insert(o);
+            std::vector<Observer*>().swap(observers_);
+        }
+        return true;
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
-        return observers_.erase(o);
+        if (!observerSet_.empty()) {
+            Size n = observerSet_.erase(o);
+            // leave some room before moving back, so that adding and
+            // removing a single observer doesn't move them each time
+            if (observerSet_.size() < maxVectorSize/2) {
+                observers_.assign(observerSet_.begin(), observerSet_.end());
+                observerSet_.clear();
+            }
+            return n;
+        }
+        iterator i = std::lower_bound(observers_.begin(),
+                                      observers_.end(), o);
+        if (i == observers_.end() || *i != o)
+            return 0;
+        observers_.erase(i);
+        return 1;
     }
 
     inline void Observable::notifyObservers() {
+        if (observers_.empty() && observerSet_.empty())
+            return;
+
+        if (ObservableSettings::activeBatches() > 0) {
+            ObservableSettings& settings = ObservableSettings::instance();
+            if (settings.updatesDeferred()) {
+                if (observerSet_.empty())
+                    settings.defer(observers_.begin(), observers_.end());
+                else
+                    settings.defer(observerSet_.begin(), observerSet_.end());
+                return;
+            }
+        }
+
         bool successful = true;
         std::string errMsg;
-        for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+        Size i = 0;
+        Observer* o = observerSet_.empty() ? observers_.front()
+                                           : *observerSet_.begin();
+        while (o != 0) {
             try {
-                (*i)->update();
+                o->update();
             } catch (std::exception& e) {
                 // quite a dilemma. If we don't catch the exception,
                 // other observers will not receive the notification
@@ -135,6 +274,23 @@ namespace QuantLib {
             } catch (...) {
                 successful = false;
             }
+            // observers might have been added or removed during the
+            // update, possibly moving all of them between the vector
+            // and the set; if so, move on to the first one following
+            // o, as iterating on a set would do.
+            if (observerSet_.empty()) {
+                if (i < observers_.size() && observers_[i] == o)
+                    ++i;
+                else
+                    i = std::upper_bound(observers_.begin(),
+                                         observers_.end(), o)
+                        - observers_.begin();
+                o = i < observers_.size() ? observers_[i] : 0;
+            } else {
+                std::set<Observer*>::const_iterator j =
+                    observerSet_.upper_bound(o);
+                o = j != observerSet_.end() ? *j : 0;
+            }
         }
         QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
@@ -160,6 +316,8 @@ namespace QuantLib {
     inline Observer::~Observer() {
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->unregisterObserver(this);
+        if (ObservableSettings::activeBatches() > 0)
+            ObservableSettings::instance().remove(this);
     }
 
     inline std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
@@ -184,6 +342,98 @@ namespace QuantLib {
         observables_.clear();
     }
 
+
+    template <class Iterator>
+    inline void ObservableSettings::defer(Iterator begin, Iterator end) {
+        deferred_.insert(deferred_.end(), begin, end);
+    }
+
+    inline void ObservableSettings::remove(Observer* o) {
+        // destroyed observers must not be notified; also, a new
+        // observer might be created at the same address.
+        if (depth_ == 0)
+            return;
+        deferred_.erase(std::remove(deferred_.begin(), deferred_.end(), o),
+                        deferred_.end());
+        std::replace(pending_.begin(), pending_.end(), o,
+                     static_cast<Observer*>(0));
+        std::vector<Observer*>::iterator i =
+            std::lower_bound(delivered_.begin(), delivered_.end(), o);
+        if (i != delivered_.end() && *i == o)
+            delivered_.erase(i);
+    }
+
+    inline void ObservableSettings::resumeUpdates() {
+        QL_REQUIRE(depth_ > 0, "notifications are not being deferred");
+        if (depth_ > 1) {
+            --depth_;
+            --activeBatches();
+            return;
+        }
+
+        // notifications are still deferred while delivering, so that
+        // the ones sent by the observers are collected as well
+        bool successful = true;
+        std::string errMsg;
+        while (!deferred_.empty()) {
+            pending_.swap(deferred_);
+            deferred_.clear();
+            std::sort(pending_.begin(), pending_.end());
+            pending_.erase(std::unique(pending_.begin(), pending_.end()),
+                           pending_.end());
+            for (Size i=0; i<pending_.size(); ++i) {
+                Observer* o = pending_[i];
+                if (o == 0 || std::binary_search(delivered_.begin(),
+                                                 delivered_.end(), o))
+                    continue;
+                try {
+                    o->update();
+                } catch (std::exception& e) {
+                    successful = false;
+                    errMsg = e.what();
+                } catch (...) {
+                    successful = false;
+                }
+            }
+            pending_.erase(std::remove(pending_.begin(), pending_.end(),
+                                       static_cast<Observer*>(0)),
+                           pending_.end());
+            std::vector<Observer*> delivered;
+            delivered.reserve(delivered_.size() + pending_.size());
+            std::set_union(delivered_.begin(), delivered_.end(),
+                           pending_.begin(), pending_.end(),
+                           std::back_inserter(delivered));
+            delivered_.swap(delivered);
+        }
+        pending_.clear();
+        delivered_.clear();
+        depth_ = 0;
+        --activeBatches();
+
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+
+    inline NotificationBatch::NotificationBatch() : ended_(false) {
+        ObservableSettings::instance().deferUpdates();
+    }
+
+    inline NotificationBatch::~NotificationBatch() {
+        try {
+            end();
+        } catch (...) {
+            // nothing we can do
+        }
+    }
+
+    inline void NotificationBatch::end() {
+        if (!ended_) {
+            ended_ = true;
+            ObservableSettings::instance().resumeUpdates();
+        }
+    }
+
 }
 
 #endif
@@ -51,4 +51,33 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+    void ArithmeticAPOPathPricer::priceBatch(const MultiPathBlock& paths,
+                                             std::vector<Real>& values)
+                                                                    const {
+        Size m = paths.pathNumber(), n = paths.pathSize();
+        if (m == 0)
+            return;
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        // the running sums are accumulated in the same order as in
+        // operator(), one time step at a time across the paths
+        Size first, fixings;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            // include initial fixing
+            first = 0;
+            fixings = pastFixings_ + n;
+        } else {
+            first = 1;
+            fixings = pastFixings_ + n - 1;
+        }
+        std::fill(values.begin(), values.begin()+m, runningSum_);
+        for (Size i=first; i<n; ++i) {
+            const Real* x = paths(0,i);
+            for (Size k=0; k<m; ++k)
+                values[k] += x[k];
+        }
+        for (Size k=0; k<m; ++k)
+            values[k] = discount_ * payoff_(values[k]/fixings);
+    }
+
 }
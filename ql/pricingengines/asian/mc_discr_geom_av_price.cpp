@@ -58,4 +58,41 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+    void GeometricAPOPathPricer::priceBatch(const MultiPathBlock& paths,
+                                            std::vector<Real>& values)
+                                                                    const {
+        Size m = paths.pathNumber(), n = paths.pathSize() - 1;
+        if (m == 0)
+            return;
+        QL_REQUIRE(n>0, "the path cannot be empty");
+
+        std::vector<Real> products(m, runningProduct_);
+        Size fixings = n+pastFixings_;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            fixings += 1;
+            const Real* x = paths(0,0);
+            for (Size k=0; k<m; ++k)
+                products[k] *= x[k];
+        }
+        // care must be taken not to overflow product
+        Real maxValue = QL_MAX_REAL;
+        std::fill(values.begin(), values.begin()+m, 1.0);
+        for (Size i=1; i<n+1; i++) {
+            const Real* x = paths(0,i);
+            for (Size k=0; k<m; ++k) {
+                if (products[k] < maxValue/x[k]) {
+                    products[k] *= x[k];
+                } else {
+                    values[k] *= std::pow(products[k], 1.0/fixings);
+                    products[k] = x[k];
+                }
+            }
+        }
+        for (Size k=0; k<m; ++k) {
+            Real averagePrice =
+                values[k] * std::pow(products[k], 1.0/fixings);
+            values[k] = discount_ * payoff_(averagePrice);
+        }
+    }
+
 }
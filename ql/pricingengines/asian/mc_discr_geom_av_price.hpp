@@ -73,6 +73,9 @@ namespace QuantLib {
                                Real runningProduct = 1.0,
                                Size pastFixings = 0);
         Real operator()(const Path& path) const;
+        bool providesBatch() const { return true; }
+        void priceBatch(const MultiPathBlock& paths,
+                        std::vector<Real>& values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
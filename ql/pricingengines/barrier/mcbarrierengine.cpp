@@ -248,4 +248,59 @@ namespace QuantLib {
         }
     }
 
+    void BiasedBarrierPathPricer::priceBatch(const MultiPathBlock& paths,
+                                             std::vector<Real>& values)
+                                                                    const {
+        static Size null = Null<Size>();
+        Size m = paths.pathNumber(), n = paths.pathSize();
+        if (m == 0)
+            return;
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        // first node at which each path crosses the barrier
+        std::vector<Size> knockNodes(m, null);
+        bool down;
+        switch (barrierType_) {
+          case Barrier::DownIn:
+          case Barrier::DownOut:
+            down = true;
+            break;
+          case Barrier::UpIn:
+          case Barrier::UpOut:
+            down = false;
+            break;
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+        for (Size i = 1; i < n; i++) {
+            const Real* x = paths(0,i);
+            for (Size k = 0; k < m; k++) {
+                bool crossed = down ? x[k] <= barrier_ : x[k] >= barrier_;
+                if (crossed && knockNodes[k] == null)
+                    knockNodes[k] = i;
+            }
+        }
+
+        const Real* last = paths(0,n-1);
+        for (Size k = 0; k < m; k++) {
+            bool knocked = (knockNodes[k] != null);
+            switch (barrierType_) {
+              case Barrier::UpIn:
+              case Barrier::DownIn:
+                values[k] = knocked ?
+                    payoff_(last[k]) * discounts_.back() :
+                    rebate_*discounts_.back();
+                break;
+              case Barrier::UpOut:
+              case Barrier::DownOut:
+                values[k] = knocked ?
+                    rebate_*discounts_[knockNodes[k]] :
+                    payoff_(last[k]) * discounts_.back();
+                break;
+              default:
+                QL_FAIL("unknown barrier type");
+            }
+        }
+    }
+
 }
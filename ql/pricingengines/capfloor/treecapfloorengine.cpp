@@ -61,15 +61,8 @@ namespace QuantLib {
         }
 
         DiscretizedCapFloor capfloor(arguments_, referenceDate, dayCounter);
-        boost::shared_ptr<Lattice> lattice;
-
-        if (lattice_) {
-            lattice = lattice_;
-        } else {
-            std::vector<Time> times = capfloor.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
+        boost::shared_ptr<Lattice> lattice =
+            this->lattice(capfloor.mandatoryTimes());
 
         Time firstTime = dayCounter.yearFraction(referenceDate,
                                                  arguments_.startDates.front());
@@ -27,12 +27,24 @@
 
 #include <ql/models/model.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
+#include <map>
 
 namespace QuantLib {
 
     //! Engine for a short-rate model specialized on a lattice
     /*! Derived engines only need to implement the <tt>calculate()</tt>
-        method
+        method, in which they should get the lattice from the
+        <tt>lattice()</tt> method.
+
+        Lattices are built when first needed and kept until the
+        engine is notified of a change, e.g., by the model.  When the
+        engine is given a time grid, a single lattice serves all the
+        instruments using the engine; its grid should then include
+        the mandatory times of all of them.  Otherwise, a lattice is
+        kept for each set of mandatory times and reused by all the
+        instruments yielding the same set, as for swaptions with
+        different strikes on the same schedule, in whatever order
+        they are priced.
     */
     template <class Arguments, class Results>
     class LatticeShortRateModelEngine
@@ -49,9 +61,19 @@ namespace QuantLib {
                                const TimeGrid& timeGrid);
         void update();
       protected:
+        /*! returns the lattice on the time grid passed to the
+            constructor if any, or on a grid with the given mandatory
+            times and the given number of steps otherwise.
+        */
+        boost::shared_ptr<Lattice> lattice(
+                              const std::vector<Time>& mandatoryTimes) const;
+
         TimeGrid timeGrid_;
         Size timeSteps_;
-        boost::shared_ptr<Lattice> lattice_;
+        mutable boost::shared_ptr<Lattice> lattice_;
+      private:
+        mutable std::map<std::vector<Time>, boost::shared_ptr<Lattice> >
+                                                                 lattices_;
     };
 
     template <class Arguments, class Results>
@@ -81,18 +103,36 @@ namespace QuantLib {
             const boost::shared_ptr<ShortRateModel>& model,
             const TimeGrid& timeGrid)
     : GenericModelEngine<ShortRateModel, Arguments, Results>(model),
-      timeGrid_(timeGrid), timeSteps_(0) {
-        lattice_ = this->model_->tree(timeGrid);
-    }
+      timeGrid_(timeGrid), timeSteps_(0) {}
 
     template <class Arguments, class Results>
     void LatticeShortRateModelEngine<Arguments, Results>::update()
     {
-        if (!timeGrid_.empty())
-            lattice_ = this->model_->tree(timeGrid_);
+        lattice_.reset();
+        lattices_.clear();
         GenericModelEngine<ShortRateModel, Arguments, Results>::update();
     }
 
+    template <class Arguments, class Results>
+    boost::shared_ptr<Lattice>
+    LatticeShortRateModelEngine<Arguments, Results>::lattice(
+                              const std::vector<Time>& mandatoryTimes) const {
+        if (!timeGrid_.empty()) {
+            if (!lattice_)
+                lattice_ = this->model_->tree(timeGrid_);
+            return lattice_;
+        }
+
+        // the number of steps being fixed, the mandatory times
+        // determine the grid
+        boost::shared_ptr<Lattice>& lattice = lattices_[mandatoryTimes];
+        if (!lattice)
+            lattice = this->model_->tree(
+                TimeGrid(mandatoryTimes.begin(), mandatoryTimes.end(),
+                         timeSteps_));
+        return lattice;
+    }
+
 }
 
 
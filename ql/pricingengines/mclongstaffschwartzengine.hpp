@@ -37,6 +37,12 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        If more than one worker is given, both the calibration and
+        the pricing paths are split among the workers as described in
+        MonteCarloModel; the regression is performed in parallel as
+        well.  Derived classes should pass the number of workers to
+        the LongstaffSchwartzPathPricer they build.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -64,7 +70,8 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples = Null<Size>());
+            Size nCalibrationSamples = Null<Size>(),
+            Size workers = 1);
 
         void calculate() const;
 
@@ -104,8 +111,9 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples)
-    : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
+            Size nCalibrationSamples,
+            Size workers)
+    : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate, workers),
       process_            (process),
       timeSteps_          (timeSteps),
       timeStepsPerYear_   (timeStepsPerYear),
@@ -146,13 +154,33 @@ namespace QuantLib {
               class RNG, class S>
     inline
     void MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::calculate() const {
+        typedef LongstaffSchwartzPathPricer<path_type> lsm_pricer_type;
         pathPricer_ = this->lsmPathPricer();
+
+        // with more than one worker, each one collects its own slice
+        // of the calibration paths; the slices are then passed in
+        // order to the actual pricer.
+        std::vector<boost::shared_ptr<lsm_pricer_type> > calibrationPricers;
+        std::vector<boost::shared_ptr<path_pricer_type> > workerPathPricers;
+        if (this->workers_ > 1) {
+            for (Size i=0; i<this->workers_; ++i) {
+                calibrationPricers.push_back(this->lsmPathPricer());
+                workerPathPricers.push_back(calibrationPricers.back());
+            }
+        }
+
         this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                           new MonteCarloModel<MC,RNG,S>
                               (pathGenerator(), pathPricer_,
-                               stats_type(), this->antitheticVariate_));
+                               stats_type(), this->antitheticVariate_,
+                               boost::shared_ptr<path_pricer_type>(),
+                               typename McSimulation<MC,RNG,S>::result_type(),
+                               boost::shared_ptr<path_generator_type>(),
+                               workerPathPricers));
 
         this->mcModel_->addSamples(nCalibrationSamples_);
+        for (Size i=0; i<calibrationPricers.size(); ++i)
+            this->pathPricer_->addCalibrationPaths(*calibrationPricers[i]);
         this->pathPricer_->calibrate();
 
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
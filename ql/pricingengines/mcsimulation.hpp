@@ -37,6 +37,10 @@ namespace QuantLib {
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        If more than one worker is requested, the simulated paths are
+        split in contiguous slices among the given number of workers;
+        see MonteCarloModel for details.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,9 +71,12 @@ namespace QuantLib {
                        Size maxSamples) const;
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size workers = 1)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), workers_(workers) {
+            QL_REQUIRE(workers_ > 0, "at least one worker required");
+        }
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -97,6 +104,7 @@ namespace QuantLib {
         
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size workers_;
     };
 
 
@@ -164,6 +172,17 @@ namespace QuantLib {
                    requiredSamples != Null<Size>(),
                    "neither tolerance nor number of samples set");
 
+        typedef std::vector<boost::shared_ptr<path_pricer_type> > pricers;
+        pricers workerPathPricers, workerControlPathPricers;
+        if (workers_ > 1) {
+            for (Size i=0; i<workers_; ++i) {
+                workerPathPricers.push_back(this->pathPricer());
+                if (this->controlVariate_)
+                    workerControlPathPricers.push_back(
+                                                this->controlPathPricer());
+            }
+        }
+
         //! Initialize the one-factor Monte Carlo
         if (this->controlVariate_) {
 
@@ -186,13 +205,18 @@ namespace QuantLib {
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+                           controlVariateValue, controlPG,
+                           workerPathPricers, workerControlPathPricers));
         } else {
             this->mcModel_ =
                 boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_));
+                           this->antitheticVariate_,
+                           boost::shared_ptr<path_pricer_type>(),
+                           result_type(),
+                           boost::shared_ptr<path_generator_type>(),
+                           workerPathPricers));
         }
 
         if (requiredTolerance != Null<Real>()) {
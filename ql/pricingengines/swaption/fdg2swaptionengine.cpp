@@ -30,9 +30,11 @@
 #include <ql/methods/finitedifferences/meshers/fdmsimpleprocess1dmesher.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmg2solver.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmaffinemodelswapinnervalue.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 
 #include <boost/scoped_ptr.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -111,17 +113,72 @@ namespace QuantLib {
                  DividendSchedule(), arguments_.exercise,
                  mesher, calculator, referenceDate, dc);
 
+        // the values before exercise are recorded as checkpoints
+        std::vector<Time> exerciseTimes;
+        for (std::map<Time, Date>::const_iterator iter = t2d.begin();
+             iter != t2d.end(); ++iter) {
+            exerciseTimes.push_back(iter->first);
+        }
+        const boost::shared_ptr<FdmSnapshotCondition> snapshots(
+            new FdmSnapshotCondition(exerciseTimes));
+
         // 5. Boundary conditions
         const FdmBoundaryConditionSet boundaries;
 
         // 6. Solver
-        FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
-                                     calculator, maturity,
-                                     tGrid_, dampingSteps_ };
+        boost::shared_ptr<FdmStepConditionComposite> stepConditions =
+            FdmStepConditionComposite::joinConditions(snapshots, conditions);
+        boost::shared_ptr<FdmInnerValueCalculator> initialValues = calculator;
+        Time resumeTime = maturity;
+        Size timeSteps = tGrid_, dampingSteps = dampingSteps_;
+
+        // resume from the values stored by a previous calculation if
+        // the exercise dates after them agree
+        const Size resumeIndex
+            = checkpoints_.resumeIndex(arguments_.swap, exerciseDates);
+        if (resumeIndex != Null<Size>()) {
+            const Time t = dc.yearFraction(
+                referenceDate, checkpoints_.dates()[resumeIndex]);
+            if (t > 0.0) {
+                stepConditions = FdmStepConditionComposite::resumeConditions(
+                                                         stepConditions, t);
+                initialValues = boost::shared_ptr<FdmInnerValueCalculator>(
+                    new FdmArrayInnerValue(checkpoints_.values(resumeIndex)));
+                resumeTime = t;
+                timeSteps = std::max<Size>(1, Size(tGrid_*t/maturity + 0.5));
+                dampingSteps = 0;
+            }
+        }
+
+        FdmSolverDesc solverDesc = { mesher, boundaries, stepConditions,
+                                     initialValues, resumeTime,
+                                     timeSteps, dampingSteps };
 
         const boost::scoped_ptr<FdmG2Solver> solver(
             new FdmG2Solver(model_, solverDesc, schemeDesc_));
 
         results_.value = solver->valueAt(0.0, 0.0);
+
+        // 7. Checkpoints
+        std::vector<Array> values(exerciseDates.size());
+        for (Size i=0; i < exerciseDates.size(); ++i) {
+            const Time t = dc.yearFraction(referenceDate, exerciseDates[i]);
+            if (t <= resumeTime) {
+                values[i] = snapshots->getValues(t);
+            }
+            else {
+                const std::vector<Date>& dates = checkpoints_.dates();
+                values[i] = checkpoints_.values(
+                    std::find(dates.begin(), dates.end(), exerciseDates[i])
+                    - dates.begin());
+            }
+        }
+        checkpoints_.store(arguments_.swap, exerciseDates, values);
+    }
+
+    void FdG2SwaptionEngine::update() {
+        checkpoints_.clear();
+        GenericModelEngine<G2, Swaption::arguments,
+                           Swaption::results>::update();
     }
 }
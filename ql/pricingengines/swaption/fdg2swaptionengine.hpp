@@ -28,6 +28,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcheckpointcache.hpp>
 
 namespace QuantLib {
 
@@ -42,10 +43,22 @@ namespace QuantLib {
 
         void calculate() const;
 
+        /*! The values on the mesh before each exercise are kept, so
+            that a swaption on the same swap whose exercise dates
+            agree with the last ones after some of these dates can
+            be priced by resuming the rollback from there; this
+            speeds up the pricing of strips of Bermudan swaptions
+            with a common last exercise date, in particular when
+            priced from the one with the most exercise dates.
+        */
+        void update();
+
       private:
         const Size tGrid_, xGrid_, yGrid_, dampingSteps_;
         const Real invEps_;
         const FdmSchemeDesc schemeDesc_;
+
+        mutable FdmCheckpointCache checkpoints_;
     };
 }
 #endif
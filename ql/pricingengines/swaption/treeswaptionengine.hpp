@@ -39,7 +39,13 @@ namespace QuantLib {
                  the initial part of the swap so that it starts at
                  \f$ t \geq 0 \f$.
 
-        \test calculations are checked against cached results
+        \test
+        - calculations are checked against cached results
+        - the reuse of the lattice by swaptions sharing the engine,
+          and its rebuilding after a change in the model, are tested
+          both with and without a fixed time grid.
+        - the lattices kept for swaptions on different schedules,
+          priced in turns, are tested.
     */
     class TreeSwaptionEngine
     : public LatticeShortRateModelEngine<Swaption::arguments,
@@ -21,11 +21,16 @@
 
 #include <ql/exercise.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimmultisolver.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 
@@ -35,18 +40,53 @@ namespace QuantLib {
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
             Size tGrid, Size xGrid, Size dampingSteps, 
             const FdmSchemeDesc& schemeDesc,
-            bool localVol, Real illegalLocalVolOverwrite)
+            bool localVol, Real illegalLocalVolOverwrite,
+            bool sensitivities, Real adaptiveTolerance)
     : process_(process),
       tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc), 
       localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      sensitivities_(sensitivities),
+      adaptiveTolerance_(adaptiveTolerance) {
 
         registerWith(process_);
     }
 
     void FdBlackScholesVanillaEngine::calculate() const {
 
+        // cache lookup for precalculated results
+        for (Size i=0; i < cachedArgs2results_.size(); ++i) {
+            if (   cachedArgs2results_[i].first.exercise->type()
+                        == arguments_.exercise->type()
+                && cachedArgs2results_[i].first.exercise->dates()
+                        == arguments_.exercise->dates()) {
+                boost::shared_ptr<PlainVanillaPayoff> p1 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                            arguments_.payoff);
+                boost::shared_ptr<PlainVanillaPayoff> p2 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                          cachedArgs2results_[i].first.payoff);
+
+                if (p1 && p1->strike()     == p2->strike()
+                       && p1->optionType() == p2->optionType()) {
+                    QL_REQUIRE(arguments_.cashFlow.empty(),
+                               "multiple strikes engine does "
+                               "not work with discrete dividends");
+                    results_ = cachedArgs2results_[i].second;
+                    return;
+                }
+            }
+        }
+
+        // with a smile, each strike needs its own operator; adaptive
+        // time stepping is done for the priced strike alone
+        if (!strikes_.empty() && adaptiveTolerance_ == Null<Real>()
+            && strikeIndependentVolatility()) {
+            calculateMultipleStrikes();
+            return;
+        }
+
         // 1. Mesher
         const boost::shared_ptr<StrikedTypePayoff> payoff =
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
@@ -84,12 +124,121 @@ namespace QuantLib {
                 new FdmBlackScholesSolver(
                              Handle<GeneralizedBlackScholesProcess>(process_),
                              payoff->strike(), solverDesc, schemeDesc_,
-                             localVol_, illegalLocalVolOverwrite_));
+                             localVol_, illegalLocalVolOverwrite_,
+                             sensitivities_, adaptiveTolerance_));
 
         const Real spot = process_->x0();
         results_.value = solver->valueAt(spot);
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
+        if (sensitivities_) {
+            results_.vega = solver->vegaAt(spot);
+            results_.rho  = solver->rhoAt(spot);
+        }
+        if (adaptiveTolerance_ != Null<Real>()) {
+            results_.additionalResults["acceptedTimeSteps"] =
+                solver->acceptedSteps();
+            results_.additionalResults["rejectedTimeSteps"] =
+                solver->rejectedSteps();
+            results_.additionalResults["timeSteppingError"] =
+                solver->errorEstimate();
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::calculateMultipleStrikes() const {
+        QL_REQUIRE(arguments_.cashFlow.empty(), "multiple strikes engine "
+                   "does not work with discrete dividends");
+
+        const boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "multiple strikes engine "
+                   "works only with plain vanilla payoffs");
+
+        std::vector<Real> strikes(strikes_);
+        if (std::find(strikes.begin(), strikes.end(), payoff->strike())
+                                                            == strikes.end())
+            strikes.push_back(payoff->strike());
+
+        // 1. Mesher
+        const Time maturity = process_->time(arguments_.exercise->lastDate());
+        const boost::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMultiStrikeMesher(
+                    xGrid_, process_, maturity, strikes, 0.0001, 1.5,
+                    std::pair<Real, Real>(payoff->strike(), 0.075)));
+
+        const boost::shared_ptr<FdmMesher> mesher (
+            new FdmMesherComposite(equityMesher));
+
+        // 2. Calculators and 3. step conditions, one for each strike
+        std::vector<boost::shared_ptr<PlainVanillaPayoff> > payoffs;
+        std::vector<boost::shared_ptr<FdmInnerValueCalculator> > calculators;
+        std::vector<boost::shared_ptr<FdmStepConditionComposite> > conditions;
+        for (Size i=0; i < strikes.size(); ++i) {
+            payoffs.push_back(boost::shared_ptr<PlainVanillaPayoff>(
+                    new PlainVanillaPayoff(payoff->optionType(), strikes[i])));
+            calculators.push_back(boost::shared_ptr<FdmInnerValueCalculator>(
+                             new FdmLogInnerValue(payoffs.back(), mesher, 0)));
+            conditions.push_back(FdmStepConditionComposite::vanillaComposite(
+                                    arguments_.cashFlow, arguments_.exercise,
+                                    mesher, calculators.back(),
+                                    process_->riskFreeRate()->referenceDate(),
+                                    process_->riskFreeRate()->dayCounter()));
+        }
+
+        // 4. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 5. Solver
+        const boost::shared_ptr<FdmBlackScholesOp> op(new FdmBlackScholesOp(
+                mesher, process_, payoff->strike(),
+                localVol_, illegalLocalVolOverwrite_));
+
+        const boost::shared_ptr<Fdm1DimMultiSolver> solver(
+                new Fdm1DimMultiSolver(mesher, boundaries,
+                                       conditions, calculators,
+                                       maturity, tGrid_, dampingSteps_,
+                                       schemeDesc_, op));
+
+        const Real spot = process_->x0();
+        const Real x = std::log(spot);
+
+        cachedArgs2results_.resize(strikes.size());
+        for (Size i=0; i < strikes.size(); ++i) {
+            cachedArgs2results_[i].first.exercise = arguments_.exercise;
+            cachedArgs2results_[i].first.payoff = payoffs[i];
+
+            DividendVanillaOption::results&
+                                results = cachedArgs2results_[i].second;
+            results.value = solver->interpolateAt(i, x);
+            results.delta = solver->derivativeX(i, x)/spot;
+            results.gamma = (solver->derivativeXX(i, x)
+                             -solver->derivativeX(i, x))/(spot*spot);
+            results.theta = solver->thetaAt(i, x);
+
+            if (strikes[i] == payoff->strike())
+                results_ = results;
+        }
+    }
+
+    bool FdBlackScholesVanillaEngine::strikeIndependentVolatility() const {
+        if (localVol_)
+            return true;
+
+        const boost::shared_ptr<BlackVolTermStructure> vol =
+            process_->blackVolatility().currentLink();
+        return boost::dynamic_pointer_cast<BlackConstantVol>(vol)
+            || boost::dynamic_pointer_cast<BlackVarianceCurve>(vol);
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        cachedArgs2results_.clear();
+        DividendVanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
     }
 }
@@ -39,6 +39,34 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        When multiple-strikes caching is enabled, the options with
+        the given strikes (together with the one being priced) are
+        rolled back together through the same operator and their
+        results are cached for options with the same exercise and
+        option type.
+
+        If sensitivities are requested, vega and rho are calculated
+        by solving the tangent equations together with the pricing
+        equation (see FdmSensitivityOp) instead of by bumping and
+        repricing; they are not available with local volatility or
+        in multiple-strikes mode.
+
+        Multiple-strikes mode requires the volatility to be the same
+        for all strikes, i.e., either local volatility or a Black
+        volatility without smile (BlackConstantVol or
+        BlackVarianceCurve); otherwise, each option is priced
+        separately.
+
+        If an adaptive tolerance is given, the time steps are chosen
+        by error control starting from tGrid steps (see
+        FdmBackwardSolver::rollbackAdaptive); the numbers of
+        accepted and rejected steps and the estimated time-stepping
+        error are returned as the additional results
+        "acceptedTimeSteps", "rejectedTimeSteps" and
+        "timeSteppingError".  Adaptive time stepping is not
+        available together with sensitivities, and options are
+        priced separately in multiple-strikes mode.
     */
     class GeneralizedBlackScholesProcess;
 
@@ -50,16 +78,32 @@ namespace QuantLib {
                 Size tGrid = 100, Size xGrid = 100, Size dampingSteps = 0,
                 const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
                 bool localVol = false,
-                Real illegalLocalVolOverwrite = -Null<Real>());
+                Real illegalLocalVolOverwrite = -Null<Real>(),
+                bool sensitivities = false,
+                Real adaptiveTolerance = Null<Real>());
 
         void calculate() const;
 
+        // multiple strikes caching engine
+        void update();
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
       private:
+        void calculateMultipleStrikes() const;
+        bool strikeIndependentVolatility() const;
+
         const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+        const bool sensitivities_;
+        const Real adaptiveTolerance_;
+
+        std::vector<Real> strikes_;
+        mutable std::vector<std::pair<DividendVanillaOption::arguments,
+                                      DividendVanillaOption::results> >
+                                                            cachedArgs2results_;
     };
 }
 
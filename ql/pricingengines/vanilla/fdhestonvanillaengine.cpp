@@ -36,13 +36,15 @@ namespace QuantLib {
     FdHestonVanillaEngine::FdHestonVanillaEngine(
             const boost::shared_ptr<HestonModel>& model,
             Size tGrid, Size xGrid, Size vGrid, Size dampingSteps,
-            const FdmSchemeDesc& schemeDesc)
+            const FdmSchemeDesc& schemeDesc,
+            bool sensitivities)
     : GenericModelEngine<HestonModel,
                         DividendVanillaOption::arguments,
                         DividendVanillaOption::results>(model),
       tGrid_(tGrid), xGrid_(xGrid), 
       vGrid_(vGrid), dampingSteps_(dampingSteps),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc),
+      sensitivities_(sensitivities) {
     }
 
 
@@ -142,7 +144,8 @@ namespace QuantLib {
 
         boost::shared_ptr<FdmHestonSolver> solver(new FdmHestonSolver(
                     Handle<HestonProcess>(process),
-                    getSolverDesc(1.5), schemeDesc_));
+                    getSolverDesc(1.5), schemeDesc_,
+                    Handle<FdmQuantoHelper>(), sensitivities_));
 
         const Real v0   = process->v0();
         const Real spot = process->s0()->value();
@@ -151,6 +154,8 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot, v0);
         results_.gamma = solver->gammaAt(spot, v0);
         results_.theta = solver->thetaAt(spot, v0);
+        if (sensitivities_)
+            results_.rho = solver->rhoAt(spot, v0);
         
         cachedArgs2results_.resize(strikes_.size());
         const boost::shared_ptr<StrikedTypePayoff> payoff =
@@ -168,6 +173,8 @@ namespace QuantLib {
             results.delta = solver->deltaAt(spot*d, v0);
             results.gamma = solver->gammaAt(spot*d, v0)*d;
             results.theta = solver->thetaAt(spot*d, v0)/d;                
+            if (sensitivities_)
+                results.rho = solver->rhoAt(spot*d, v0)/d;
         }
     }
     
@@ -38,9 +38,15 @@ namespace QuantLib {
 
     /*! \ingroup vanillaengines
 
-        \test the correctness of the returned value is tested by
-              reproducing results available in web/literature
-              and comparison with Black pricing.
+        \test
+        - the correctness of the returned value is tested by
+          reproducing results available in web/literature
+          and comparison with Black pricing.
+        - the returned rho is tested against bump-and-reprice.
+
+        If sensitivities are requested, rho is calculated by solving
+        the tangent equation together with the pricing equation (see
+        FdmSensitivityOp) instead of by bumping and repricing.
     */
     class FdHestonVanillaEngine
         : public GenericModelEngine<HestonModel,
@@ -52,7 +58,8 @@ namespace QuantLib {
             const boost::shared_ptr<HestonModel>& model,
             Size tGrid = 100, Size xGrid = 100, 
             Size vGrid = 50, Size dampingSteps = 0,
-            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer());
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
+            bool sensitivities = false);
 
         void calculate() const;
         
@@ -66,6 +73,7 @@ namespace QuantLib {
       private:
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
+        const bool sensitivities_;
         
         std::vector<Real> strikes_;
         mutable std::vector<std::pair<DividendVanillaOption::arguments,
@@ -61,7 +61,8 @@ namespace QuantLib {
              BigNatural seed,
              Size polynomOrder,
              LsmBasisSystem::PolynomType polynomType,
-             Size nCalibrationSamples = Null<Size>());
+             Size nCalibrationSamples = Null<Size>(),
+             Size workers = 1);
 
         void calculate() const;
         
@@ -116,6 +117,7 @@ namespace QuantLib {
         MakeMCAmericanEngine& withPolynomOrder(Size polynomOrer);
         MakeMCAmericanEngine& withBasisSystem(LsmBasisSystem::PolynomType);
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
+        MakeMCAmericanEngine& withWorkers(Size workers);
 
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -128,6 +130,7 @@ namespace QuantLib {
         BigNatural seed_;
         Size polynomOrder_;
         LsmBasisSystem::PolynomType polynomType_;
+        Size workers_;
     };
 
     template <class RNG, class S> inline
@@ -138,14 +141,15 @@ namespace QuantLib {
         Size requiredSamples, Real requiredTolerance,
         Size maxSamples,BigNatural seed,
         Size polynomOrder, LsmBasisSystem::PolynomType polynomType,
-        Size nCalibrationSamples)
+        Size nCalibrationSamples, Size workers)
     : MCLongstaffSchwartzEngine<VanillaOption::engine,
                                 SingleVariate,RNG,S>(
                                          process, timeSteps, timeStepsPerYear,
                                          false, antitheticVariate,
                                          controlVariate, requiredSamples,
                                          requiredTolerance, maxSamples,
-                                         seed, nCalibrationSamples),
+                                         seed, nCalibrationSamples,
+                                         workers),
       polynomOrder_(polynomOrder),
       polynomType_(polynomType) {}
 
@@ -183,7 +187,8 @@ namespace QuantLib {
              new LongstaffSchwartzPathPricer<Path>(
                                       this->timeGrid(),
                                       earlyExercisePathPricer,
-                                      *(process->riskFreeRate())));
+                                      *(process->riskFreeRate()),
+                                      this->workers_));
     }
 
     template <class RNG, class S>
@@ -252,7 +257,8 @@ namespace QuantLib {
       calibrationSamples_(2048),
       tolerance_(Null<Real>()), seed_(0),
       polynomOrder_(2),
-      polynomType_ (LsmBasisSystem::Monomial) {}
+      polynomType_ (LsmBasisSystem::Monomial),
+      workers_(1) {}
 
     template <class RNG, class S>
     inline MakeMCAmericanEngine<RNG,S>&
@@ -318,6 +324,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCAmericanEngine<RNG,S>&
+    MakeMCAmericanEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCAmericanEngine<RNG,S>&
     MakeMCAmericanEngine<RNG,S>::withSeed(BigNatural seed) {
@@ -359,7 +372,8 @@ namespace QuantLib {
                                      seed_,
                                      polynomOrder_,
                                      polynomType_,
-                                     calibrationSamples_));
+                                     calibrationSamples_,
+                                     workers_));
     }
 
 }
@@ -36,8 +36,12 @@ namespace QuantLib {
     //! European option pricing engine using Monte Carlo simulation
     /*! \ingroup vanillaengines
 
-        \test the correctness of the returned value is tested by
-              checking it against analytic results.
+        \test
+        - the correctness of the returned value is tested by
+          checking it against analytic results.
+        - the results obtained with multiple workers are checked
+          against analytic results and against the corresponding
+          serial results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanEngine : public MCVanillaEngine<SingleVariate,RNG,S> {
@@ -60,7 +64,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1);
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
     };
@@ -80,6 +85,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withWorkers(Size workers);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -89,6 +95,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size workers_;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -97,6 +104,9 @@ namespace QuantLib {
                            Real strike,
                            DiscountFactor discount);
         Real operator()(const Path& path) const;
+        bool providesBatch() const { return true; }
+        void priceBatch(const MultiPathBlock& paths,
+                        std::vector<Real>& values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -116,7 +126,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size workers)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +137,8 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed,
+                                           workers) {}
 
 
     template <class RNG, class S>
@@ -159,7 +171,8 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0),
+      workers_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -224,6 +237,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -240,7 +260,8 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    workers_));
     }
 
 
@@ -258,6 +279,18 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline void EuropeanPathPricer::priceBatch(const MultiPathBlock& paths,
+                                               std::vector<Real>& values)
+                                                                    const {
+        const Size n = paths.pathNumber();
+        if (n == 0)
+            return;
+        QL_REQUIRE(paths.pathSize() > 0, "the path cannot be empty");
+        const Real* last = paths(0, paths.pathSize()-1);
+        for (Size k=0; k<n; ++k)
+            values[k] = payoff_(last[k]) * discount_;
+    }
+
 }
 
 
@@ -107,6 +107,23 @@ namespace QuantLib {
         return tmp;
     }
 
+    void StochasticProcessArray::evolveBlock(Time t0, Time dt, Size n,
+                                             const Real* x0,
+                                             const Real* dw,
+                                             Real* x, Size stride) const {
+        const Size m = size();
+        for (Size i=0; i<m; ++i) {
+            const Real* x0i = x0 + i*stride;
+            Real* xi = x + i*stride;
+            for (Size k=0; k<n; ++k) {
+                Real dz = 0.0;
+                for (Size j=0; j<m; ++j)
+                    dz += sqrtCorrelation_[i][j] * dw[j*n+k];
+                xi[k] = processes_[i]->evolve(t0, x0i[k], dt, dz);
+            }
+        }
+    }
+
     Disposable<Array> StochasticProcessArray::apply(const Array& x0,
                                                     const Array& dx) const {
         Array tmp(size());
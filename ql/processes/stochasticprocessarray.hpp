@@ -51,6 +51,9 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                   Time dt, const Array& dw) const;
+        void evolveBlock(Time t0, Time dt, Size n,
+                         const Real* x0, const Real* dw,
+                         Real* x, Size stride) const;
 
         Time time(const Date&) const;
         // inspectors
@@ -59,6 +59,22 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess::evolveBlock(Time t0, Time dt, Size n,
+                                        const Real* x0, const Real* dw,
+                                        Real* x, Size stride) const {
+        const Size m = size(), f = factors();
+        Array state(m), increment(f);
+        for (Size k=0; k<n; ++k) {
+            for (Size i=0; i<m; ++i)
+                state[i] = x0[i*stride+k];
+            for (Size i=0; i<f; ++i)
+                increment[i] = dw[i*n+k];
+            const Array next = evolve(t0, state, dt, increment);
+            for (Size i=0; i<m; ++i)
+                x[i*stride+k] = next[i];
+        }
+    }
+
     Disposable<Array> StochasticProcess::apply(const Array& x0,
                                                const Array& dx) const {
         return x0 + dx;
@@ -123,6 +123,27 @@ namespace QuantLib {
                                          const Array& x0,
                                          Time dt,
                                          const Array& dw) const;
+        /*! evolves a number of asset values over the same time
+            interval \f$ \Delta t \f$.  The values are stored
+            component by component: the \f$ i \f$-th components of
+            the \f$ n \f$ starting values are in
+            <tt>x0[i*stride]</tt> to <tt>x0[i*stride+n-1]</tt>, and
+            the results are stored in the same way into \f$ x \f$.
+            The \f$ i \f$-th components of the Brownian increments
+            are in <tt>dw[i*n]</tt> to <tt>dw[i*n+n-1]</tt>.
+
+            The results are the same that evolve() would return for
+            each value in turn, which is what the default
+            implementation does; derived classes can override it to
+            avoid allocating temporary arrays for each value.
+        */
+        virtual void evolveBlock(Time t0,
+                                 Time dt,
+                                 Size n,
+                                 const Real* x0,
+                                 const Real* dw,
+                                 Real* x,
+                                 Size stride) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ \mathrm{x} + \Delta \mathrm{x} \f$.
         */
@@ -239,6 +260,9 @@ namespace QuantLib {
                                       Time dt) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        void evolveBlock(Time t0, Time dt, Size n,
+                         const Real* x0, const Real* dw,
+                         Real* x, Size stride) const;
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
     };
 
@@ -310,6 +334,14 @@ namespace QuantLib {
         return a;
     }
 
+    inline void StochasticProcess1D::evolveBlock(Time t0, Time dt, Size n,
+                                                 const Real* x0,
+                                                 const Real* dw,
+                                                 Real* x, Size) const {
+        for (Size k=0; k<n; ++k)
+            x[k] = evolve(t0, x0[k], dt, dw[k]);
+    }
+
     inline Disposable<Array> StochasticProcess1D::apply(
                                                       const Array& x0,
                                                       const Array& dx) const {
@@ -36,6 +36,14 @@
 namespace QuantLib {
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! When the curve is bootstrapped again (e.g., after a quote
+        changed) with a local interpolation, the pillars whose
+        helpers are still repriced within the required accuracy by
+        the previous solution are kept, and the bootstrap restarts
+        from the first pillar that is not; the previous solution is
+        used as guess for the following ones.  Global interpolations
+        always need a full pass.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -158,10 +166,24 @@ namespace QuantLib {
 
         Size maxIterations = Traits::maxIterations()-1;
 
+        // with a local interpolation, the pillars up to i only
+        // depend on the helpers up to i; skip those still repriced
+        Size firstPillar = 1;
+        if (validCurve_ && !Interpolator::global) {
+            try {
+                while (firstPillar <= alive_ &&
+                       std::fabs((*errors_[firstPillar])(data[firstPillar]))
+                                                                <= accuracy)
+                    ++firstPillar;
+            } catch (...) {
+                // restart from the pillar that couldn't be repriced
+            }
+        }
+
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 bool validData = validCurve_ || iteration>0;
 
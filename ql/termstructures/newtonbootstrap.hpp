@@ -0,0 +1,441 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2013 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file newtonbootstrap.hpp
+    \brief global Newton bootstrapper for piecewise yield curves
+*/
+
+#ifndef quantlib_newton_bootstrap_hpp
+#define quantlib_newton_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/utilities/dataformatters.hpp>
+
+namespace QuantLib {
+
+    //! Global Newton bootstrapper for piecewise yield curves
+    /*! All the curve nodes are solved for at once by means of a
+        multi-dimensional Newton method on the quote errors of the
+        alive helpers.
+
+        The Jacobian of the implied quotes with respect to the nodes
+        is built by chaining the analytic derivatives of the quotes
+        with respect to discount factors, as returned by helpers
+        implementing AnalyticRateHelper, with the derivatives of the
+        discount factors with respect to the nodes; the latter are
+        obtained by bumping the nodes and only require evaluating the
+        interpolation.  Other helpers are repriced on bumped curves.
+
+        The Jacobian at the solution is kept and can be retrieved
+        after the curve is bootstrapped, together with its inverse,
+        i.e., the derivatives of the nodes with respect to the
+        quotes.  Given the derivatives of the value of an instrument
+        with respect to the discount factors of the curve, its
+        derivatives with respect to the nodes can also be obtained;
+        together with the Jacobian, they yield its sensitivities to
+        the quotes without bootstrapping the curve again.
+
+        \warning the method is only locally convergent; full Newton
+                 steps are halved while they don't reduce the error.
+    */
+    template <class Curve>
+    class NewtonBootstrap {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+      public:
+        NewtonBootstrap();
+        void setup(Curve* ts);
+        void calculate() const;
+        /*! derivatives of the implied quotes of the alive helpers
+            (rows) with respect to the curve nodes after the first
+            (columns), at the solution.
+        */
+        const Matrix& jacobian() const;
+        /*! derivatives of the curve nodes after the first (rows)
+            with respect to the quotes of the alive helpers
+            (columns), at the solution.
+        */
+        const Matrix& inverseJacobian() const;
+        /*! derivatives of a value with respect to the curve nodes
+            after the first, given its derivatives with respect to
+            the discount factors at the given dates.
+        */
+        Disposable<Array> dataSensitivities(
+                       const std::vector<Date>& dates,
+                       const std::vector<Real>& discountSensitivities) const;
+      private:
+        void initialize() const;
+        void errors(Array& result) const;
+        void setupHelpers() const;
+        void computeJacobian() const;
+        void setNode(Size k, Real value) const;
+        static Real maxError(const Array& errors);
+        Curve* ts_;
+        Size n_;
+        mutable bool initialized_, validCurve_, jacobianValid_;
+        mutable bool inverseValid_;
+        mutable Size firstAliveHelper_, alive_;
+        mutable Matrix jacobian_, inverseJacobian_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    NewtonBootstrap<Curve>::NewtonBootstrap()
+    : ts_(0), initialized_(false), validCurve_(false),
+      jacobianValid_(false), inverseValid_(false) {}
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        for (Size j=0; j<n_; ++j)
+            ts_->registerWith(ts_->instruments_[j]);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    const Matrix& NewtonBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped");
+        if (!jacobianValid_) {
+            setupHelpers();
+            computeJacobian();
+            jacobianValid_ = true;
+        }
+        return jacobian_;
+    }
+
+    template <class Curve>
+    const Matrix& NewtonBootstrap<Curve>::inverseJacobian() const {
+        if (!inverseValid_) {
+            inverseJacobian_ = inverse(jacobian());
+            inverseValid_ = true;
+        }
+        return inverseJacobian_;
+    }
+
+    template <class Curve>
+    Disposable<Array> NewtonBootstrap<Curve>::dataSensitivities(
+                const std::vector<Date>& dates,
+                const std::vector<Real>& discountSensitivities) const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped");
+        QL_REQUIRE(dates.size() == discountSensitivities.size(),
+                   "number of dates (" << dates.size() <<
+                   ") and of sensitivities (" <<
+                   discountSensitivities.size() << ") do not match");
+
+        std::vector<Time> times(dates.size());
+        for (Size m=0; m<dates.size(); ++m)
+            times[m] = ts_->timeFromReference(dates[m]);
+
+        // see computeJacobian()
+        static const Real h = 1.0e-6;
+        Array result(alive_, 0.0);
+        for (Size k=1; k<=alive_; ++k) {
+            Real node = ts_->data_[k];
+            Real bump = h*std::max(1.0, std::fabs(node));
+
+            setNode(k, node+bump);
+            for (Size m=0; m<times.size(); ++m)
+                result[k-1] += discountSensitivities[m] *
+                               ts_->discount(times[m], true);
+
+            setNode(k, node-bump);
+            for (Size m=0; m<times.size(); ++m)
+                result[k-1] -= discountSensitivities[m] *
+                               ts_->discount(times[m], true);
+
+            setNode(k, node);
+            result[k-1] /= 2.0*bump;
+        }
+        return result;
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::initialize() const {
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_[n_-1]->latestDate()>firstDate,
+                   "all instruments expired");
+        firstAliveHelper_ = 0;
+        while (ts_->instruments_[firstAliveHelper_]->latestDate() <= firstDate)
+            ++firstAliveHelper_;
+        alive_ = n_-firstAliveHelper_;
+        QL_REQUIRE(alive_>=Interpolator::requiredPoints-1,
+                   "not enough alive instruments: " << alive_ <<
+                   " provided, " << Interpolator::requiredPoints-1 <<
+                   " required");
+
+        // calculate dates and times
+        std::vector<Date>& dates = ts_->dates_;
+        std::vector<Time>& times = ts_->times_;
+        dates.resize(alive_+1);
+        times.resize(alive_+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(dates[0]);
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            dates[i] = ts_->instruments_[j]->latestDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            // check for duplicated maturity
+            QL_REQUIRE(dates[i-1]!=dates[i],
+                       "more than one instrument with maturity " << dates[i]);
+        }
+
+        if (ts_->data_.size()!=alive_+1) {
+            ts_->data_ = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
+            validCurve_ = false;
+        }
+
+        ts_->interpolation_ = ts_->interpolator_.interpolate(
+                                                     times.begin(), times.end(),
+                                                     ts_->data_.begin());
+        initialized_ = true;
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::setNode(Size k, Real value) const {
+        Traits::updateGuess(ts_->data_, value, k);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    Real NewtonBootstrap<Curve>::maxError(const Array& errors) {
+        Real result = 0.0;
+        for (Size i=0; i<errors.size(); ++i)
+            result = std::max(result, std::fabs(errors[i]));
+        return result;
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::errors(Array& result) const {
+        for (Size i=0; i<alive_; ++i) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                      ts_->instruments_[firstAliveHelper_+i];
+            result[i] = helper->impliedQuote() - helper->quote()->value();
+        }
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::setupHelpers() const {
+        for (Size j=firstAliveHelper_; j<n_; ++j) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            // check for valid quote
+            QL_REQUIRE(helper->quote()->isValid(),
+                       io::ordinal(j+1) << " instrument (maturity: " <<
+                       helper->latestDate() << ") has an invalid quote");
+            // don't try this at home!
+            // This call creates helpers, and removes "const".
+            // There is a significant interaction with observability.
+            helper->setTermStructure(const_cast<Curve*>(ts_));
+        }
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::computeJacobian() const {
+        jacobian_ = Matrix(alive_, alive_, 0.0);
+
+        // analytic derivatives with respect to discount factors...
+        std::vector<std::vector<Date> > dates(alive_);
+        std::vector<std::vector<Real> > sensitivities(alive_);
+        std::vector<Date> allDates;
+        std::vector<Size> others;
+        for (Size i=0; i<alive_; ++i) {
+            const AnalyticRateHelper* helper =
+                dynamic_cast<const AnalyticRateHelper*>(
+                          ts_->instruments_[firstAliveHelper_+i].get());
+            if (helper != 0) {
+                helper->discountSensitivities(dates[i], sensitivities[i]);
+                allDates.insert(allDates.end(),
+                                dates[i].begin(), dates[i].end());
+            } else {
+                others.push_back(i);
+            }
+        }
+
+        // helpers share most of their dates
+        std::sort(allDates.begin(), allDates.end());
+        allDates.erase(std::unique(allDates.begin(), allDates.end()),
+                       allDates.end());
+        std::vector<Time> times(allDates.size());
+        for (Size m=0; m<allDates.size(); ++m)
+            times[m] = ts_->timeFromReference(allDates[m]);
+        std::vector<std::vector<Size> > positions(alive_);
+        for (Size i=0; i<alive_; ++i) {
+            positions[i].resize(dates[i].size());
+            for (Size m=0; m<dates[i].size(); ++m)
+                positions[i][m] =
+                    std::lower_bound(allDates.begin(), allDates.end(),
+                                     dates[i][m]) - allDates.begin();
+        }
+
+        // ...are chained with the derivatives of the latter with
+        // respect to the nodes; these, as well as the derivatives
+        // of the other helpers, are obtained by central differences
+        static const Real h = 1.0e-6;
+        Array up(others.size()), down(others.size());
+        Array upDiscounts(times.size()), downDiscounts(times.size());
+        for (Size k=1; k<=alive_; ++k) {
+            Real node = ts_->data_[k];
+            Real bump = h*std::max(1.0, std::fabs(node));
+
+            setNode(k, node+bump);
+            for (Size m=0; m<times.size(); ++m)
+                upDiscounts[m] = ts_->discount(times[m], true);
+            for (Size l=0; l<others.size(); ++l)
+                up[l] = ts_->instruments_[firstAliveHelper_+others[l]]
+                                                          ->impliedQuote();
+
+            setNode(k, node-bump);
+            for (Size m=0; m<times.size(); ++m)
+                downDiscounts[m] = ts_->discount(times[m], true);
+            for (Size l=0; l<others.size(); ++l)
+                down[l] = ts_->instruments_[firstAliveHelper_+others[l]]
+                                                          ->impliedQuote();
+
+            setNode(k, node);
+            for (Size m=0; m<times.size(); ++m)
+                upDiscounts[m] = (upDiscounts[m]-downDiscounts[m])/(2.0*bump);
+            for (Size i=0; i<alive_; ++i) {
+                for (Size m=0; m<positions[i].size(); ++m)
+                    jacobian_[i][k-1] +=
+                        sensitivities[i][m] * upDiscounts[positions[i][m]];
+            }
+            for (Size l=0; l<others.size(); ++l)
+                jacobian_[others[l]][k-1] = (up[l]-down[l])/(2.0*bump);
+        }
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::calculate() const {
+
+        // see IterativeBootstrap::calculate()
+        if (!initialized_ || ts_->moving_)
+            initialize();
+
+        setupHelpers();
+
+        std::vector<Real>& data = ts_->data_;
+        Real accuracy = ts_->accuracy_;
+        Size maxIterations = Traits::maxIterations();
+
+        // the previous solution, if any, is the best guess;
+        // otherwise, start from the guesses of the traits
+        if (!validCurve_) {
+            std::fill(data.begin(), data.end(), Traits::initialValue(ts_));
+            for (Size i=1; i<=alive_; ++i)
+                Traits::updateGuess(data,
+                                    Traits::guess(i, ts_, false,
+                                                  firstAliveHelper_),
+                                    i);
+        }
+        // in the latter case, the Jacobian at the previous solution
+        // is also reused as long as it gives fast convergence
+        bool currentJacobian = false;
+        if (!validCurve_ || jacobian_.rows() != alive_) {
+            ts_->interpolation_.update();
+            computeJacobian();
+            currentJacobian = true;
+        }
+        validCurve_ = inverseValid_ = false;
+        ts_->interpolation_.update();
+
+        Array r(alive_), newR(alive_), x(alive_);
+        errors(r);
+        Real error = maxError(r);
+
+        for (Size iteration=0; error > accuracy; ++iteration) {
+            QL_REQUIRE(iteration < maxIterations,
+                       "convergence not reached after " << iteration <<
+                       " iterations; last error " << error <<
+                       ", required accuracy " << accuracy);
+
+            Array step = qrSolve(jacobian_, -r);
+            for (Size k=0; k<alive_; ++k)
+                x[k] = data[k+1];
+
+            // the step is halved until the error decreases; steps
+            // below the required accuracy are taken in any case
+            Real lambda = 1.0, change = maxError(step);
+            bool accepted = false, slow = false;
+            for (;;) {
+                for (Size k=0; k<alive_; ++k)
+                    Traits::updateGuess(data, x[k]+lambda*step[k], k+1);
+
+                Real newError = QL_MAX_REAL;
+                try {
+                    ts_->interpolation_.update();
+                    errors(newR);
+                    newError = maxError(newR);
+                } catch (std::exception&) {
+                    // not a valid curve
+                }
+                bool valid = newError < QL_MAX_REAL; // false for NaN
+                if (valid && (newError < error || change <= accuracy)) {
+                    slow = newError > 0.1*error;
+                    r.swap(newR);
+                    error = newError;
+                    accepted = true;
+                    break;
+                }
+
+                // an outdated Jacobian is updated before halving
+                if (!currentJacobian)
+                    break;
+
+                lambda /= 2.0;
+                QL_REQUIRE(lambda*change > QL_EPSILON,
+                           io::ordinal(iteration+1) << " iteration: "
+                           "failed to reduce error " << error <<
+                           ", reference date " << ts_->dates_[0]);
+            }
+
+            if (!accepted) {
+                for (Size k=0; k<alive_; ++k)
+                    Traits::updateGuess(data, x[k], k+1);
+                ts_->interpolation_.update();
+            } else if (change <= accuracy) {
+                currentJacobian = false;
+                break;
+            }
+
+            if (!accepted || slow) {
+                computeJacobian();
+                currentJacobian = true;
+            } else {
+                currentJacobian = false;
+            }
+        }
+        jacobianValid_ = currentJacobian;
+        validCurve_ = true;
+    }
+
+}
+
+#endif
@@ -21,6 +21,8 @@
 #include <ql/termstructures/yield/oisratehelper.hpp>
 #include <ql/instruments/makeois.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
+#include <ql/indexes/indexmanager.hpp>
 
 using boost::shared_ptr;
 
@@ -28,6 +30,58 @@ namespace QuantLib {
 
     namespace {
         void no_deletion(YieldTermStructure*) {}
+
+        void addOISSensitivities(
+                       const OvernightIndexedSwap& swap,
+                       const YieldTermStructure& forecastCurve,
+                       const Handle<YieldTermStructure>& discountHandle,
+                       std::vector<Date>& dates,
+                       std::vector<Real>& sensitivities) {
+
+            const Leg& overnightLeg = swap.overnightLeg();
+            Size n = overnightLeg.size();
+            std::vector<Date> starts(n), ends(n);
+            std::vector<Real> weights(n, 0.0);
+            Date today = Settings::instance().evaluationDate();
+            for (Size j=0; j<n; ++j) {
+                shared_ptr<OvernightIndexedCoupon> c =
+                    boost::dynamic_pointer_cast<OvernightIndexedCoupon>(
+                                                          overnightLeg[j]);
+                QL_REQUIRE(c, "overnight-leg cash flow is not an "
+                              "overnight-indexed coupon");
+                const std::vector<Date>& fixingDates = c->fixingDates();
+                const std::vector<Time>& dt = c->dt();
+                const TimeSeries<Real>& history =
+                    IndexManager::instance().getHistory(c->index()->name());
+
+                // same split as the coupon pricer: past fixings are
+                // compounded, the rest is forecast as D(start)/D(end)
+                Size m = dt.size(), i = 0;
+                Real compoundFactor = 1.0;
+                while (i<m && (fixingDates[i]<today ||
+                               (fixingDates[i]==today &&
+                                history[today]!=Null<Real>()))) {
+                    compoundFactor *= 1.0 + history[fixingDates[i]]*dt[i];
+                    ++i;
+                }
+                if (i<m) {
+                    // amount = N*(g*(P*D(s)/D(e)-1) + tau*s)
+                    starts[j] = c->valueDates()[i];
+                    ends[j] = c->valueDates()[m];
+                    weights[j] = c->nominal()*c->gearing()*compoundFactor;
+                }
+            }
+
+            bool ownDiscount = discountHandle.empty();
+            const YieldTermStructure& discountCurve =
+                ownDiscount ? forecastCurve : **discountHandle;
+            detail::addSwapRateSensitivities(swap.fixedLeg(), overnightLeg,
+                                             starts, ends, weights, 0.0,
+                                             forecastCurve, discountCurve,
+                                             ownDiscount, dates,
+                                             sensitivities);
+        }
+
     }
 
     OISRateHelper::OISRateHelper(
@@ -86,6 +140,14 @@ namespace QuantLib {
         return swap_->fairRate();
     }
 
+    void OISRateHelper::discountSensitivities(
+                             std::vector<Date>& dates,
+                             std::vector<Real>& sensitivities) const {
+        QL_REQUIRE(termStructure_ != 0, "term structure not set");
+        addOISSensitivities(*swap_, *termStructure_, discountHandle_,
+                            dates, sensitivities);
+    }
+
     void OISRateHelper::accept(AcyclicVisitor& v) {
         Visitor<OISRateHelper>* v1 =
             dynamic_cast<Visitor<OISRateHelper>*>(&v);
@@ -147,6 +209,14 @@ namespace QuantLib {
         return swap_->fairRate();
     }
 
+    void DatedOISRateHelper::discountSensitivities(
+                             std::vector<Date>& dates,
+                             std::vector<Real>& sensitivities) const {
+        QL_REQUIRE(termStructure_ != 0, "term structure not set");
+        addOISSensitivities(*swap_, *termStructure_, discountHandle_,
+                            dates, sensitivities);
+    }
+
     void DatedOISRateHelper::accept(AcyclicVisitor& v) {
         Visitor<DatedOISRateHelper>* v1 =
             dynamic_cast<Visitor<DatedOISRateHelper>*>(&v);
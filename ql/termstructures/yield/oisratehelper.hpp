@@ -31,7 +31,8 @@
 namespace QuantLib {
 
     //! Rate helper for bootstrapping over Overnight Indexed Swap rates
-    class OISRateHelper : public RelativeDateRateHelper {
+    class OISRateHelper : public RelativeDateRateHelper,
+                          public AnalyticRateHelper {
       public:
         OISRateHelper(Natural settlementDays,
                       const Period& tenor, // swap maturity
@@ -45,6 +46,11 @@ namespace QuantLib {
         Real impliedQuote() const;
         void setTermStructure(YieldTermStructure*);
         //@}
+        //! \name AnalyticRateHelper interface
+        //@{
+        void discountSensitivities(std::vector<Date>& dates,
+                                   std::vector<Real>& sensitivities) const;
+        //@}
         //! \name inspectors
         //@{
         boost::shared_ptr<OvernightIndexedSwap> swap() const { return swap_; }
@@ -68,7 +74,8 @@ namespace QuantLib {
     };
 
     //! Rate helper for bootstrapping over Overnight Indexed Swap rates
-    class DatedOISRateHelper : public RateHelper {
+    class DatedOISRateHelper : public RateHelper,
+                               public AnalyticRateHelper {
       public:
         DatedOISRateHelper(
                     const Date& startDate,
@@ -83,6 +90,11 @@ namespace QuantLib {
         Real impliedQuote() const;
         void setTermStructure(YieldTermStructure*);
         //@}
+        //! \name AnalyticRateHelper interface
+        //@{
+        void discountSensitivities(std::vector<Date>& dates,
+                                   std::vector<Real>& sensitivities) const;
+        //@}
         //! \name Visitability
         //@{
         void accept(AcyclicVisitor&);
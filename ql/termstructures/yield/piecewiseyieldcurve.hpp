@@ -28,6 +28,7 @@
 
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
+#include <ql/termstructures/newtonbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 
@@ -167,6 +168,37 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Bootstrap results
+        //@{
+        /*! derivatives of the implied quotes of the alive helpers
+            with respect to the curve data after the first.
+
+            \note only available with bootstrappers providing it,
+                  such as NewtonBootstrap.
+        */
+        const Matrix& jacobian() const;
+        /*! derivatives of the curve data after the first with
+            respect to the quotes of the alive helpers, i.e., the
+            inverse of the Jacobian.
+
+            \note only available with bootstrappers providing it,
+                  such as NewtonBootstrap.
+        */
+        const Matrix& inverseJacobian() const;
+        /*! derivatives of a value with respect to the curve data
+            after the first, given its derivatives with respect to
+            the discount factors at the given dates.  Combined with
+            the Jacobian, they give the derivatives of the value
+            with respect to the quotes without bootstrapping the
+            curve again; see bucketDeltaFromJacobian().
+
+            \note only available with bootstrappers providing it,
+                  such as NewtonBootstrap.
+        */
+        Disposable<Array> dataSensitivities(
+                       const std::vector<Date>& dates,
+                       const std::vector<Real>& discountSensitivities) const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -226,6 +258,26 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseYieldCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseYieldCurve<C,I,B>::inverseJacobian() const {
+        calculate();
+        return bootstrap_.inverseJacobian();
+    }
+
+    template <class C, class I, template <class> class B>
+    inline Disposable<Array> PiecewiseYieldCurve<C,I,B>::dataSensitivities(
+                const std::vector<Date>& dates,
+                const std::vector<Real>& discountSensitivities) const {
+        calculate();
+        return bootstrap_.dataSensitivities(dates, discountSensitivities);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
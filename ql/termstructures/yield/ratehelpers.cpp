@@ -27,6 +27,7 @@
 #include <ql/quote.hpp>
 #include <ql/currency.hpp>
 #include <ql/indexes/swapindex.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
 #ifdef QL_USE_INDEXED_COUPON
     #include <ql/cashflows/floatingratecoupon.hpp>
 #endif
@@ -37,6 +38,127 @@ namespace QuantLib {
 
     namespace {
         void no_deletion(YieldTermStructure*) {}
+
+        // the forecast (D(d1)/D(d2)-1)/t used by deposits and FRAs
+        void addFixingSensitivities(const IborIndex& index,
+                                    const Date& fixingDate,
+                                    const YieldTermStructure& curve,
+                                    std::vector<Date>& dates,
+                                    std::vector<Real>& sensitivities) {
+            if (fixingDate < Settings::instance().evaluationDate())
+                return; // past fixing, no dependency on the curve
+            Date d1 = index.valueDate(fixingDate);
+            Date d2 = index.maturityDate(d1);
+            Time t = index.dayCounter().yearFraction(d1, d2);
+            DiscountFactor disc1 = curve.discount(d1);
+            DiscountFactor disc2 = curve.discount(d2);
+            dates.push_back(d1);
+            sensitivities.push_back(1.0/(t*disc2));
+            dates.push_back(d2);
+            sensitivities.push_back(-disc1/(t*disc2*disc2));
+        }
+
+        // mirrors the logic of IborCoupon::indexFixing()
+        bool isForecast(const InterestRateIndex& index,
+                        const Date& fixingDate) {
+            Date today = Settings::instance().evaluationDate();
+            if (fixingDate != today)
+                return fixingDate > today;
+            if (Settings::instance().enforcesTodaysHistoricFixings())
+                return false;
+            try {
+                return index.pastFixing(fixingDate) == Null<Real>();
+            } catch (Error&) {
+                return true;
+            }
+        }
+
+    }
+
+    namespace detail {
+
+        void addSwapRateSensitivities(
+                             const Leg& fixedLeg,
+                             const Leg& floatingLeg,
+                             const std::vector<Date>& forecastStarts,
+                             const std::vector<Date>& forecastEnds,
+                             const std::vector<Real>& forecastWeights,
+                             Spread spread,
+                             const YieldTermStructure& forecastCurve,
+                             const YieldTermStructure& discountCurve,
+                             bool discountSensitivities,
+                             std::vector<Date>& dates,
+                             std::vector<Real>& sensitivities) {
+
+            // same flows as used by DiscountingSwapEngine
+            Date refDate = discountCurve.referenceDate();
+
+            std::vector<shared_ptr<Coupon> > fixedCoupons;
+            Real fixedAnnuity = 0.0;
+            for (Size i=0; i<fixedLeg.size(); ++i) {
+                shared_ptr<Coupon> c =
+                    boost::dynamic_pointer_cast<Coupon>(fixedLeg[i]);
+                if (c && !c->hasOccurred(refDate)) {
+                    fixedAnnuity += c->nominal()*c->accrualPeriod()*
+                                    discountCurve.discount(c->date());
+                    fixedCoupons.push_back(c);
+                }
+            }
+            QL_REQUIRE(fixedAnnuity != 0.0, "null fixed-leg annuity");
+
+            std::vector<Size> alive;
+            std::vector<DiscountFactor> discounts;
+            Real floatingNPV = 0.0, floatingAnnuity = 0.0;
+            for (Size j=0; j<floatingLeg.size(); ++j) {
+                shared_ptr<Coupon> c =
+                    boost::dynamic_pointer_cast<Coupon>(floatingLeg[j]);
+                QL_REQUIRE(c, "floating-leg cash flow is not a coupon");
+                if (!c->hasOccurred(refDate)) {
+                    DiscountFactor discount = discountCurve.discount(c->date());
+                    floatingNPV += c->amount()*discount;
+                    floatingAnnuity +=
+                        c->nominal()*c->accrualPeriod()*discount;
+                    alive.push_back(j);
+                    discounts.push_back(discount);
+                }
+            }
+
+            Rate fairRate =
+                (floatingNPV + spread*floatingAnnuity)/fixedAnnuity;
+
+            if (discountSensitivities) {
+                for (Size i=0; i<fixedCoupons.size(); ++i) {
+                    const shared_ptr<Coupon>& c = fixedCoupons[i];
+                    dates.push_back(c->date());
+                    sensitivities.push_back(
+                        -fairRate*c->nominal()*c->accrualPeriod()/fixedAnnuity);
+                }
+            }
+
+            for (Size k=0; k<alive.size(); ++k) {
+                Size j = alive[k];
+                shared_ptr<Coupon> c =
+                    boost::static_pointer_cast<Coupon>(floatingLeg[j]);
+                if (discountSensitivities) {
+                    dates.push_back(c->date());
+                    sensitivities.push_back(
+                        (c->amount() + spread*c->nominal()*c->accrualPeriod())
+                        / fixedAnnuity);
+                }
+                if (forecastStarts[j] != Date()) {
+                    DiscountFactor start =
+                        forecastCurve.discount(forecastStarts[j]);
+                    DiscountFactor end =
+                        forecastCurve.discount(forecastEnds[j]);
+                    Real w = forecastWeights[j]*discounts[k]/fixedAnnuity;
+                    dates.push_back(forecastStarts[j]);
+                    sensitivities.push_back(w/end);
+                    dates.push_back(forecastEnds[j]);
+                    sensitivities.push_back(-w*start/(end*end));
+                }
+            }
+        }
+
     }
 
     FuturesRateHelper::FuturesRateHelper(const Handle<Quote>& price,
@@ -247,6 +369,14 @@ namespace QuantLib {
         return iborIndex_->fixing(fixingDate_, true);
     }
 
+    void DepositRateHelper::discountSensitivities(
+                             std::vector<Date>& dates,
+                             std::vector<Real>& sensitivities) const {
+        QL_REQUIRE(termStructure_ != 0, "term structure not set");
+        addFixingSensitivities(*iborIndex_, fixingDate_, *termStructure_,
+                               dates, sensitivities);
+    }
+
     void DepositRateHelper::setTermStructure(YieldTermStructure* t) {
         // no need to register---the index is not lazy
         termStructureHandle_.linkTo(
@@ -415,6 +545,14 @@ namespace QuantLib {
         return iborIndex_->fixing(fixingDate_, true);
     }
 
+    void FraRateHelper::discountSensitivities(
+                             std::vector<Date>& dates,
+                             std::vector<Real>& sensitivities) const {
+        QL_REQUIRE(termStructure_ != 0, "term structure not set");
+        addFixingSensitivities(*iborIndex_, fixingDate_, *termStructure_,
+                               dates, sensitivities);
+    }
+
     void FraRateHelper::setTermStructure(YieldTermStructure* t) {
         // no need to register---the index is not lazy
         termStructureHandle_.linkTo(
@@ -617,6 +755,39 @@ namespace QuantLib {
         return result;
     }
 
+    void SwapRateHelper::discountSensitivities(
+                             std::vector<Date>& dates,
+                             std::vector<Real>& sensitivities) const {
+        QL_REQUIRE(termStructure_ != 0, "term structure not set");
+
+        const Leg& floatingLeg = swap_->floatingLeg();
+        Size n = floatingLeg.size();
+        std::vector<Date> starts(n), ends(n);
+        std::vector<Real> weights(n, 0.0);
+        for (Size j=0; j<n; ++j) {
+            shared_ptr<IborCoupon> c =
+                boost::dynamic_pointer_cast<IborCoupon>(floatingLeg[j]);
+            QL_REQUIRE(c && !c->isInArrears(),
+                       "analytic sensitivities not available for "
+                       "non-standard floating coupons");
+            if (isForecast(*c->index(), c->fixingDate())) {
+                // amount = N*tau*(g*(D(v)/D(e)-1)/T + s)
+                starts[j] = c->fixingValueDate();
+                ends[j] = c->fixingEndDate();
+                weights[j] = c->nominal()*c->accrualPeriod()*c->gearing()
+                           / c->spanningTime();
+            }
+        }
+
+        bool ownDiscount = discountHandle_.empty();
+        const YieldTermStructure& discountCurve =
+            ownDiscount ? *termStructure_ : **discountHandle_;
+        detail::addSwapRateSensitivities(swap_->fixedLeg(), floatingLeg,
+                                         starts, ends, weights, spread(),
+                                         *termStructure_, discountCurve,
+                                         ownDiscount, dates, sensitivities);
+    }
+
     void SwapRateHelper::accept(AcyclicVisitor& v) {
         Visitor<SwapRateHelper>* v1 =
             dynamic_cast<Visitor<SwapRateHelper>*>(&v);
@@ -42,6 +42,51 @@ namespace QuantLib {
     typedef RelativeDateBootstrapHelper<YieldTermStructure>
                                                         RelativeDateRateHelper;
 
+    //! rate helper with analytic sensitivities of its implied quote
+    /*! Helpers implementing this interface write their implied quote
+        as a function of the discount factors, at a few dates, of the
+        term structure being bootstrapped.  NewtonBootstrap uses them
+        to build its Jacobian without repricing the instruments.
+    */
+    class AnalyticRateHelper {
+      public:
+        virtual ~AnalyticRateHelper() {}
+        /*! returns the dates on whose discount factors the implied
+            quote depends, together with the corresponding partial
+            derivatives.  Dates can be repeated, in which case the
+            derivatives add up.  The term structure must have been
+            set to the helper.
+        */
+        virtual void discountSensitivities(
+                             std::vector<Date>& dates,
+                             std::vector<Real>& sensitivities) const = 0;
+    };
+
+    namespace detail {
+
+        /* Adds the sensitivities of the fair rate (F+sB)/A of a swap,
+           F being the NPV of the floating leg and A and B the annuities
+           of the fixed and floating legs.  The j-th floating coupon
+           pays w[j]*D(start[j])/D(end[j]) plus a constant on the
+           forecasting curve; a null start marks a fixed coupon.
+           Discount factors are taken into account only when the
+           discounting curve is the one being bootstrapped.
+        */
+        void addSwapRateSensitivities(
+                             const Leg& fixedLeg,
+                             const Leg& floatingLeg,
+                             const std::vector<Date>& forecastStarts,
+                             const std::vector<Date>& forecastEnds,
+                             const std::vector<Real>& forecastWeights,
+                             Spread spread,
+                             const YieldTermStructure& forecastCurve,
+                             const YieldTermStructure& discountCurve,
+                             bool discountSensitivities,
+                             std::vector<Date>& dates,
+                             std::vector<Real>& sensitivities);
+
+    }
+
     //! Rate helper for bootstrapping over IborIndex futures prices
     class FuturesRateHelper : public RateHelper {
       public:
@@ -98,7 +143,8 @@ namespace QuantLib {
 
 
     //! Rate helper for bootstrapping over deposit rates
-    class DepositRateHelper : public RelativeDateRateHelper {
+    class DepositRateHelper : public RelativeDateRateHelper,
+                              public AnalyticRateHelper {
       public:
         DepositRateHelper(const Handle<Quote>& rate,
                           const Period& tenor,
@@ -123,6 +169,11 @@ namespace QuantLib {
         Real impliedQuote() const;
         void setTermStructure(YieldTermStructure*);
         //@}
+        //! \name AnalyticRateHelper interface
+        //@{
+        void discountSensitivities(std::vector<Date>& dates,
+                                   std::vector<Real>& sensitivities) const;
+        //@}
         //! \name Visitability
         //@{
         void accept(AcyclicVisitor&);
@@ -136,7 +187,8 @@ namespace QuantLib {
 
 
     //! Rate helper for bootstrapping over %FRA rates
-    class FraRateHelper : public RelativeDateRateHelper {
+    class FraRateHelper : public RelativeDateRateHelper,
+                          public AnalyticRateHelper {
       public:
         FraRateHelper(const Handle<Quote>& rate,
                       Natural monthsToStart,
@@ -187,6 +239,11 @@ namespace QuantLib {
         Real impliedQuote() const;
         void setTermStructure(YieldTermStructure*);
         //@}
+        //! \name AnalyticRateHelper interface
+        //@{
+        void discountSensitivities(std::vector<Date>& dates,
+                                   std::vector<Real>& sensitivities) const;
+        //@}
         //! \name Visitability
         //@{
         void accept(AcyclicVisitor&);
@@ -201,7 +258,8 @@ namespace QuantLib {
 
     //! Rate helper for bootstrapping over swap rates
     /*! \todo use input SwapIndex to create the swap */
-    class SwapRateHelper : public RelativeDateRateHelper {
+    class SwapRateHelper : public RelativeDateRateHelper,
+                           public AnalyticRateHelper {
       public:
         SwapRateHelper(const Handle<Quote>& rate,
                        const boost::shared_ptr<SwapIndex>& swapIndex,
@@ -250,6 +308,11 @@ namespace QuantLib {
         Real impliedQuote() const;
         void setTermStructure(YieldTermStructure*);
         //@}
+        //! \name AnalyticRateHelper interface
+        //@{
+        void discountSensitivities(std::vector<Date>& dates,
+                                   std::vector<Real>& sensitivities) const;
+        //@}
         //! \name SwapRateHelper inspectors
         //@{
         Spread spread() const;
@@ -28,8 +28,12 @@
 #include <ql/pricingengines/vanilla/juquadraticengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdshoutengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <map>
 
@@ -556,6 +560,160 @@ void AmericanOptionTest::testFdShoutGreeks() {
     testFdGreeks<FDShoutEngine<CrankNicolson> >();
 }
 
+void AmericanOptionTest::testFdMultipleStrikesEngine() {
+    BOOST_MESSAGE("Testing multiple-strikes FD Black-Scholes engine...");
+
+    SavedSettings backup;
+
+    Date today(27, December, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    DayCounter dc = Actual360();
+    Date exDate = today + 360;
+    boost::shared_ptr<Exercise> americanExercise(
+                                         new AmericanExercise(today, exDate));
+    boost::shared_ptr<Exercise> europeanExercise(
+                                         new EuropeanExercise(exDate));
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(100.0))),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+
+    std::vector<Real> strikes;
+    strikes.push_back(80.0);  strikes.push_back(90.0);
+    strikes.push_back(95.0);  strikes.push_back(105.0);
+    strikes.push_back(110.0); strikes.push_back(120.0);
+
+    boost::shared_ptr<PricingEngine> analyticEngine(
+                                       new AnalyticEuropeanEngine(process));
+    boost::shared_ptr<FdBlackScholesVanillaEngine> singleStrikeEngine(
+                   new FdBlackScholesVanillaEngine(process, 100, 400));
+    boost::shared_ptr<FdBlackScholesVanillaEngine> multiStrikeEngine(
+                   new FdBlackScholesVanillaEngine(process, 100, 400));
+    multiStrikeEngine->enableMultipleStrikesCaching(strikes);
+
+    // the European options are checked against the analytic greeks,
+    // the American ones against the single-strike engine; gamma and
+    // theta of the latter are too sensitive to the mesh near the
+    // exercise boundary to be compared.
+    const Real tol[] = { 1.0e-4, 1.0e-3, 2.0e-3, 2.0e-3 };
+    const Real americanTol = 1.0e-3;
+
+    for (Size i=0; i < strikes.size(); ++i) {
+        boost::shared_ptr<StrikedTypePayoff> payoff(
+                           new PlainVanillaPayoff(Option::Put, strikes[i]));
+
+        VanillaOption europeanOption(payoff, europeanExercise);
+        europeanOption.setPricingEngine(multiStrikeEngine);
+        const Real calculated[] = { europeanOption.NPV(),
+                                    europeanOption.delta(),
+                                    europeanOption.gamma(),
+                                    europeanOption.theta() };
+
+        europeanOption.setPricingEngine(analyticEngine);
+        const Real expected[] = { europeanOption.NPV(),
+                                  europeanOption.delta(),
+                                  europeanOption.gamma(),
+                                  europeanOption.theta() };
+
+        const std::string names[] = { "value", "delta", "gamma", "theta" };
+        for (Size j=0; j < LENGTH(names); ++j) {
+            if (std::fabs((calculated[j]-expected[j])/expected[j]) > tol[j])
+                BOOST_FAIL("failed to reproduce European " << names[j]
+                           << " with FD multi strike engine"
+                           << "\n    strike:     " << strikes[i]
+                           << "\n    calculated: " << calculated[j]
+                           << "\n    expected:   " << expected[j]
+                           << "\n    tolerance:  "
+                           << QL_SCIENTIFIC << tol[j]);
+        }
+
+        VanillaOption americanOption(payoff, americanExercise);
+        americanOption.setPricingEngine(multiStrikeEngine);
+        const Real npvCalculated   = americanOption.NPV();
+        const Real deltaCalculated = americanOption.delta();
+
+        americanOption.setPricingEngine(singleStrikeEngine);
+        const Real npvExpected   = americanOption.NPV();
+        const Real deltaExpected = americanOption.delta();
+
+        if (std::fabs((npvCalculated-npvExpected)/npvExpected)
+                                                           > americanTol) {
+            BOOST_FAIL("failed to reproduce American value "
+                       "with FD multi strike engine"
+                       << "\n    strike:     " << strikes[i]
+                       << "\n    calculated: " << npvCalculated
+                       << "\n    expected:   " << npvExpected
+                       << "\n    tolerance:  "
+                       << QL_SCIENTIFIC << americanTol);
+        }
+        if (std::fabs((deltaCalculated-deltaExpected)/deltaExpected)
+                                                           > americanTol) {
+            BOOST_FAIL("failed to reproduce American delta "
+                       "with FD multi strike engine"
+                       << "\n    strike:     " << strikes[i]
+                       << "\n    calculated: " << deltaCalculated
+                       << "\n    expected:   " << deltaExpected
+                       << "\n    tolerance:  "
+                       << QL_SCIENTIFIC << americanTol);
+        }
+    }
+
+    // with a smile, the options must be priced with their own
+    // volatility, as the single-strike engine does
+    std::vector<Date> smileDates(1, exDate);
+    smileDates.push_back(exDate + 360);
+    std::vector<Real> smileStrikes(1, 70.0);
+    smileStrikes.push_back(100.0);
+    smileStrikes.push_back(130.0);
+    Matrix smileVols(3, 2);
+    smileVols[0][0] = 0.40; smileVols[0][1] = 0.38;
+    smileVols[1][0] = 0.25; smileVols[1][1] = 0.25;
+    smileVols[2][0] = 0.30; smileVols[2][1] = 0.29;
+    boost::shared_ptr<BlackScholesMertonProcess> smileProcess(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(100.0))),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(
+                boost::shared_ptr<BlackVolTermStructure>(
+                    new BlackVarianceSurface(today, NullCalendar(),
+                                             smileDates, smileStrikes,
+                                             smileVols, dc)))));
+
+    singleStrikeEngine = boost::shared_ptr<FdBlackScholesVanillaEngine>(
+                   new FdBlackScholesVanillaEngine(smileProcess, 100, 400));
+    multiStrikeEngine = boost::shared_ptr<FdBlackScholesVanillaEngine>(
+                   new FdBlackScholesVanillaEngine(smileProcess, 100, 400));
+    multiStrikeEngine->enableMultipleStrikesCaching(strikes);
+
+    for (Size i=0; i < strikes.size(); ++i) {
+        boost::shared_ptr<StrikedTypePayoff> payoff(
+                           new PlainVanillaPayoff(Option::Put, strikes[i]));
+
+        VanillaOption option(payoff, americanExercise);
+        option.setPricingEngine(multiStrikeEngine);
+        const Real npvCalculated = option.NPV();
+
+        option.setPricingEngine(singleStrikeEngine);
+        const Real npvExpected = option.NPV();
+
+        if (std::fabs((npvCalculated-npvExpected)/npvExpected)
+                                                           > americanTol) {
+            BOOST_FAIL("failed to reproduce American value "
+                       "with FD multi strike engine and smile"
+                       << "\n    strike:     " << strikes[i]
+                       << "\n    calculated: " << npvCalculated
+                       << "\n    expected:   " << npvExpected
+                       << "\n    tolerance:  "
+                       << QL_SCIENTIFIC << americanTol);
+        }
+    }
+}
+
 test_suite* AmericanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("American option tests");
     suite->add(
@@ -570,6 +728,8 @@ test_suite* AmericanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
+    suite->add(
+        QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdMultipleStrikesEngine));
     return suite;
 }
 
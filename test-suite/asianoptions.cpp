@@ -30,6 +30,7 @@
 #include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_strike.hpp>
 #include <ql/pricingengines/asian/fdblackscholesasianengine.hpp>
+#include <ql/math/randomnumbers/haltonrsg.hpp>
 #include <ql/experimental/exoticoptions/continuousarithmeticasianlevyengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -79,6 +80,18 @@ namespace {
             QL_FAIL("unknown averaging");
     }
 
+    // forwards to another pricer, hiding its batch interface
+    class PathByPathPricer : public PathPricer<Path> {
+      public:
+        PathByPathPricer(const boost::shared_ptr<PathPricer<Path> >& pricer)
+        : pricer_(pricer) {}
+        Real operator()(const Path& path) const {
+            return (*pricer_)(path);
+        }
+      private:
+        boost::shared_ptr<PathPricer<Path> > pricer_;
+    };
+
 }
 
 
@@ -1232,6 +1245,122 @@ void AsianOptionTest::testLevyEngine() {
     }
 }
 
+void AsianOptionTest::testMCBatchPricing() {
+
+    BOOST_MESSAGE("Testing batch pricing of discrete average-price "
+                  "Asian paths...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.03));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.06));
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+    boost::shared_ptr<StochasticProcess> process(
+         new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                       Handle<YieldTermStructure>(qTS),
+                                       Handle<YieldTermStructure>(rTS),
+                                       Handle<BlackVolTermStructure>(volTS)));
+
+    std::vector<Time> fixingTimes(12);
+    for (Size i=0; i<fixingTimes.size(); i++)
+        fixingTimes[i] = (i+1)/12.0;
+    TimeGrid grid(fixingTimes.begin(), fixingTimes.end());
+
+    typedef MonteCarloModel<SingleVariate,PseudoRandom> model_type;
+    typedef model_type::path_generator_type generator_type;
+    typedef model_type::path_pricer_type pricer_type;
+
+    DiscountFactor discount = rTS->discount(fixingTimes.back());
+    boost::shared_ptr<pricer_type> pricer(
+              new ArithmeticAPOPathPricer(Option::Call, 100.0, discount));
+    boost::shared_ptr<pricer_type> cvPricer(
+              new GeometricAPOPathPricer(Option::Call, 100.0, discount));
+    boost::shared_ptr<pricer_type> singlePricer(new PathByPathPricer(pricer));
+    boost::shared_ptr<pricer_type> singleCvPricer(
+                                            new PathByPathPricer(cvPricer));
+    Real cvValue = 5.0;
+
+    // more samples than a single batch
+    Size samples = 2500;
+
+    bool antithetic[] = { false, true };
+    for (Size i=0; i<LENGTH(antithetic); i++) {
+        for (Size j=0; j<2; j++) {
+            bool controlVariate = (j == 1);
+            boost::shared_ptr<generator_type> generator1(
+                 new generator_type(process, grid,
+                                    PseudoRandom::make_sequence_generator(
+                                                      grid.size()-1, 42),
+                                    true));
+            boost::shared_ptr<generator_type> generator2(
+                                        new generator_type(*generator1));
+
+            model_type batched(generator1, pricer, Statistics(),
+                               antithetic[i],
+                               controlVariate ? cvPricer :
+                                   boost::shared_ptr<pricer_type>(),
+                               cvValue);
+            model_type pathByPath(generator2, singlePricer, Statistics(),
+                                  antithetic[i],
+                                  controlVariate ? singleCvPricer :
+                                      boost::shared_ptr<pricer_type>(),
+                                  cvValue);
+            batched.addSamples(samples);
+            pathByPath.addSamples(samples);
+
+            Real calculated = batched.sampleAccumulator().mean();
+            Real expected = pathByPath.sampleAccumulator().mean();
+            if (calculated != expected)
+                BOOST_ERROR("batch pricing "
+                            << (antithetic[i] ? "with" : "without")
+                            << " antithetic variate and "
+                            << (controlVariate ? "with" : "without")
+                            << " control variate failed to reproduce "
+                            << "path-by-path pricing:"
+                            << std::setprecision(16)
+                            << "\n    batched:      " << calculated
+                            << "\n    path by path: " << expected);
+        }
+    }
+
+    // Halton sequences can't be drawn in blocks; the model must
+    // fall back to path-by-path simulation with the same pricer
+    typedef GenericLowDiscrepancy<HaltonRsg,InverseCumulativeNormal> Halton;
+    typedef MonteCarloModel<SingleVariate,Halton> halton_model_type;
+    typedef halton_model_type::path_generator_type halton_generator_type;
+
+    boost::shared_ptr<halton_generator_type> haltonGenerator1(
+                 new halton_generator_type(process, grid,
+                                           Halton::make_sequence_generator(
+                                                      grid.size()-1, 42),
+                                           false));
+    boost::shared_ptr<halton_generator_type> haltonGenerator2(
+                                 new halton_generator_type(*haltonGenerator1));
+
+    halton_model_type batchPricer(haltonGenerator1, pricer,
+                                  Statistics(), false);
+    halton_model_type singlePathPricer(haltonGenerator2, singlePricer,
+                                       Statistics(), false);
+    batchPricer.addSamples(samples);
+    singlePathPricer.addSamples(samples);
+
+    Real calculated = batchPricer.sampleAccumulator().mean();
+    Real expected = singlePathPricer.sampleAccumulator().mean();
+    if (calculated != expected)
+        BOOST_ERROR("batch-capable pricer failed to reproduce "
+                    << "path-by-path pricing with Halton sequences:"
+                    << std::setprecision(16)
+                    << "\n    batch pricer:  " << calculated
+                    << "\n    path by path:  " << expected);
+}
+
 test_suite* AsianOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Asian option tests");
 
@@ -1253,6 +1382,8 @@ test_suite* AsianOptionTest::suite() {
         &AsianOptionTest::testAnalyticDiscreteGeometricAveragePriceGreeks));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testPastFixings));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMCBatchPricing));
 
     return suite;
 }
@@ -32,6 +32,7 @@
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/experimental/barrieroption/perturbativebarrieroptionengine.hpp>
 #include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/processes/geometricbrownianprocess.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -699,6 +700,56 @@ void BarrierOptionTest::testLocalVolAndHestonComparison() {
 }
 
 
+void BarrierOptionTest::testMcBatchPricing() {
+
+    BOOST_MESSAGE("Testing batch pricing of barrier option paths...");
+
+    SavedSettings backup;
+
+    boost::shared_ptr<StochasticProcess> process(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.25));
+    TimeGrid grid(1.0, 50);
+    std::vector<DiscountFactor> discounts(grid.size());
+    for (Size i=0; i<grid.size(); i++)
+        discounts[i] = std::exp(-0.05*grid[i]);
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    PathGenerator<rsg_type> generator(
+                  process, grid,
+                  PseudoRandom::make_sequence_generator(grid.size()-1, 42),
+                  false);
+    MultiPathBlock paths;
+    generator.nextBlock(1000, paths);
+
+    struct {
+        Barrier::Type type;
+        Real barrier;
+    } cases[] = {
+        { Barrier::DownIn,   90.0 },
+        { Barrier::DownOut,  90.0 },
+        { Barrier::UpIn,    120.0 },
+        { Barrier::UpOut,   120.0 }
+    };
+
+    std::vector<Real> values(paths.pathNumber());
+    MultiPath path;
+    for (Size i=0; i<LENGTH(cases); i++) {
+        BiasedBarrierPathPricer pricer(cases[i].type, cases[i].barrier,
+                                       2.0, Option::Call, 100.0, discounts);
+        pricer.priceBatch(paths, values);
+        for (Size k=0; k<paths.pathNumber(); k++) {
+            paths.copyPath(k, path);
+            Real expected = pricer(path[0]);
+            if (values[k] != expected)
+                BOOST_FAIL("batch pricing of " << cases[i].type
+                           << " barrier option failed on path " << k
+                           << ":" << std::setprecision(16)
+                           << "\n    calculated: " << values[k]
+                           << "\n    expected:   " << expected);
+        }
+    }
+}
+
 test_suite* BarrierOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Barrier option tests");
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testHaugValues));
@@ -706,6 +757,7 @@ test_suite* BarrierOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testBeagleholeValues));
     suite->add(QUANTLIB_TEST_CASE(
                         &BarrierOptionTest::testLocalVolAndHestonComparison));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMcBatchPricing));
     return suite;
 }
 
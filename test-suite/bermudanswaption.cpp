@@ -21,9 +21,12 @@
 #include "utilities.hpp"
 #include <ql/instruments/swaption.hpp>
 #include <ql/pricingengines/swaption/treeswaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
+#include <ql/pricingengines/swaption/fdg2swaptionengine.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
@@ -99,6 +102,19 @@ namespace {
         }
     };
 
+    // counts the lattices built by the model
+    class CountingHullWhite : public HullWhite {
+      public:
+        CountingHullWhite(const Handle<YieldTermStructure>& termStructure,
+                          Real a, Real sigma)
+        : HullWhite(termStructure, a, sigma), trees(0) {}
+        boost::shared_ptr<Lattice> tree(const TimeGrid& grid) const {
+            ++trees;
+            return HullWhite::tree(grid);
+        }
+        mutable Size trees;
+    };
+
 }
 
 
@@ -224,10 +240,248 @@ void BermudanSwaptionTest::testCachedValues() {
                     << "expected:   " << otmValue);
 }
 
+void BermudanSwaptionTest::testFdmCheckpoints() {
+
+    BOOST_MESSAGE("Testing resumed finite-difference Bermudan "
+                  "swaption rollbacks...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                       0.04875825,
+                                       Actual365Fixed()));
+
+    boost::shared_ptr<VanillaSwap> swap =
+        vars.makeSwap(vars.makeSwap(0.0)->fairRate());
+
+    std::vector<Date> exerciseDates;
+    const Leg& leg = swap->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(leg[i]);
+        exerciseDates.push_back(coupon->accrualStartDate());
+    }
+
+    boost::shared_ptr<HullWhite> hwModel(
+        new HullWhite(vars.termStructure, 0.048696, 0.0058904));
+    boost::shared_ptr<G2> g2Model(
+        new G2(vars.termStructure, 0.1, 0.0058904, 0.05, 0.005, -0.7));
+
+    boost::shared_ptr<PricingEngine> engines[] = {
+        boost::shared_ptr<PricingEngine>(
+                                 new FdHullWhiteSwaptionEngine(hwModel)),
+        boost::shared_ptr<PricingEngine>(
+                        new FdG2SwaptionEngine(g2Model, 100, 30, 30)) };
+    const std::string names[] = { "Hull-White", "G2" };
+
+    const Real tolerance = 1.0e-3;
+
+    for (Size k=0; k < LENGTH(engines); ++k) {
+        // a strip of swaptions with decreasing number of exercise
+        // dates, each one resumed from the previous rollback
+        for (Size i=0; i < exerciseDates.size(); ++i) {
+            boost::shared_ptr<Exercise> exercise(new BermudanExercise(
+                std::vector<Date>(exerciseDates.begin()+i,
+                                  exerciseDates.end())));
+
+            Swaption swaption(swap, exercise);
+            swaption.setPricingEngine(engines[k]);
+            const Real resumed = swaption.NPV();
+            // a new engine rolls back from the last exercise date
+            if (k == 0)
+                swaption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                 new FdHullWhiteSwaptionEngine(hwModel)));
+            else
+                swaption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                        new FdG2SwaptionEngine(g2Model, 100, 30, 30)));
+            const Real expected = swaption.NPV();
+
+            if (std::fabs(resumed - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce swaption value "
+                            "from resumed rollback:"
+                            << "\n    model:           " << names[k]
+                            << "\n    exercise dates:  "
+                            << exerciseDates.size() - i
+                            << "\n    calculated:      " << resumed
+                            << "\n    expected:        " << expected
+                            << "\n    tolerance:       " << tolerance);
+        }
+    }
+}
+
+
+void BermudanSwaptionTest::testTreeEngineLatticeReuse() {
+
+    BOOST_MESSAGE("Testing lattice reuse in tree swaption engines...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                       0.04875825,
+                                       Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+    boost::shared_ptr<VanillaSwap> itmSwap = vars.makeSwap(0.8*atmRate);
+    boost::shared_ptr<VanillaSwap> otmSwap = vars.makeSwap(1.2*atmRate);
+
+    std::vector<Date> exerciseDates;
+    const Leg& leg = itmSwap->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(leg[i]);
+        exerciseDates.push_back(coupon->accrualStartDate());
+    }
+    boost::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+
+    Real a = 0.048696, sigma = 0.0058904;
+    boost::shared_ptr<CountingHullWhite> model(
+                        new CountingHullWhite(vars.termStructure, a, sigma));
+    Size timeSteps = 50;
+    Real tolerance = 1.0e-10;
+
+    Swaption itm(itmSwap, exercise), otm(otmSwap, exercise);
+    boost::shared_ptr<PricingEngine> engine(
+                                 new TreeSwaptionEngine(model, timeSteps));
+    itm.setPricingEngine(engine);
+    otm.setPricingEngine(engine);
+
+    // swaptions on the same schedule share the lattice...
+    Real itmValue = itm.NPV(), otmValue = otm.NPV();
+    if (model->trees != 1)
+        BOOST_ERROR("lattice not reused by swaptions on the same schedule:\n"
+                    << "    lattices built: " << model->trees);
+
+    // ...which gives the same results as a new one
+    Swaption check(otmSwap, exercise);
+    check.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                 new TreeSwaptionEngine(model, timeSteps)));
+    if (std::fabs(check.NPV()-otmValue) > tolerance)
+        BOOST_ERROR("failed to reproduce swaption value on reused lattice:\n"
+                    << std::setprecision(12)
+                    << "    reused lattice: " << otmValue << "\n"
+                    << "    new lattice:    " << check.NPV());
+
+    // a change in the model parameters invalidates the lattice
+    Array params = model->params();
+    params[1] = 1.2*sigma;
+    model->setParams(params);
+    Size trees = model->trees;
+    Real newItmValue = itm.NPV();
+    otm.NPV();
+    if (model->trees != trees+1)
+        BOOST_ERROR("lattice not rebuilt once after model change:\n"
+                    << "    lattices built: " << model->trees-trees);
+    if (newItmValue <= itmValue + 1.0e-4)
+        BOOST_ERROR("swaption value not updated after volatility increase:\n"
+                    << std::setprecision(12)
+                    << "    before: " << itmValue << "\n"
+                    << "    after:  " << newItmValue);
+    Swaption expected(itmSwap, exercise);
+    expected.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new TreeSwaptionEngine(
+            boost::shared_ptr<ShortRateModel>(
+                      new HullWhite(vars.termStructure, a, 1.2*sigma)),
+            timeSteps)));
+    if (std::fabs(newItmValue-expected.NPV()) > tolerance)
+        BOOST_ERROR("failed to reproduce swaption value after model change:\n"
+                    << std::setprecision(12)
+                    << "    calculated: " << newItmValue << "\n"
+                    << "    expected:   " << expected.NPV());
+
+    // swaptions on different schedules keep their own lattices when
+    // priced in turns
+    vars.startYears = 2;
+    boost::shared_ptr<VanillaSwap> laterSwap = vars.makeSwap(atmRate);
+    std::vector<Date> laterDates;
+    const Leg& laterLeg = laterSwap->fixedLeg();
+    for (Size i=0; i<laterLeg.size(); i++) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(laterLeg[i]);
+        laterDates.push_back(coupon->accrualStartDate());
+    }
+    Swaption later(laterSwap, boost::shared_ptr<Exercise>(
+                                          new BermudanExercise(laterDates)));
+    later.setPricingEngine(engine);
+    trees = model->trees;
+    Real laterValue = later.NPV();
+    for (Size k=0; k<3; ++k) {
+        itm.recalculate();
+        later.recalculate();
+    }
+    if (model->trees != trees+1)
+        BOOST_ERROR("lattices not kept for swaptions on different "
+                    "schedules:\n"
+                    << "    lattices built: " << model->trees-trees);
+    if (std::fabs(itm.NPV()-newItmValue) > tolerance
+        || std::fabs(later.NPV()-laterValue) > tolerance)
+        BOOST_ERROR("failed to reproduce swaption values on kept lattices:\n"
+                    << std::setprecision(12)
+                    << "    first schedule:  " << itm.NPV()
+                    << " (expected " << newItmValue << ")\n"
+                    << "    second schedule: " << later.NPV()
+                    << " (expected " << laterValue << ")");
+
+    // with a fixed time grid, a single lattice serves all swaptions...
+    Swaption::arguments arguments;
+    itm.setupArguments(&arguments);
+    std::vector<Time> times =
+        DiscretizedSwaption(arguments, vars.settlement,
+                            Actual365Fixed()).mandatoryTimes();
+    TimeGrid grid(times.begin(), times.end(), timeSteps);
+    boost::shared_ptr<PricingEngine> gridEngine(
+                                     new TreeSwaptionEngine(model, grid));
+    itm.setPricingEngine(gridEngine);
+    otm.setPricingEngine(gridEngine);
+
+    trees = model->trees;
+    Real itmGridValue = itm.NPV(), otmGridValue = otm.NPV();
+    if (model->trees != trees+1)
+        BOOST_ERROR("fixed-grid lattice not shared by swaptions:\n"
+                    << "    lattices built: " << model->trees-trees);
+    if (std::fabs(itmGridValue-newItmValue) > tolerance)
+        BOOST_ERROR("failed to reproduce swaption value on fixed grid:\n"
+                    << std::setprecision(12)
+                    << "    calculated: " << itmGridValue << "\n"
+                    << "    expected:   " << newItmValue);
+
+    // ...and is rebuilt when the model changes
+    params[1] = sigma;
+    model->setParams(params);
+    trees = model->trees;
+    itmGridValue = itm.NPV();
+    otmGridValue = otm.NPV();
+    if (model->trees != trees+1)
+        BOOST_ERROR("fixed-grid lattice not rebuilt once after "
+                    "model change:\n"
+                    << "    lattices built: " << model->trees-trees);
+    if (std::fabs(itmGridValue-itmValue) > tolerance
+        || std::fabs(otmGridValue-otmValue) > tolerance)
+        BOOST_ERROR("failed to reproduce swaption values on fixed grid "
+                    "after model change:\n"
+                    << std::setprecision(12)
+                    << "    in the money:     " << itmGridValue
+                    << " (expected " << itmValue << ")\n"
+                    << "    out of the money: " << otmGridValue
+                    << " (expected " << otmValue << ")");
+}
+
 
 test_suite* BermudanSwaptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bermudan swaption tests");
     suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedValues));
+    suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testFdmCheckpoints));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &BermudanSwaptionTest::testTreeEngineLatticeReuse));
     return suite;
 }
 
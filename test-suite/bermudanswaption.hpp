@@ -28,6 +28,8 @@
 class BermudanSwaptionTest {
   public:
     static void testCachedValues();
+    static void testFdmCheckpoints();
+    static void testTreeEngineLatticeReuse();
     static boost::unit_test_framework::test_suite* suite();
 };
 
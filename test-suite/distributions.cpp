@@ -368,6 +368,60 @@ void DistributionTest::testInverseCumulativePoisson() {
 }
 
 
+namespace {
+
+    // the array version can be compiled differently (e.g., with
+    // fused multiply-adds) so a difference of one ulp is allowed
+    bool withinOneUlp(Real calculated, Real expected) {
+        return std::fabs(calculated-expected) <=
+            QL_EPSILON*std::fabs(expected);
+    }
+
+    template <class F>
+    void checkArrayEvaluation(const std::string& name, const F& f,
+                              const std::vector<Real>& x) {
+        std::vector<Real> y(x.size());
+        f(&x[0], &x[0]+x.size(), &y[0]);
+
+        std::vector<Real> z(x);
+        f(&z[0], &z[0]+z.size(), &z[0]);
+
+        for (Size i=0; i<x.size(); ++i) {
+            Real expected = f(x[i]);
+            if (!withinOneUlp(y[i], expected) ||
+                !withinOneUlp(z[i], expected)) {
+                BOOST_ERROR(name << " array evaluation failed at x = "
+                            << QL_SCIENTIFIC << x[i]
+                            << std::setprecision(17)
+                            << "\n    scalar:   " << expected
+                            << "\n    array:    " << y[i]
+                            << "\n    in place: " << z[i]);
+                return;
+            }
+        }
+    }
+
+}
+
+void DistributionTest::testArrayEvaluation() {
+
+    BOOST_MESSAGE("Testing array evaluation of the inverse "
+                  "cumulative normal distribution...");
+
+    // covers both tails and the central region; the size is not a
+    // multiple of the chunks used internally
+    Size N = 500001;
+    std::vector<Real> p(N);
+    for (Size i=0; i<N; ++i)
+        p[i] = (i+0.5)/N;
+
+    checkArrayEvaluation("standard inverse cumulative normal",
+                         InverseCumulativeNormal(), p);
+    checkArrayEvaluation("inverse cumulative normal",
+                         InverseCumulativeNormal(average, sigma), p);
+}
+
+
 test_suite* DistributionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormal));
@@ -376,6 +430,7 @@ test_suite* DistributionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testCumulativePoisson));
     suite->add(QUANTLIB_TEST_CASE(
                             &DistributionTest::testInverseCumulativePoisson));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testArrayEvaluation));
     return suite;
 }
 
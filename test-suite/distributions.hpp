@@ -33,6 +33,7 @@ class DistributionTest {
     static void testPoisson();
     static void testCumulativePoisson();
     static void testInverseCumulativePoisson();
+    static void testArrayEvaluation();
     static boost::unit_test_framework::test_suite* suite();
 };
 
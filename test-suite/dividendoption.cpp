@@ -31,6 +31,7 @@
 #include <ql/pricingengines/vanilla/fddividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/fddividendamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fddividendshoutengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -921,6 +922,79 @@ void DividendOptionTest::testFdAmericanDegenerate() {
     testFdDegenerate<FDDividendAmericanEngine<CrankNicolson> >(today,exercise);
 }
 
+void DividendOptionTest::testFdAdaptiveTimeStepping() {
+
+    BOOST_MESSAGE("Testing finite-differences dividend European option "
+                  "with adaptive time stepping...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date(27,February,2005);
+    Settings::instance().evaluationDate() = today;
+    Date exDate = today + 360;
+
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exDate));
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Put, 100.0));
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(100.0))),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+
+    // the dividend is a stopping time at which the step size is reset
+    std::vector<Date> dividendDates(1, today + 180);
+    std::vector<Real> dividends(1, 3.0);
+    DividendVanillaOption option(payoff, exercise, dividendDates, dividends);
+
+    const Size xGrid = 400, initialSteps = 10, dampingSteps = 2;
+    const Real tolerance = 1.0e-4;
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(process, initialSteps, xGrid,
+                                        dampingSteps,
+                                        FdmSchemeDesc::Douglas(),
+                                        false, -Null<Real>(), false,
+                                        tolerance)));
+    const Real npvCalculated = option.NPV();
+    const Real deltaCalculated = option.delta();
+    const Size accepted = option.result<Size>("acceptedTimeSteps");
+    const Size rejected = option.result<Size>("rejectedTimeSteps");
+    const Real error = option.result<Real>("timeSteppingError");
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(process, 1000, xGrid, dampingSteps)));
+    const Real npvExpected = option.NPV();
+    const Real deltaExpected = option.delta();
+
+    const Real tol = 1.0e-3;
+    if (std::fabs((npvCalculated-npvExpected)/npvExpected) > tol) {
+        BOOST_FAIL("failed to reproduce value with adaptive time stepping"
+                   << "\n    calculated: " << npvCalculated
+                   << "\n    expected:   " << npvExpected
+                   << "\n    tolerance:  " << QL_SCIENTIFIC << tol);
+    }
+    if (std::fabs((deltaCalculated-deltaExpected)/deltaExpected) > tol) {
+        BOOST_FAIL("failed to reproduce delta with adaptive time stepping"
+                   << "\n    calculated: " << deltaCalculated
+                   << "\n    expected:   " << deltaExpected
+                   << "\n    tolerance:  " << QL_SCIENTIFIC << tol);
+    }
+
+    const Size maxSteps = 50;
+    if (accepted < initialSteps || accepted > maxSteps
+        || error > accepted*tolerance) {
+        BOOST_FAIL("unexpected adaptive time stepping statistics"
+                   << "\n    accepted steps: " << accepted
+                   << "\n    rejected steps: " << rejected
+                   << "\n    error estimate: " << error
+                   << "\n    tolerance:      " << tolerance);
+    }
+}
+
 
 test_suite* DividendOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Dividend European option tests");
@@ -943,6 +1017,8 @@ test_suite* DividendOptionTest::suite() {
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(
                               &DividendOptionTest::testFdAmericanDegenerate));
+    suite->add(QUANTLIB_TEST_CASE(
+                              &DividendOptionTest::testFdAdaptiveTimeStepping));
     return suite;
 }
 
@@ -37,6 +37,7 @@ class DividendOptionTest {
     static void testFdAmericanGreeks();
     static void testFdEuropeanDegenerate();
     static void testFdAmericanDegenerate();
+    static void testFdAdaptiveTimeStepping();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -24,12 +24,15 @@
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/instruments/vanillaoption.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/randomnumbers/knuthuniformrng.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
@@ -1283,6 +1286,103 @@ void EuropeanOptionTest::testMcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcEngineWorkers() {
+
+    BOOST_MESSAGE("Testing Monte Carlo European engine "
+                  "with multiple workers...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> stochProcess =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 105.0));
+    boost::shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + 360));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                    new AnalyticEuropeanEngine(stochProcess)));
+    Real expected = option.NPV();
+
+    Size samples = 40001, workers = 4;
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withAntitheticVariate()
+                            .withWorkers(workers));
+    Real calculated = option.NPV();
+    Real error = option.errorEstimate();
+    if (std::fabs(calculated-expected) > 3.0*error)
+        BOOST_ERROR("failed to reproduce analytic value with "
+                    << workers << " workers:"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    error estimate: " << error);
+
+    // the workers draw the same paths as a serial run, so the
+    // results must coincide exactly
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withAntitheticVariate());
+    Real serial = option.NPV();
+    if (serial != calculated)
+        BOOST_ERROR("failed to reproduce serial value with "
+                    << workers << " workers:"
+                    << std::setprecision(16)
+                    << "\n    serial:   " << serial
+                    << "\n    parallel: " << calculated);
+
+    // the same holds for low-discrepancy sequences
+    option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withWorkers(workers));
+    calculated = option.NPV();
+    option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples));
+    serial = option.NPV();
+    if (serial != calculated)
+        BOOST_ERROR("failed to reproduce serial low-discrepancy value with "
+                    << workers << " workers:"
+                    << std::setprecision(16)
+                    << "\n    serial:   " << serial
+                    << "\n    parallel: " << calculated);
+
+    // generators without efficient skip-ahead run serially
+    typedef GenericPseudoRandom<KnuthUniformRng,
+                                InverseCumulativeNormal> KnuthRandom;
+    option.setPricingEngine(MakeMCEuropeanEngine<KnuthRandom>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withWorkers(workers));
+    calculated = option.NPV();
+    option.setPricingEngine(MakeMCEuropeanEngine<KnuthRandom>(stochProcess)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42));
+    serial = option.NPV();
+    if (serial != calculated)
+        BOOST_ERROR("failed to reproduce serial value with "
+                    << workers << " workers and Knuth generator:"
+                    << std::setprecision(16)
+                    << "\n    serial:   " << serial
+                    << "\n    parallel: " << calculated);
+}
+
 void EuropeanOptionTest::testQmcEngines() {
 
     BOOST_MESSAGE("Testing Quasi Monte Carlo European engines "
@@ -1547,6 +1647,127 @@ void EuropeanOptionTest::testLocalVolatility() {
 }
 
 
+void EuropeanOptionTest::testFdSensitivities() {
+    BOOST_MESSAGE("Testing vega and rho from the finite-difference "
+                  "tangent equations...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(28, October, 2011);
+    Settings::instance().evaluationDate() = today;
+
+    const boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    const boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.02));
+    const boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.05));
+    const boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+
+    const boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, qRate, dc)),
+            Handle<YieldTermStructure>(flatRate(today, rRate, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc))));
+
+    const boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Put, 105.0));
+    const Date exDate = today + Period(1, Years);
+
+    // European exercise: compare with the analytic Greeks
+    EuropeanOption european(payoff, boost::shared_ptr<Exercise>(
+                                                new EuropeanExercise(exDate)));
+    european.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                       new AnalyticEuropeanEngine(process)));
+    const Real expectedVega = european.vega();
+    const Real expectedRho  = european.rho();
+
+    const boost::shared_ptr<PricingEngine> fdEngine(
+        new FdBlackScholesVanillaEngine(process, 100, 200, 0,
+                                        FdmSchemeDesc::Douglas(),
+                                        false, -Null<Real>(), true));
+    european.setPricingEngine(fdEngine);
+
+    const Real tol = 5e-3;
+    Real calculated = european.vega();
+    if (std::fabs(calculated - expectedVega) > tol*expectedVega) {
+        BOOST_FAIL("failed to reproduce European vega"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expectedVega);
+    }
+    calculated = european.rho();
+    if (std::fabs(calculated - expectedRho) > tol*std::fabs(expectedRho)) {
+        BOOST_FAIL("failed to reproduce European rho"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expectedRho);
+    }
+
+    // American exercise: compare with bump-and-reprice
+    VanillaOption american(payoff, boost::shared_ptr<Exercise>(
+                                    new AmericanExercise(today, exDate)));
+    american.setPricingEngine(fdEngine);
+    const Real vega = american.vega();
+    const Real rho  = american.rho();
+
+    american.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                        new FdBlackScholesVanillaEngine(process, 100, 200)));
+    const Real h = 1e-4;
+    vol->setValue(0.25 + h);
+    Real up = american.NPV();
+    vol->setValue(0.25 - h);
+    Real down = american.NPV();
+    vol->setValue(0.25);
+    const Real bumpedVega = (up - down)/(2*h);
+
+    rRate->setValue(0.05 + h);
+    up = american.NPV();
+    rRate->setValue(0.05 - h);
+    down = american.NPV();
+    rRate->setValue(0.05);
+    const Real bumpedRho = (up - down)/(2*h);
+
+    // the bumped results include the change of the mesh
+    const Real bumpTol = 1e-2;
+    if (std::fabs(vega - bumpedVega) > bumpTol*bumpedVega) {
+        BOOST_FAIL("failed to reproduce American vega"
+                   << "\n    calculated: " << vega
+                   << "\n    bumped:     " << bumpedVega);
+    }
+    if (std::fabs(rho - bumpedRho) > bumpTol*std::fabs(bumpedRho)) {
+        BOOST_FAIL("failed to reproduce American rho"
+                   << "\n    calculated: " << rho
+                   << "\n    bumped:     " << bumpedRho);
+    }
+
+    // Heston model: compare rho with bump-and-reprice
+    const boost::shared_ptr<HestonModel> hestonModel(
+        new HestonModel(boost::shared_ptr<HestonProcess>(
+            new HestonProcess(
+                Handle<YieldTermStructure>(flatRate(today, rRate, dc)),
+                Handle<YieldTermStructure>(flatRate(today, qRate, dc)),
+                Handle<Quote>(spot), 0.0625, 1.0, 0.0625, 0.3, -0.5))));
+    european.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdHestonVanillaEngine(hestonModel, 100, 100, 50, 0,
+                                  FdmSchemeDesc::Hundsdorfer(), true)));
+    const Real hestonRho = european.rho();
+
+    european.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                        new FdHestonVanillaEngine(hestonModel, 100, 100, 50)));
+    rRate->setValue(0.05 + h);
+    up = european.NPV();
+    rRate->setValue(0.05 - h);
+    down = european.NPV();
+    rRate->setValue(0.05);
+    const Real bumpedHestonRho = (up - down)/(2*h);
+
+    if (std::fabs(hestonRho - bumpedHestonRho)
+                                    > bumpTol*std::fabs(bumpedHestonRho)) {
+        BOOST_FAIL("failed to reproduce Heston rho"
+                   << "\n    calculated: " << hestonRho
+                   << "\n    bumped:     " << bumpedHestonRho);
+    }
+}
+
+
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testValues));
@@ -1569,11 +1790,13 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngineWorkers));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdSensitivities));
 
     return suite;
 }
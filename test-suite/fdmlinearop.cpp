@@ -39,10 +39,12 @@
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
 #include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
@@ -58,6 +60,7 @@
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm2dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
@@ -74,6 +77,11 @@
 
 #include <boost/bind.hpp>
 #include <numeric>
+#include <iomanip>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -209,6 +217,55 @@ void FdmLinearOpTest::testFdmLinearOpLayout() {
             }
         }
     }
+
+    // the cached index tables must agree with the iterator-based methods
+    for (Size i=0; i < dim.size(); ++i) {
+        const boost::shared_array<Size> lines = layout.lineTable(i);
+        if (lines != layout.lineTable(i))
+            BOOST_FAIL("line table along direction " << i
+                       << " is not cached");
+
+        std::vector<Size> lineIndex(layout.size());
+        for (Size k=0; k < layout.size(); ++k)
+            lineIndex[lines[k]] = k;
+
+        for (Integer offset=-2; offset <= 2; ++offset) {
+            const boost::shared_array<Size> table =
+                layout.neighbourhoodTable(i, offset);
+            for (Size j=0; j < dim.size(); ++j) {
+                if (j == i)
+                    continue;
+                const boost::shared_array<Size> table2 =
+                    layout.neighbourhoodTable(i, offset, j, -1);
+                for (iter = layout.begin(); iter != layout.end(); ++iter) {
+                    const Size expected =
+                        layout.neighbourhood(iter, i, offset, j, -1);
+                    if (table2[iter.index()] != expected)
+                        BOOST_FAIL("neighbourhood table along directions "
+                                   << i << ", " << j << " gives "
+                                   << table2[iter.index()]
+                                   << " instead of " << expected);
+                }
+            }
+            for (iter = layout.begin(); iter != layout.end(); ++iter) {
+                const Size expected = layout.neighbourhood(iter, i, offset);
+                if (table[iter.index()] != expected)
+                    BOOST_FAIL("neighbourhood table along direction " << i
+                               << " gives " << table[iter.index()]
+                               << " instead of " << expected);
+
+                // consecutive points on the same line
+                const Size c = iter.coordinates()[i];
+                const Size k = lineIndex[iter.index()];
+                if (k/dim[i] != (k-c)/dim[i] || k%dim[i] != c)
+                    BOOST_FAIL("wrong position " << k << " of point "
+                               << iter.index() << " in line table");
+                if (c > 0 && lines[k-1] != layout.neighbourhood(iter, i, -1))
+                    BOOST_FAIL("line table along direction " << i
+                               << " is not ordered");
+            }
+        }
+    }
 }
 
 void FdmLinearOpTest::testUniformGridMesher() {
@@ -583,6 +640,132 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
 }
 
 
+void FdmLinearOpTest::testTripleBandMapThreads() {
+
+    BOOST_MESSAGE("Testing independence of triple-band map results "
+                  "from the number of threads...");
+
+    SavedSettings backup;
+
+    Size dims[] = {20, 30, 25};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.0, 2.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.5, 1.5));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size()), a(layout->size());
+    for (Size i=0; i < layout->size(); ++i) {
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+        a[i] = 0.5 + 0.25*std::cos(0.01*i);
+    }
+
+    for (Size d=0; d < dim.size(); ++d) {
+        FirstDerivativeOp dx(d, mesher);
+        SecondDerivativeOp dxx(d, mesher);
+        dxx.axpyb(a, dxx, dx, Array(1, -0.05));
+
+        #if defined(_OPENMP)
+        const int nThreads = omp_get_max_threads();
+        omp_set_num_threads(1);
+        #endif
+        const Array applied = dxx.apply(u);
+        const Array solved = dxx.solve_splitting(u, -0.01);
+        #if defined(_OPENMP)
+        omp_set_num_threads(std::max(nThreads, 4));
+        #endif
+        const Array parallelApplied = dxx.apply(u);
+        const Array parallelSolved = dxx.solve_splitting(u, -0.01);
+        #if defined(_OPENMP)
+        omp_set_num_threads(nThreads);
+        #endif
+
+        for (Size i=0; i < u.size(); ++i) {
+            if (applied[i] != parallelApplied[i]
+                || solved[i] != parallelSolved[i]) {
+                BOOST_FAIL("results depend on the number of threads"
+                           << "\n direction : " << d
+                           << "\n index     : " << i
+                           << std::setprecision(17)
+                           << "\n apply     : " << applied[i]
+                           << " vs " << parallelApplied[i]
+                           << "\n solve     : " << solved[i]
+                           << " vs " << parallelSolved[i]);
+            }
+        }
+
+        // the line solves must invert the operator
+        const Array r = parallelSolved - 0.01*dxx.apply(parallelSolved);
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(r[i] - u[i]) > 1e-10) {
+                BOOST_FAIL("solve and apply are not consistent"
+                           << "\n direction  : " << d
+                           << "\n expected   : " << u[i]
+                           << "\n calculated : " << r[i]);
+            }
+        }
+    }
+}
+
+void FdmLinearOpTest::testTripleBandMapCachedSolve() {
+
+    BOOST_MESSAGE("Testing reuse of the triple-band map factorization...");
+
+    SavedSettings backup;
+
+    Size dims[] = {50, 40};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.0, 2.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size()), a(layout->size());
+    for (Size i=0; i < layout->size(); ++i) {
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+        a[i] = 0.5 + 0.25*std::cos(0.01*i);
+    }
+
+    const FirstDerivativeOp dx(1, mesher);
+    SecondDerivativeOp op(1, mesher);
+    op.axpyb(a, op, dx, Array(1, -0.05));
+
+    // each check compares with a fresh copy, which has no cached
+    // factorization; results must match exactly
+    const Real s[] = { -0.01, -0.01, -0.02, -0.01 };
+    Array solved;
+    for (Size k=0; k < LENGTH(s); ++k) {
+        if (k == LENGTH(s)-1)
+            op.axpyb(a, op, dx, Array(1, 0.1));
+
+        op.solve_splitting(u, s[k], 1.0, solved);
+        const Array expected =
+            TripleBandLinearOp(op).solve_splitting(u, s[k], 1.0);
+
+        for (Size i=0; i < u.size(); ++i) {
+            if (solved[i] != expected[i]) {
+                BOOST_FAIL("cached factorization gives different results"
+                           << "\n step       : " << k
+                           << "\n index      : " << i
+                           << std::setprecision(17)
+                           << "\n calculated : " << solved[i]
+                           << "\n expected   : " << expected[i]);
+            }
+        }
+    }
+}
+
 void FdmLinearOpTest::testFdmHestonBarrier() {
 
     BOOST_MESSAGE("Testing FDM with Barrier option in Heston model...");
@@ -849,6 +1032,24 @@ void FdmLinearOpTest::testFdmHestonExpress() {
         BOOST_FAIL("Error in calculating mean variance Delta for "
                 "Heston Express Certificate");
     }
+
+    // the batch interpolation must reproduce the single-point results
+    Fdm2DimSolver solver2d(solverDesc, FdmSchemeDesc::Hundsdorfer(),
+                           boost::shared_ptr<FdmLinearOpComposite>(
+                               new FdmHestonOp(mesher,
+                                               hestonProcess.currentLink())));
+    std::vector<Real> xs(3, std::log(s)), vs(3, v0);
+    xs[1] += 0.01; vs[2] += 0.01;
+    const Array batch2d = solver2d.interpolateAt(xs, vs);
+    for (Size i=0; i < xs.size(); ++i) {
+        if (batch2d[i] != solver2d.interpolateAt(xs[i], vs[i])) {
+            BOOST_FAIL("batch interpolation does not match "
+                       "single-point interpolation");
+        }
+    }
+    if (batch2d[0] != solver.valueAt(s, v0)) {
+        BOOST_FAIL("Error in calculating PV for Heston Express Certificate");
+    }
 }
 
 
@@ -1037,6 +1238,28 @@ void FdmLinearOpTest::testFdmHestonHullWhiteOp() {
         BOOST_FAIL("Error in calculating PV for Heston Hull White Option");
     }
 
+    // the batch interpolation and the cached theta interpolation
+    // must reproduce the single-point results
+    std::vector<std::vector<Real> > points(3, x);
+    points[1][0] += 0.01; points[2][1] += 0.01;
+    std::vector<Real> xs(3), ys(3), zs(3);
+    for (Size i=0; i < points.size(); ++i) {
+        xs[i] = points[i][0]; ys[i] = points[i][1]; zs[i] = points[i][2];
+    }
+    const Array batch3d = solver3d.interpolateAt(xs, ys, zs);
+    const Array batchNd = solverNd.interpolateAt(points);
+    for (Size i=0; i < points.size(); ++i) {
+        if (batch3d[i] != solver3d.interpolateAt(xs[i], ys[i], zs[i])
+            || batchNd[i] != solverNd.interpolateAt(points[i])) {
+            BOOST_FAIL("batch interpolation does not match "
+                       "single-point interpolation");
+        }
+    }
+    if (solver3d.thetaAt(x[0], x[1], x[2]) != solverTheta
+        || solverNd.thetaAt(x) != solverNdTheta) {
+        BOOST_FAIL("cached theta interpolation does not match");
+    }
+
     VanillaOption option(
             boost::shared_ptr<StrikedTypePayoff>(
                                 new PlainVanillaPayoff(Option::Call, 160.0)),
@@ -1078,6 +1301,73 @@ namespace {
 #endif
 
 
+void FdmLinearOpTest::testInPlaceOperators() {
+    BOOST_MESSAGE("Testing in-place variants of FDM operators...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const Time maturity = 1.0;
+
+    Size dims[] = {21, 11, 11};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    boost::shared_ptr<FdmMesher> mesher
+                              = createSolverDesc(dim, jointProcess).mesher;
+
+    boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    boost::shared_ptr<FdmLinearOpComposite> ops[] = {
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmHestonHullWhiteOp(mesher,
+                                     jointProcess->hestonProcess(),
+                                     hwProcess, jointProcess->eta())),
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmHestonOp(mesher, jointProcess->hestonProcess()))
+    };
+
+    Array u(mesher->layout()->size());
+    for (Size i=0; i < u.size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    // the output arrays are deliberately not sized in advance
+    Array out;
+    for (Size k=0; k < LENGTH(ops); ++k) {
+        ops[k]->setTime(0.25, 0.5);
+
+        std::vector<Array> expected, calculated;
+        expected.push_back(ops[k]->apply(u));
+        ops[k]->apply(u, out);
+        calculated.push_back(out);
+        expected.push_back(ops[k]->apply_mixed(u));
+        ops[k]->apply_mixed(u, out);
+        calculated.push_back(out);
+        for (Size d=0; d < ops[k]->size(); ++d) {
+            expected.push_back(ops[k]->apply_direction(d, u));
+            ops[k]->apply_direction(d, u, out);
+            calculated.push_back(out);
+            expected.push_back(ops[k]->solve_splitting(d, u, -0.01));
+            ops[k]->solve_splitting(d, u, -0.01, out);
+            calculated.push_back(out);
+        }
+
+        for (Size j=0; j < expected.size(); ++j) {
+            if (expected[j] != calculated[j])
+                BOOST_FAIL("in-place and allocating variants differ"
+                           << "\n operator: " << k
+                           << "\n method:   " << j);
+        }
+    }
+}
+
 void FdmLinearOpTest::testBiCGstab() {
 #if !defined(QL_NO_UBLAS_SUPPORT)
     BOOST_MESSAGE("Testing BiCGstab with Heston operator...");
@@ -1137,6 +1427,175 @@ void FdmLinearOpTest::testBiCGstab() {
 #endif
 }
 
+void FdmLinearOpTest::testGMRES() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_MESSAGE("Testing GMRES with mixed derivative operator...");
+
+    SavedSettings backup;
+
+    const Size n=41, m=21;
+    const Real theta = 1.0;
+    boost::numeric::ublas::compressed_matrix<Real> a(n*m, n*m);
+
+    for (Size i=0; i < n; ++i) {
+        for (Size j=0; j < m; ++j) {
+            const Size k = i*m+j;
+            a(k,k)=1.0;
+
+            if (i > 0 && j > 0 && i <n-1 && j < m-1) {
+                const Size im1 = i-1;
+                const Size ip1 = i+1;
+                const Size jm1 = j-1;
+                const Size jp1 = j+1;
+                const Real delta = theta/((ip1-im1)*(jp1-jm1));
+
+                a(k,im1*m+jm1) =  delta;
+                a(k,im1*m+jp1) = -delta;
+                a(k,ip1*m+jm1) = -delta;
+                a(k,ip1*m+jp1) =  delta;
+            }
+        }
+    }
+
+    boost::function<Disposable<Array>(const Array&)> matmult(
+                                                    boost::bind(&axpy, a, _1));
+
+    SparseILUPreconditioner ilu(a, 4);
+    boost::function<Disposable<Array>(const Array&)> precond(
+         boost::bind(&SparseILUPreconditioner::apply, &ilu, _1));
+
+    Array b(n*m);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-10;
+
+    const GMRES gmres(matmult, n*m, tol, precond);
+    const GMRESResult result = gmres.solve(b, b);
+    const Array x = result.x;
+
+    const Real error = std::sqrt(DotProduct(b-axpy(a, x),
+                                 b-axpy(a, x))/DotProduct(b,b));
+
+    if (error > tol) {
+        BOOST_FAIL("Error calculating the inverse using GMRES" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      " << error);
+    }
+
+    // a small Krylov space without preconditioner needs restarts
+    const GMRES gmresRestart(matmult, 5, tol);
+    const GMRESResult resultRestart = gmresRestart.solveWithRestart(100, b);
+    const Array xRestart = resultRestart.x;
+
+    const Real errorRestart =
+        std::sqrt(DotProduct(b-axpy(a, xRestart),
+                             b-axpy(a, xRestart))/DotProduct(b,b));
+
+    if (errorRestart > tol) {
+        BOOST_FAIL("Error calculating the inverse using "
+                   "GMRES with restarts" <<
+                   "\n tolerance:  " << tol <<
+                   "\n error:      " << errorRestart);
+    }
+#endif
+}
+
+void FdmLinearOpTest::testCrankNicolsonScheme() {
+
+    BOOST_MESSAGE("Testing Crank-Nicolson scheme with iterative solvers "
+                  "for the Heston operator...");
+
+    SavedSettings backup;
+
+    Size dims[] = {51, 21};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(std::log(20.0),
+                                               std::log(500.0)));
+    boundaries.push_back(std::pair<Real, Real>(0.0, 0.5));
+
+    boost::shared_ptr<FdmMesher> mesher(
+                            new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 1.5, 0.04, 0.4, -0.75));
+
+    boost::shared_ptr<FdmLinearOpComposite> hestonOp(
+                                new FdmHestonOp(mesher, hestonProcess));
+
+    boost::shared_ptr<Payoff> payoff(
+                                new PlainVanillaPayoff(Option::Put, 100.0));
+    FdmLogInnerValue calculator(payoff, mesher, 0);
+
+    const Time maturity = 1.0;
+    Array initial(layout->size());
+    const FdmLinearOpIterator endIter = layout->end();
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        initial[iter.index()] = calculator.avgInnerValue(iter, maturity);
+    }
+
+    const Size steps = 40;
+    const FdmBoundaryConditionSet bcSet;
+    const boost::shared_ptr<FdmStepConditionComposite> noCondition;
+
+    Array expected = initial;
+    FdmBackwardSolver(hestonOp, bcSet, noCondition,
+                      FdmSchemeDesc::Hundsdorfer())
+        .rollback(expected, maturity, 0.0, steps, 0);
+
+    Array calculated = initial;
+    FdmBackwardSolver(hestonOp, bcSet, noCondition,
+                      FdmSchemeDesc::CrankNicolson())
+        .rollback(calculated, maturity, 0.0, steps, 0);
+
+    Array calculatedGMRES = initial;
+    CrankNicolsonScheme evolver(0.5, hestonOp, bcSet, 1e-8,
+                                ImplicitEulerScheme::GMRES);
+    FiniteDifferenceModel<CrankNicolsonScheme> model(evolver);
+    model.rollback(calculatedGMRES, maturity, 0.0, steps);
+
+    const Real tol = 5e-3, solverTol = 1e-5;
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        const Size i = iter.index();
+        const Real s = std::exp(mesher->location(iter, 0));
+        const Real v = mesher->location(iter, 1);
+        if (s < 50.0 || s > 200.0 || v > 0.2)
+            continue;
+
+        if (std::fabs(calculated[i] - expected[i]) > tol) {
+            BOOST_FAIL("Crank-Nicolson and Hundsdorfer scheme differ"
+                       << std::setprecision(8)
+                       << "\n s:          " << s
+                       << "\n v:          " << v
+                       << "\n calculated: " << calculated[i]
+                       << "\n expected:   " << expected[i]
+                       << "\n tolerance:  " << tol);
+        }
+        if (std::fabs(calculatedGMRES[i] - calculated[i]) > solverTol) {
+            BOOST_FAIL("BiCGstab and GMRES solutions differ"
+                       << std::setprecision(8)
+                       << "\n s:          " << s
+                       << "\n v:          " << v
+                       << "\n GMRES:      " << calculatedGMRES[i]
+                       << "\n BiCGstab:   " << calculated[i]
+                       << "\n tolerance:  " << solverTol);
+        }
+    }
+}
+
 void FdmLinearOpTest::testCrankNicolsonWithDamping() {
 
     BOOST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -1229,6 +1688,116 @@ void FdmLinearOpTest::testCrankNicolsonWithDamping() {
     }
 }
 
+void FdmLinearOpTest::testAdaptiveTimeStepping() {
+
+    BOOST_MESSAGE("Testing adaptive time stepping with Rannacher smoothing "
+                  "for a digital option...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.35, dc);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                             new CashOrNothingPayoff(Option::Put, 100, 10.0));
+
+    Time maturity = 0.75;
+    Date exDate = today + Integer(maturity*360+0.5);
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exDate));
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+    boost::shared_ptr<PricingEngine> engine(
+                                new AnalyticEuropeanEngine(process));
+
+    VanillaOption opt(payoff, exercise);
+    opt.setPricingEngine(engine);
+    Real expectedPV = opt.NPV();
+    Real expectedGamma = opt.gamma();
+
+    const Size initialSteps = 10, dampingSteps = 2, xGrid = 400;
+    const Real tolerance = 5e-4;
+    const std::vector<Size> dim(1, xGrid);
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    const boost::shared_ptr<Fdm1dMesher> equityMesher(
+        new FdmBlackScholesMesher(
+                dim[0], process, maturity, payoff->strike(),
+                Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                std::pair<Real, Real>(payoff->strike(), 0.01)));
+
+    const boost::shared_ptr<FdmMesher> mesher (
+        new FdmMesherComposite(equityMesher));
+
+    boost::shared_ptr<FdmBlackScholesOp> map(
+                     new FdmBlackScholesOp(mesher, process, payoff->strike()));
+
+    boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                  new FdmLogInnerValue(payoff, mesher, 0));
+
+    Array rhs(layout->size()), x(layout->size());
+    const FdmLinearOpIterator endIter = layout->end();
+
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+        x[iter.index()] = mesher->location(iter, 0);
+    }
+
+    // a stopping time without conditions, just to check that the
+    // steps are restarted correctly after it
+    std::list<std::vector<Time> > stoppingTimes;
+    stoppingTimes.push_back(std::vector<Time>(1, 0.4));
+    boost::shared_ptr<FdmStepConditionComposite> condition(
+        new FdmStepConditionComposite(
+                        stoppingTimes, FdmStepConditionComposite::Conditions()));
+
+    FdmBackwardSolver solver(map, FdmBoundaryConditionSet(), condition,
+                             FdmSchemeDesc::Douglas());
+    solver.rollbackAdaptive(rhs, maturity, 0.0,
+                            initialSteps, dampingSteps, tolerance);
+
+    MonotonicCubicNaturalSpline spline(x.begin(), x.end(), rhs.begin());
+
+    Real s = spot->value();
+    Real calculatedPV = spline(std::log(s));
+    Real calculatedGamma = (spline.secondDerivative(std::log(s))
+                            - spline.derivative(std::log(s))    )/(s*s);
+
+    Real relTol = 2e-3;
+
+    if (std::fabs(calculatedPV - expectedPV) > relTol*expectedPV) {
+        BOOST_FAIL("Error calculating the PV of the digital option" <<
+                "\n rel. tolerance:  " << relTol <<
+                "\n expected:        " << expectedPV <<
+                "\n calculated:      " << calculatedPV);
+    }
+    if (std::fabs(calculatedGamma - expectedGamma) > relTol*expectedGamma) {
+        BOOST_FAIL("Error calculating the Gamma of the digital option" <<
+                "\n rel. tolerance:  " << relTol <<
+                "\n expected:        " << expectedGamma <<
+                "\n calculated:      " << calculatedGamma);
+    }
+
+    const Size maxSteps = 30;
+    if (solver.acceptedSteps() > maxSteps
+        || solver.errorEstimate() > solver.acceptedSteps()*tolerance) {
+        BOOST_FAIL("Unexpected adaptive time stepping statistics" <<
+                "\n accepted steps:  " << solver.acceptedSteps() <<
+                "\n rejected steps:  " << solver.rejectedSteps() <<
+                "\n error estimate:  " << solver.errorEstimate() <<
+                "\n tolerance:       " << tolerance);
+    }
+}
+
 void FdmLinearOpTest::testSpareMatrixReference() {
 #ifndef QL_NO_UBLAS_SUPPORT
     BOOST_MESSAGE("Testing SparseMatrixReference type...");
@@ -1289,13 +1858,23 @@ test_suite* FdmLinearOpTest::suite() {
             &FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapThreads));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapCachedSolve));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testInPlaceOperators));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonScheme));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveTimeStepping));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
 
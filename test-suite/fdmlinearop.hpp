@@ -35,12 +35,18 @@ public:
     static void testSecondDerivativesMapApply();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandMapThreads();
+    static void testTripleBandMapCachedSolve();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
+    static void testInPlaceOperators();
     static void testBiCGstab();
+    static void testGMRES();
+    static void testCrankNicolsonScheme();
     static void testCrankNicolsonWithDamping();
+    static void testAdaptiveTimeStepping();
     static void testSpareMatrixReference();
     static boost::unit_test_framework::test_suite* suite();
 };
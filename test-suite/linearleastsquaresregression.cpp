@@ -23,6 +23,7 @@
 #include <ql/math/functional.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/linearleastsquaresregression.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <boost/bind.hpp>
 #include <boost/circular_buffer.hpp>
 
@@ -241,6 +242,91 @@ void LinearLeastSquaresRegressionTest::test1dLinearRegression() {
     }    
 }
 
+void LinearLeastSquaresRegressionTest::testIncrementalRegression() {
+
+    BOOST_MESSAGE("Testing incremental linear least-squares regression...");
+
+    SavedSettings backup;
+
+    const Real tolerance = 1.0e-9;
+
+    const Size nr=10000;
+    PseudoRandom::urng_type rng(1234u);
+
+    std::vector<boost::function1<Real, Real> > v;
+    v.push_back(constant<Real, Real>(1.0));
+    v.push_back(identity<Real>());
+    v.push_back(square<Real>());
+    v.push_back(std::ptr_fun<Real, Real>(std::exp));
+
+    const Real a[] = { 0.5, -1.2, 2.1, 0.3 };
+
+    std::vector<Real> x(nr), y(nr);
+    for (Size i=0; i<nr; ++i) {
+        x[i] = 2.0*rng.next().value;
+        y[i] = a[0]*v[0](x[i]) + a[1]*v[1](x[i]) + a[2]*v[2](x[i])
+             + a[3]*v[3](x[i]) + rng.next().value - 0.5;
+    }
+
+    const Array expected = GeneralLinearLeastSquares(x, y, v).coefficients();
+
+    // the observations are split among three partial regressions
+    // which are merged afterwards
+    std::vector<IncrementalLinearLeastSquares> partial(
+                                3, IncrementalLinearLeastSquares(v.size()));
+    Array basis(v.size());
+    for (Size i=0; i<nr; ++i) {
+        for (Size l=0; l<v.size(); ++l)
+            basis[l] = v[l](x[i]);
+        partial[(3*i)/nr].add(basis.begin(), y[i]);
+    }
+    IncrementalLinearLeastSquares m(v.size());
+    for (Size k=0; k<partial.size(); ++k)
+        m.merge(partial[k]);
+
+    if (m.size() != nr)
+        BOOST_ERROR("wrong number of observations"
+                    << "\n    calculated: " << m.size()
+                    << "\n    expected:   " << nr);
+
+    const Array calculated = m.coefficients();
+    for (Size l=0; l<v.size(); ++l) {
+        if (std::fabs(calculated[l]-expected[l])
+                                > tolerance*std::fabs(expected[l])) {
+            BOOST_ERROR("Failed to reproduce SVD regression coef."
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated[l]
+                        << "\n    expected:   " << expected[l]);
+        }
+    }
+
+    // a dependent regressor must not spoil the fitted values
+    std::vector<boost::function1<Real, Real> > w(v);
+    w.push_back(square<Real>());
+    IncrementalLinearLeastSquares d(w.size());
+    Array wBasis(w.size());
+    for (Size i=0; i<nr; ++i) {
+        for (Size l=0; l<w.size(); ++l)
+            wBasis[l] = w[l](x[i]);
+        d.add(wBasis.begin(), y[i]);
+    }
+    const Array c = d.coefficients();
+    for (Size i=0; i<nr; i+=97) {
+        Real fitted = 0.0, expectedFit = 0.0;
+        for (Size l=0; l<w.size(); ++l)
+            fitted += c[l]*w[l](x[i]);
+        for (Size l=0; l<v.size(); ++l)
+            expectedFit += expected[l]*v[l](x[i]);
+        if (std::fabs(fitted-expectedFit) > tolerance)
+            BOOST_ERROR("Failed to reproduce fitted value "
+                        "with dependent regressor"
+                        << std::setprecision(12)
+                        << "\n    x:          " << x[i]
+                        << "\n    calculated: " << fitted
+                        << "\n    expected:   " << expectedFit);
+    }
+}
+
 
 test_suite* LinearLeastSquaresRegressionTest::suite() {
     test_suite* suite =
@@ -251,6 +337,8 @@ test_suite* LinearLeastSquaresRegressionTest::suite() {
         &LinearLeastSquaresRegressionTest::testMultiDimRegression));
     suite->add(QUANTLIB_TEST_CASE(
         &LinearLeastSquaresRegressionTest::test1dLinearRegression));
+    suite->add(QUANTLIB_TEST_CASE(
+        &LinearLeastSquaresRegressionTest::testIncrementalRegression));
     return suite;
 }
 
@@ -1070,10 +1070,17 @@ void LowDiscrepancyTest::testSobolSkipping() {
             SobolRsg rsg2(dimensionality[j], seed, integers[i]);
             rsg2.skipTo(skip[k]);
 
+            // extract some samples and skip the rest
+            SobolRsg rsg3(dimensionality[j], seed, integers[i]);
+            for (Size l=0; l<skip[k]/2; l++)
+                rsg3.nextInt32Sequence();
+            rsg3.skip(skip[k]-skip[k]/2);
+
             // compare next 100 samples
             for (Size m=0; m<100; m++) {
                 std::vector<unsigned long> s1 = rsg1.nextInt32Sequence();
                 std::vector<unsigned long> s2 = rsg2.nextInt32Sequence();
+                std::vector<unsigned long> s3 = rsg3.nextInt32Sequence();
                 for (Size n=0; n<s1.size(); n++) {
                     if (s1[n] != s2[n]) {
                         BOOST_ERROR("Mismatch after skipping:"
@@ -1084,6 +1091,16 @@ void LowDiscrepancyTest::testSobolSkipping() {
                                     << "\n  expected: " << s1[n]
                                     << "\n  found:    " << s2[n]);
                     }
+                    if (s1[n] != s3[n]) {
+                        BOOST_ERROR("Mismatch after partial skipping:"
+                                    << "\n  size:     " << dimensionality[j]
+                                    << "\n  integers: " << integers[i]
+                                    << "\n  drawn:    " << skip[k]/2
+                                    << "\n  skipped:  " << skip[k]-skip[k]/2
+                                    << "\n  at index: " << n
+                                    << "\n  expected: " << s1[n]
+                                    << "\n  found:    " << s3[n]);
+                    }
                 }
             }
         }
@@ -1628,6 +1628,8 @@ void MarketModelTest::testCallableSwapLS() {
     // Longstaff-Schwartz exercise strategy
     std::vector<std::vector<NodeData> > collectedData;
     std::vector<std::vector<Real> > basisCoefficients;
+    // the regression storage is reused across configurations
+    GenericLSRegressionWorkspace regressionWorkspace;
     NothingExerciseValue control(rateTimes);
     SwapBasisSystem basisSystem(rateTimes,exerciseTimes);
     NothingExerciseValue nullRebate(rateTimes);
@@ -1693,7 +1695,7 @@ void MarketModelTest::testCallableSwapLS() {
                                 receiverSwap, basisSystem, nullRebate,
                                 control, trainingPaths_, collectedData);
                             genericLongstaffSchwartzRegression(collectedData,
-                                basisCoefficients);
+                                basisCoefficients, regressionWorkspace);
                             LongstaffSchwartzExerciseStrategy exerciseStrategy(
                                 basisSystem, basisCoefficients,
                                 evolution, numeraires,
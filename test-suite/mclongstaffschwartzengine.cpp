@@ -25,6 +25,10 @@
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/genericlsregression.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/mcamericanengine.hpp>
@@ -294,6 +298,284 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testAmericanOptionWorkers() {
+
+    BOOST_MESSAGE("Testing Monte-Carlo pricing of American options "
+                  "with multiple workers...");
+
+    SavedSettings backup;
+
+    const Date todaysDate(15, May, 1998);
+    const Date settlementDate(17, May, 1998);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Date maturity(17, May, 1999);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<Exercise> americanExercise(
+        new AmericanExercise(settlementDate, maturity));
+
+    Handle<YieldTermStructure> flatTermStructure(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(settlementDate, 0.06, dayCounter)));
+    Handle<YieldTermStructure> flatDividendTS(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(settlementDate, 0.0, dayCounter)));
+    Handle<BlackVolTermStructure> flatVolTS(
+        boost::shared_ptr<BlackVolTermStructure>(
+            new BlackConstantVol(settlementDate, NullCalendar(),
+                                 0.20, dayCounter)));
+    Handle<Quote> underlyingH(
+        boost::shared_ptr<Quote>(new SimpleQuote(36.0)));
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess>
+        stochasticProcess(new GeneralizedBlackScholesProcess(
+                              underlyingH, flatDividendTS,
+                              flatTermStructure, flatVolTS));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Put, 40.0));
+
+    VanillaOption americanOption(payoff, americanExercise);
+
+    americanOption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new FDAmericanEngine<CrankNicolson>(stochasticProcess,
+                                                    401, 200)));
+    const Real expected = americanOption.NPV();
+
+    // more calibration samples than a single regression block, so
+    // that the partial regressions are merged
+    const Size workers = 3;
+    americanOption.setPricingEngine(
+        MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+            .withSteps(75)
+            .withAntitheticVariate()
+            .withSamples(20001)
+            .withCalibrationSamples(5001)
+            .withSeed(42)
+            .withPolynomOrder(3)
+            .withWorkers(workers));
+    const Real calculated = americanOption.NPV();
+    const Real errorEstimate = americanOption.errorEstimate();
+
+    if (std::fabs(calculated - expected) > 3.0*errorEstimate) {
+        BOOST_ERROR("Failed to reproduce american option price with "
+                    << workers << " workers:"
+                    << "\n    expected:   " << expected
+                    << "\n    calculated: " << calculated
+                    << " +/- " << errorEstimate);
+    }
+
+    // the workers use the same calibration and pricing paths as a
+    // serial run, so the results must coincide exactly
+    americanOption.setPricingEngine(
+        MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+            .withSteps(75)
+            .withAntitheticVariate()
+            .withSamples(20001)
+            .withCalibrationSamples(5001)
+            .withSeed(42)
+            .withPolynomOrder(3));
+    const Real serial = americanOption.NPV();
+
+    if (serial != calculated) {
+        BOOST_ERROR("Failed to reproduce serial american option price with "
+                    << workers << " workers:"
+                    << std::setprecision(16)
+                    << "\n    serial:   " << serial
+                    << "\n    parallel: " << calculated);
+    }
+}
+
+namespace {
+
+    // the former implementation of genericLongstaffSchwartzRegression,
+    // based on SequenceStatistics
+    Real referenceRegression(
+                std::vector<std::vector<NodeData> >& simulationData,
+                std::vector<std::vector<Real> >& basisCoefficients) {
+
+        Size steps = simulationData.size();
+        basisCoefficients.resize(steps-1);
+
+        for (Size i=steps-1; i!=0; --i) {
+            std::vector<NodeData>& exerciseData = simulationData[i];
+
+            Size N = exerciseData.front().values.size();
+            std::vector<Real> temp(N+1);
+            SequenceStatistics stats(N+1);
+            for (Size j=0; j<exerciseData.size(); ++j) {
+                if (exerciseData[j].isValid) {
+                    std::copy(exerciseData[j].values.begin(),
+                              exerciseData[j].values.end(),
+                              temp.begin());
+                    temp.back() = exerciseData[j].cumulatedCashFlows
+                                - exerciseData[j].controlValue;
+                    stats.add(temp);
+                }
+            }
+
+            std::vector<Real> means = stats.mean();
+            Matrix covariance = stats.covariance();
+            Matrix C(N,N);
+            Array target(N);
+            for (Size k=0; k<N; ++k) {
+                target[k] = covariance[k][N] + means[k]*means[N];
+                for (Size l=0; l<=k; ++l)
+                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
+            }
+
+            Array alphas = SVD(C).solveFor(target);
+            basisCoefficients[i-1].assign(alphas.begin(), alphas.end());
+
+            for (Size j=0; j<exerciseData.size(); ++j) {
+                if (exerciseData[j].isValid) {
+                    Real exerciseValue = exerciseData[j].exerciseValue;
+                    Real continuationValue =
+                        exerciseData[j].cumulatedCashFlows;
+                    Real estimatedContinuationValue =
+                        std::inner_product(exerciseData[j].values.begin(),
+                                           exerciseData[j].values.end(),
+                                           alphas.begin(),
+                                           exerciseData[j].controlValue);
+                    Real value = estimatedContinuationValue <= exerciseValue ?
+                                 exerciseValue :
+                                 continuationValue;
+                    simulationData[i-1][j].cumulatedCashFlows += value;
+                }
+            }
+        }
+
+        Real sum = 0.0;
+        for (Size j=0; j<simulationData[0].size(); ++j)
+            sum += simulationData[0][j].cumulatedCashFlows;
+        return sum/simulationData[0].size();
+    }
+
+    enum RegressionBasis { Quadratic, Linear, DegenerateLinear };
+
+    // put-like exercise values on a uniformly distributed state
+    std::vector<std::vector<NodeData> > regressionData(
+                                          Size exercises, Size paths,
+                                          RegressionBasis basis) {
+        MersenneTwisterUniformRng rng(42);
+        std::vector<std::vector<NodeData> > data(
+                             exercises+1, std::vector<NodeData>(paths));
+        for (Size i=0; i<=exercises; ++i) {
+            for (Size j=0; j<paths; ++j) {
+                NodeData& node = data[i][j];
+                Real x = 0.5 + rng.next().value;
+                node.exerciseValue = std::max(1.0-x, 0.0);
+                node.cumulatedCashFlows = 0.2*rng.next().value;
+                node.controlValue = 0.01*rng.next().value;
+                node.isValid = (i == 0 || node.exerciseValue > 0.0);
+                node.values.push_back(1.0);
+                node.values.push_back(x);
+                if (basis == Quadratic)
+                    node.values.push_back(x*x);
+                else if (basis == DegenerateLinear)
+                    node.values.push_back(2.0*x);
+            }
+        }
+        return data;
+    }
+
+    void checkCashFlows(const std::string& tag,
+                        const std::vector<std::vector<NodeData> >& data,
+                        const std::vector<std::vector<NodeData> >& expected,
+                        Real tolerance) {
+        for (Size i=0; i<data.size(); ++i) {
+            for (Size j=0; j<data[i].size(); ++j) {
+                Real calculated = data[i][j].cumulatedCashFlows;
+                Real reference = expected[i][j].cumulatedCashFlows;
+                if (std::fabs(calculated-reference) > tolerance)
+                    BOOST_FAIL(tag << ": cumulated cash flows differ"
+                               << std::setprecision(16)
+                               << "\n    time:       " << i
+                               << "\n    path:       " << j
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << reference);
+            }
+        }
+    }
+
+}
+
+
+void MCLongstaffSchwartzEngineTest::testGenericRegression() {
+
+    BOOST_MESSAGE("Testing generic Longstaff-Schwartz regression...");
+
+    const Size exercises = 10, paths = 5000;
+    const Real tolerance = 1.0e-12;
+
+    std::vector<std::vector<NodeData> > data =
+        regressionData(exercises, paths, Quadratic);
+    std::vector<std::vector<NodeData> > expectedData = data;
+    std::vector<std::vector<Real> > coefficients, expectedCoefficients;
+
+    GenericLSRegressionWorkspace workspace;
+    Real calculated = genericLongstaffSchwartzRegression(data, coefficients,
+                                                         workspace);
+    Real expected = referenceRegression(expectedData,
+                                        expectedCoefficients);
+
+    if (std::fabs(calculated-expected) > tolerance)
+        BOOST_ERROR("failed to reproduce reference estimate:"
+                    << std::setprecision(16)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+    for (Size i=0; i<exercises; ++i) {
+        for (Size k=0; k<coefficients[i].size(); ++k) {
+            Real error = std::fabs(coefficients[i][k]/
+                                   expectedCoefficients[i][k] - 1.0);
+            if (error > 1.0e-10)
+                BOOST_ERROR("failed to reproduce reference coefficient:"
+                            << std::setprecision(16)
+                            << "\n    exercise:   " << i
+                            << "\n    basis:      " << k
+                            << "\n    calculated: " << coefficients[i][k]
+                            << "\n    expected:   "
+                            << expectedCoefficients[i][k]
+                            << "\n    rel. error: " << error);
+        }
+    }
+    checkCashFlows("reference regression", data, expectedData, tolerance);
+
+    // a workspace reused for a second regression gives the same results
+    std::vector<std::vector<NodeData> > reusedData =
+        regressionData(exercises, paths, Quadratic);
+    std::vector<std::vector<Real> > reusedCoefficients;
+    Real reused = genericLongstaffSchwartzRegression(reusedData,
+                                                     reusedCoefficients,
+                                                     workspace);
+    if (reused != calculated || reusedCoefficients != coefficients)
+        BOOST_ERROR("reused workspace failed to reproduce results:"
+                    << std::setprecision(16)
+                    << "\n    reused:   " << reused
+                    << "\n    original: " << calculated);
+    checkCashFlows("reused workspace", reusedData, data, 0.0);
+
+    // linearly dependent basis functions give the same continuation
+    // values as the independent ones they span
+    std::vector<std::vector<NodeData> > degenerateData =
+        regressionData(exercises, paths, DegenerateLinear);
+    std::vector<std::vector<NodeData> > linearData =
+        regressionData(exercises, paths, Linear);
+    Real degenerate = genericLongstaffSchwartzRegression(degenerateData,
+                                                         coefficients,
+                                                         workspace);
+    Real linear = genericLongstaffSchwartzRegression(linearData,
+                                                     coefficients,
+                                                     workspace);
+    if (std::fabs(degenerate-linear) > tolerance)
+        BOOST_ERROR("degenerate basis failed to reproduce estimate:"
+                    << std::setprecision(16)
+                    << "\n    degenerate: " << degenerate
+                    << "\n    linear:     " << linear);
+    checkCashFlows("degenerate basis", degenerateData, linearData, tolerance);
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -301,6 +583,10 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testAmericanOptionWorkers));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testGenericRegression));
     return suite;
 }
 
@@ -20,6 +20,7 @@
 #include "mersennetwister.hpp"
 #include "utilities.hpp"
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -482,9 +483,78 @@ void MersenneTwisterTest::testValues() {
 }
 
 
+void MersenneTwisterTest::testSkipping() {
+
+    BOOST_MESSAGE("Testing Mersenne twister skipping...");
+
+    unsigned long seed = 42;
+    Size drawn[] = { 0, 17, 624 };
+    // the last value is large enough to trigger the polynomial jump
+    BigNatural skip[] = { 0, 1, 42, 623, 624, 1000, 100000, 40000000 };
+
+    for (Size i=0; i<LENGTH(drawn); i++) {
+        for (Size j=0; j<LENGTH(skip); j++) {
+
+            MersenneTwisterUniformRng rng1(seed), rng2(seed);
+            for (Size k=0; k<drawn[i]; k++) {
+                rng1.nextInt32();
+                rng2.nextInt32();
+            }
+
+            // extract n numbers
+            for (BigNatural k=0; k<skip[j]; k++)
+                rng1.nextInt32();
+
+            // skip n numbers at once
+            rng2.skip(skip[j]);
+
+            // compare the next numbers
+            for (Size k=0; k<1000; k++) {
+                unsigned long x1 = rng1.nextInt32(), x2 = rng2.nextInt32();
+                if (x1 != x2) {
+                    BOOST_ERROR("Mismatch after skipping:"
+                                << "\n  drawn:    " << drawn[i]
+                                << "\n  skipped:  " << skip[j]
+                                << "\n  at index: " << k
+                                << "\n  expected: " << x1
+                                << "\n  found:    " << x2);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void MersenneTwisterTest::testStreams() {
+
+    BOOST_MESSAGE("Testing Mersenne twister streams...");
+
+    unsigned long seed = 42;
+    BigNatural length = 1000;
+    StreamGenerator streams(seed, length);
+
+    MersenneTwisterUniformRng rng(seed);
+    for (Size i=0; i<5; i++) {
+        MersenneTwisterUniformRng stream = streams.stream(i);
+        for (BigNatural k=0; k<length; k++) {
+            unsigned long x1 = rng.nextInt32(), x2 = stream.nextInt32();
+            if (x1 != x2) {
+                BOOST_ERROR("Mismatch in stream " << i << ":"
+                            << "\n  at index: " << k
+                            << "\n  expected: " << x1
+                            << "\n  found:    " << x2);
+                break;
+            }
+        }
+    }
+}
+
+
 test_suite* MersenneTwisterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Mersenne twister tests");
     suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testValues));
+    suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testSkipping));
+    suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testStreams));
     return suite;
 }
 
@@ -28,6 +28,8 @@
 class MersenneTwisterTest {
   public:
     static void testValues();
+    static void testSkipping();
+    static void testStreams();
     static boost::unit_test_framework::test_suite* suite();
 };
 
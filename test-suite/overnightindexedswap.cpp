@@ -405,6 +405,23 @@ void OvernightIndexedSwapTest::testBootstrap() {
                         "\n tolerance:       " << tolerance);
     }
 
+    // the global Newton bootstrap must give the same curve
+    PiecewiseYieldCurve<Discount,LogLinear,NewtonBootstrap> newtonTS(
+                                 vars.today, eoniaHelpers, Actual365Fixed());
+    tolerance = 1.0e-10;
+    for (Size i = 0; i < eoniaHelpers.size(); i++) {
+        Date d = eoniaHelpers[i]->latestDate();
+        DiscountFactor expected = eoniaTS->discount(d),
+                       calculated = newtonTS.discount(d);
+        if (std::fabs(expected-calculated) > tolerance)
+            BOOST_ERROR("global bootstrap inconsistency:" <<
+                        std::setprecision(12) <<
+                        "\n date:                " << d <<
+                        "\n iterative bootstrap: " << expected <<
+                        "\n global bootstrap:    " << calculated <<
+                        "\n tolerance:           " << tolerance);
+    }
+
     // zero spread
     /*
     std::cout << "zero spread:" << std::endl;
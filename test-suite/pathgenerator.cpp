@@ -22,6 +22,7 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -290,11 +291,117 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+namespace {
+
+    void testMultipleBlock(const boost::shared_ptr<StochasticProcess>& process,
+                           const std::string& tag) {
+        typedef PseudoRandom::rsg_type rsg_type;
+
+        Size timeSteps = 12, assets = process->size();
+        TimeGrid grid(10.0, timeSteps);
+        rsg_type rsg = PseudoRandom::make_sequence_generator(
+                                            timeSteps*process->factors(), 42);
+        MultiPathGenerator<rsg_type> blockGenerator(process, grid, rsg, false);
+        MultiPathGenerator<rsg_type> pathGenerator(process, grid, rsg, false);
+
+        MultiPathBlock block, antitheticBlock;
+        // the second batch is smaller, so that the storage is reused
+        Size batches[] = { 20, 7 };
+        for (Size b=0; b<LENGTH(batches); b++) {
+            blockGenerator.nextBlock(batches[b], block);
+            antitheticBlock = block;
+            blockGenerator.antitheticBlock(antitheticBlock);
+
+            for (Size k=0; k<batches[b]; k++) {
+                const MultiPath& path = pathGenerator.next().value;
+                for (Size j=0; j<assets; j++) {
+                    for (Size i=0; i<grid.size(); i++) {
+                        if (block(j,i,k) != path[j][i])
+                            BOOST_FAIL(tag << " block path " << k
+                                       << " in batch " << b
+                                       << " differs from generated path:"
+                                       << std::setprecision(13)
+                                       << "\n    asset:      " << j
+                                       << "\n    time step:  " << i
+                                       << "\n    calculated: " << block(j,i,k)
+                                       << "\n    expected:   " << path[j][i]);
+                    }
+                }
+                const MultiPath& antithetic = pathGenerator.antithetic().value;
+                for (Size j=0; j<assets; j++) {
+                    for (Size i=0; i<grid.size(); i++) {
+                        if (antitheticBlock(j,i,k) != antithetic[j][i])
+                            BOOST_FAIL(tag << " antithetic block path " << k
+                                       << " in batch " << b
+                                       << " differs from generated path:"
+                                       << std::setprecision(13)
+                                       << "\n    asset:      " << j
+                                       << "\n    time step:  " << i
+                                       << "\n    calculated: "
+                                       << antitheticBlock(j,i,k)
+                                       << "\n    expected:   "
+                                       << antithetic[j][i]);
+                    }
+                }
+            }
+        }
+
+        MultiPath copy;
+        block.copyPath(3, copy);
+        for (Size j=0; j<assets; j++) {
+            for (Size i=0; i<grid.size(); i++) {
+                if (copy[j][i] != block(j,i,3))
+                    BOOST_FAIL(tag << " copied path differs from block path");
+            }
+        }
+    }
+
+}
+
+
+void PathGeneratorTest::testMultiPathBlock() {
+
+    BOOST_MESSAGE("Testing n-D path generation in blocks...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    Matrix correlation(3,3);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.9; correlation[0][2] = 0.7;
+    correlation[1][0] = 0.9; correlation[1][1] = 1.0; correlation[1][2] = 0.4;
+    correlation[2][0] = 0.7; correlation[2][1] = 0.4; correlation[2][2] = 1.0;
+
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(3);
+    processes[0] = boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    processes[1] = boost::shared_ptr<StochasticProcess1D>(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.20));
+    processes[2] = boost::shared_ptr<StochasticProcess1D>(
+                                 new SquareRootProcess(0.1, 0.1, 0.20, 10.0));
+    boost::shared_ptr<StochasticProcess> process(
+                           new StochasticProcessArray(processes,correlation));
+
+    testMultipleBlock(process, "process array");
+
+    boost::shared_ptr<StochasticProcess> heston(
+                            new HestonProcess(r, q, x0, 0.04, 1.5, 0.04,
+                                              0.3, -0.7));
+    testMultipleBlock(heston, "Heston");
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathBlock));
     return suite;
 }
 
@@ -44,6 +44,7 @@
 #include <ql/math/comparison.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <iomanip>
@@ -638,6 +639,127 @@ void PiecewiseYieldCurveTest::testLocalBootstrapConsistency() {
 }
 
 
+void PiecewiseYieldCurveTest::testNewtonBootstrapConsistency() {
+    BOOST_MESSAGE(
+        "Testing consistency of global Newton bootstrap algorithm...");
+
+    CommonVars vars;
+    testCurveConsistency<Discount,LogLinear,NewtonBootstrap>(vars);
+    testBMACurveConsistency<Discount,LogLinear,NewtonBootstrap>(vars);
+    testCurveConsistency<ZeroYield,Linear,NewtonBootstrap>(vars);
+    testCurveConsistency<ZeroYield,Cubic,NewtonBootstrap>(
+                           vars,
+                           Cubic(CubicInterpolation::Spline, true,
+                                 CubicInterpolation::SecondDerivative, 0.0,
+                                 CubicInterpolation::SecondDerivative, 0.0));
+
+    // the curve must also match the one from the iterative bootstrap
+    PiecewiseYieldCurve<Discount,LogLinear> iterative(vars.settlement,
+                                                      vars.instruments,
+                                                      Actual360());
+    PiecewiseYieldCurve<Discount,LogLinear,NewtonBootstrap> newton(
+                                                      vars.settlement,
+                                                      vars.instruments,
+                                                      Actual360());
+    Real tolerance = 1.0e-10;
+    for (Size i=0; i<vars.instruments.size(); i++) {
+        Date d = vars.instruments[i]->latestDate();
+        if (std::fabs(iterative.discount(d) - newton.discount(d)) > tolerance)
+            BOOST_ERROR("failed to reproduce discount factor:"
+                        << "\n    date:      " << d
+                        << "\n    iterative: " << iterative.discount(d)
+                        << "\n    newton:    " << newton.discount(d)
+                        << "\n    tolerance: " << tolerance);
+    }
+}
+
+
+void PiecewiseYieldCurveTest::testBootstrapJacobian() {
+    BOOST_MESSAGE(
+        "Testing bucket sensitivities from the bootstrap Jacobian...");
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear,NewtonBootstrap> Curve;
+    boost::shared_ptr<Curve> curve(
+                new Curve(vars.settlement, vars.instruments, Actual360()));
+    vars.termStructure = curve;
+    Handle<YieldTermStructure> curveHandle(vars.termStructure);
+
+    Schedule schedule(vars.settlement, vars.settlement + 12*Years,
+                      Period(Semiannual), vars.calendar,
+                      vars.bondConvention, vars.bondConvention,
+                      DateGeneration::Backward, false);
+    boost::shared_ptr<Bond> bond(
+        new FixedRateBond(0, 100.0, schedule, std::vector<Rate>(1, 0.045),
+                          vars.bondDayCounter, vars.bondConvention,
+                          vars.bondRedemption, vars.settlement));
+    bond->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                    new DiscountingBondEngine(curveHandle)));
+
+    // the bond value is linear in the discount factors
+    std::vector<Date> dates;
+    std::vector<Real> discountSensitivities;
+    const Leg& cashflows = bond->cashflows();
+    for (Size i=0; i<cashflows.size(); i++) {
+        if (!cashflows[i]->hasOccurred(vars.settlement)) {
+            dates.push_back(cashflows[i]->date());
+            discountSensitivities.push_back(cashflows[i]->amount());
+        }
+    }
+
+    std::vector<Real> calculated =
+        bucketDeltaFromJacobian(curve->jacobian(),
+                                curve->dataSensitivities(
+                                           dates, discountSensitivities));
+    Matrix inverseJacobian = curve->inverseJacobian();
+    std::vector<Real> nodes = curve->data();
+
+    // compare with tweaking the quotes and bootstrapping again
+    const Real shift = 1.0e-5;
+    std::vector<Handle<SimpleQuote> > quotes;
+    for (Size i=0; i<vars.rates.size(); i++)
+        quotes.push_back(Handle<SimpleQuote>(vars.rates[i]));
+    std::vector<Real> expected =
+        bucketAnalysis(quotes,
+                       std::vector<boost::shared_ptr<Instrument> >(1, bond),
+                       std::vector<Real>(1, 1.0), shift).first;
+
+    Real tolerance = 1.0e-6;
+    for (Size i=0; i<quotes.size(); i++) {
+        if (std::fabs(calculated[i] - expected[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce bucket sensitivity to "
+                        << io::ordinal(i+1) << " quote:"
+                        << std::setprecision(8)
+                        << "\n    from Jacobian: " << calculated[i]
+                        << "\n    tweaked:       " << expected[i]
+                        << "\n    tolerance:     " << tolerance);
+    }
+
+    Real nodeTolerance = 1.0e-8;
+    for (Size i=0; i<quotes.size(); i++) {
+        Real q = vars.rates[i]->value();
+        vars.rates[i]->setValue(q + shift);
+        std::vector<Real> up = curve->data();
+        vars.rates[i]->setValue(q - shift);
+        std::vector<Real> down = curve->data();
+        vars.rates[i]->setValue(q);
+        for (Size j=1; j<nodes.size(); j++) {
+            Real tweaked = (up[j] - down[j])/(2.0*shift);
+            if (std::fabs(inverseJacobian[j-1][i] - tweaked) > nodeTolerance)
+                BOOST_ERROR("failed to reproduce sensitivity of "
+                            << io::ordinal(j) << " node to "
+                            << io::ordinal(i+1) << " quote:"
+                            << std::setprecision(8)
+                            << "\n    from Jacobian: "
+                            << inverseJacobian[j-1][i]
+                            << "\n    tweaked:       " << tweaked
+                            << "\n    tolerance:     " << nodeTolerance);
+        }
+    }
+}
+
+
 void PiecewiseYieldCurveTest::testObservability() {
 
     BOOST_MESSAGE("Testing observability of piecewise yield curve...");
@@ -681,6 +803,43 @@ void PiecewiseYieldCurveTest::testObservability() {
 }
 
 
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+
+    BOOST_MESSAGE("Testing incremental bootstrap of piecewise yield curve...");
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear> Curve;
+    vars.termStructure = boost::shared_ptr<YieldTermStructure>(
+        new Curve(vars.settlement, vars.instruments, Actual360()));
+    vars.termStructure->discount(1.0);
+
+    Real tolerance = 1.0e-9;
+
+    for (Size i=0; i<vars.deposits+vars.swaps; i++) {
+        // the curve is bootstrapped again from the i-th pillar...
+        vars.rates[i]->setValue(vars.rates[i]->value()*1.01);
+        std::vector<DiscountFactor> discounts(vars.instruments.size());
+        for (Size j=0; j<vars.instruments.size(); j++)
+            discounts[j] =
+                vars.termStructure->discount(vars.instruments[j]->latestDate());
+
+        // ...and must match a curve bootstrapped from scratch
+        Curve curve(vars.settlement, vars.instruments, Actual360());
+        for (Size j=0; j<vars.instruments.size(); j++) {
+            Date d = vars.instruments[j]->latestDate();
+            if (std::fabs(discounts[j] - curve.discount(d)) > tolerance)
+                BOOST_ERROR("failed to reproduce discount factor "
+                            "after change of " << io::ordinal(i+1)
+                            << " quote:"
+                            << "\n    date:        " << d
+                            << "\n    incremental: " << discounts[j]
+                            << "\n    full:        " << curve.discount(d)
+                            << "\n    tolerance:   " << tolerance);
+        }
+    }
+}
+
 void PiecewiseYieldCurveTest::testLiborFixing() {
 
     BOOST_MESSAGE(
@@ -945,8 +1104,14 @@ test_suite* PiecewiseYieldCurveTest::suite() {
              &PiecewiseYieldCurveTest::testConvexMonotoneForwardConsistency));
     suite->add(QUANTLIB_TEST_CASE(
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testNewtonBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testBootstrapJacobian));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+                       &PiecewiseYieldCurveTest::testIncrementalBootstrap));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testJpyLibor));
@@ -41,8 +41,11 @@ class PiecewiseYieldCurveTest {
 
     static void testConvexMonotoneForwardConsistency();
     static void testLocalBootstrapConsistency();
+    static void testNewtonBootstrapConsistency();
+    static void testBootstrapJacobian();
 
     static void testObservability();
+    static void testIncrementalBootstrap();
     static void testLiborFixing();
 
     static void testJpyLibor();
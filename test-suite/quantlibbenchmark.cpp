@@ -71,12 +71,14 @@
 
 #include <ql/types.hpp>
 #include <ql/version.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/timer.hpp>
 #include <iostream>
 #include <iomanip>
 #include <list>
 #include <string>
+#include <vector>
 
 /* PAPI code
 #include <stdio.h
@@ -149,6 +151,55 @@ namespace {
                              // point operations (not per sec!)
     };
 
+    // The same points are evaluated one at a time and as arrays, so
+    // that the two benchmarks can be compared directly.  The points
+    // fit in cache and are scrambled, as Monte Carlo draws would be,
+    // so that branch prediction doesn't favor either version.
+    const QuantLib::Size normalPoints = 1000, normalRuns = 10000;
+
+    /* The flop count is obtained by counting the operations of
+       Acklam's approximation at the points above, with log and sqrt
+       counted as one operation each:
+       - 952 points in the central region take 24 operations each
+         (x-0.5, its square, two Horner polynomials of degree 5, the
+         product by x-0.5 and the division);
+       - the 24 points in the lower tail take 22 (log, product by -2,
+         sqrt, two Horner polynomials of degree 5 and 4, division);
+       - the 24 points in the upper tail take 24 (the same plus 1-x
+         and the change of sign).
+       That is 23952 operations per run.  The same count is used for
+       both benchmarks; the scalar operator() also applies the mean
+       and standard deviation, which is not counted.
+    */
+    const double inverseNormalMflop = 23952.0*normalRuns/1.0e6;
+
+    void inverseNormalEvaluation(bool arrays) {
+        using namespace QuantLib;
+        std::vector<Real> p(normalPoints), y(normalPoints);
+        for (Size i=0; i<normalPoints; ++i)
+            p[i] = ((i*7919) % normalPoints + 0.5)/normalPoints;
+        InverseCumulativeNormal inverse;
+        Real sum = 0.0;
+        for (Size k=0; k<normalRuns; ++k) {
+            if (arrays) {
+                inverse(&p[0], &p[0]+normalPoints, &y[0]);
+                for (Size i=0; i<normalPoints; ++i)
+                    sum += y[i];
+            } else {
+                for (Size i=0; i<normalPoints; ++i)
+                    sum += inverse(p[i]);
+            }
+        }
+        // sanity check, also keeping the evaluations from being
+        // optimized away; the points are symmetric around 0.5
+        if (std::fabs(sum) > 1.0e-8*normalRuns*normalPoints)
+            BOOST_ERROR("inverse cumulative normal: unexpected sum "
+                        << sum);
+    }
+
+    void inverseNormalScalarEvaluation() { inverseNormalEvaluation(false); }
+    void inverseNormalArrayEvaluation() { inverseNormalEvaluation(true); }
+
     boost::timer t;
     std::list<double> runTimes;
     std::list<Benchmark> bm;
@@ -243,6 +294,10 @@ test_suite* init_unit_test_suite(int, char*[]) {
         &ConvertibleBondTest::testBond, 159.85));
     bm.push_back(Benchmark("DigitalOption::MCCashAtHit",
         &DigitalOptionTest::testMCCashAtHit,995.87));
+    bm.push_back(Benchmark("Distribution::InverseNormalScalar",
+        &inverseNormalScalarEvaluation, inverseNormalMflop));
+    bm.push_back(Benchmark("Distribution::InverseNormalArray",
+        &inverseNormalArrayEvaluation, inverseNormalMflop));
     bm.push_back(Benchmark("DividendOption::FdEuropeanGreeks",
         &DividendOptionTest::testFdEuropeanGreeks, 949.52));
     bm.push_back(Benchmark("DividendOption::FdAmericanGreeks",
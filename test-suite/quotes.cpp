@@ -29,6 +29,7 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <boost/timer.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -43,6 +44,33 @@ namespace {
     Real mul(Real x, Real y) { return x*y; }
     Real sub(Real x, Real y) { return x-y; }
 
+    class UpdateCounter : public Observer {
+      public:
+        UpdateCounter() : counter_(0) {}
+        void update() { ++counter_; }
+        Size counter() const { return counter_; }
+      private:
+        Size counter_;
+    };
+
+    // forwards notifications, as a lazy object would do
+    class Forwarder : public Observer, public Observable {
+      public:
+        void update() { notifyObservers(); }
+    };
+
+    class SelfRemover : public UpdateCounter {
+      public:
+        explicit SelfRemover(const boost::shared_ptr<Observable>& o)
+        : observable_(o) { registerWith(observable_); }
+        void update() {
+            UpdateCounter::update();
+            unregisterWith(observable_);
+        }
+      private:
+        boost::shared_ptr<Observable> observable_;
+    };
+
 }
 
 
@@ -196,6 +224,149 @@ void QuoteTest::testForwardValueQuoteAndImpliedStdevQuote(){
 }
 
 
+void QuoteTest::testNotificationBatch() {
+
+    BOOST_MESSAGE("Testing batched notifications...");
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    for (Size i=0; i<10; ++i)
+        quotes.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(i)));
+
+    boost::shared_ptr<Forwarder> forwarder(new Forwarder);
+    UpdateCounter direct, indirect;
+    for (Size i=0; i<quotes.size(); ++i) {
+        direct.registerWith(quotes[i]);
+        forwarder->registerWith(quotes[i]);
+    }
+    indirect.registerWith(forwarder);
+    // also reached through the forwarder
+    direct.registerWith(forwarder);
+
+    {
+        NotificationBatch batch;
+        {
+            NotificationBatch nested;
+            for (Size i=0; i<quotes.size(); ++i)
+                quotes[i]->setValue(2.0*i);
+        }
+        if (direct.counter() != 0 || indirect.counter() != 0)
+            BOOST_FAIL("observers notified before the end of the batch"
+                       << "\n    direct:   " << direct.counter()
+                       << "\n    indirect: " << indirect.counter());
+        // observers destroyed during the batch must not be notified
+        UpdateCounter temporary;
+        temporary.registerWith(quotes[0]);
+        quotes[0]->setValue(1.0);
+    }
+    if (direct.counter() != 1 || indirect.counter() != 1)
+        BOOST_FAIL("observers not notified exactly once by the batch"
+                   << "\n    direct:   " << direct.counter()
+                   << "\n    indirect: " << indirect.counter());
+
+    // back to immediate notification
+    quotes[0]->setValue(3.0);
+    if (direct.counter() != 3 || indirect.counter() != 2)
+        BOOST_FAIL("observers not notified after the batch"
+                   << "\n    direct:   " << direct.counter()
+                   << "\n    indirect: " << indirect.counter());
+
+    // observers removing themselves during notification must not
+    // prevent the others from being notified
+    boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.0));
+    std::vector<boost::shared_ptr<UpdateCounter> > observers;
+    for (Size i=0; i<10; ++i) {
+        if (i % 2 == 0) {
+            observers.push_back(
+                      boost::shared_ptr<UpdateCounter>(new SelfRemover(q)));
+        } else {
+            observers.push_back(
+                      boost::shared_ptr<UpdateCounter>(new UpdateCounter));
+            observers.back()->registerWith(q);
+        }
+    }
+    q->setValue(1.0);
+    q->setValue(2.0);
+    for (Size i=0; i<observers.size(); ++i) {
+        Size expected = (i % 2 == 0) ? 1 : 2;
+        if (observers[i]->counter() != expected)
+            BOOST_FAIL("observer " << i << " notified "
+                       << observers[i]->counter() << " times"
+                       << "\n    expected: " << expected);
+    }
+}
+
+namespace {
+
+    // time taken to register n observers with a quote and to
+    // destroy them in the order they were created
+    double observerLifetime(Size n) {
+        boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.0));
+        std::vector<boost::shared_ptr<UpdateCounter> > observers(n);
+        boost::timer t;
+        for (Size i=0; i<n; ++i) {
+            observers[i] = boost::shared_ptr<UpdateCounter>(new UpdateCounter);
+            observers[i]->registerWith(q);
+        }
+        for (Size i=0; i<n; ++i)
+            observers[i].reset();
+        return t.elapsed();
+    }
+
+}
+
+void QuoteTest::testObserverScaling() {
+
+    BOOST_MESSAGE("Testing observables with many observers...");
+
+    boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.0));
+    std::vector<boost::shared_ptr<UpdateCounter> > observers;
+    for (Size i=0; i<1000; ++i) {
+        if (i % 2 == 0) {
+            observers.push_back(
+                      boost::shared_ptr<UpdateCounter>(new SelfRemover(q)));
+        } else {
+            observers.push_back(
+                      boost::shared_ptr<UpdateCounter>(new UpdateCounter));
+            observers.back()->registerWith(q);
+        }
+    }
+    // the self-removers leave 500 observers registered
+    q->setValue(1.0);
+    // destroying most of the others leaves only a few of them
+    for (Size i=1; i<990; i+=2)
+        observers[i].reset();
+    q->setValue(2.0);
+    {
+        NotificationBatch batch;
+        q->setValue(3.0);
+    }
+    for (Size i=0; i<observers.size(); ++i) {
+        if (!observers[i])
+            continue;
+        Size expected = (i % 2 == 0) ? 1 : 3;
+        if (observers[i]->counter() != expected)
+            BOOST_FAIL("observer " << i << " notified "
+                       << observers[i]->counter() << " times"
+                       << "\n    expected: " << expected);
+    }
+
+    // registering and removing observers must not take quadratic
+    // time; the best of a few runs is used to reduce noise
+    Size n = 20000;
+    double small = QL_MAX_REAL, large = QL_MAX_REAL;
+    for (Size k=0; k<3; ++k) {
+        small = std::min(small, observerLifetime(n));
+        large = std::min(large, observerLifetime(8*n));
+    }
+    // linear time would give a ratio of about 8, quadratic time 64
+    double ratio = large/std::max(small, 1.0e-3);
+    if (ratio > 24.0)
+        BOOST_FAIL("observer lifetime grows too fast"
+                   << "\n    " << n << " observers: " << small << " s"
+                   << "\n    " << 8*n << " observers: " << large << " s"
+                   << "\n    ratio: " << ratio);
+}
+
 test_suite* QuoteTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Quote tests");
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObservable));
@@ -204,6 +375,8 @@ test_suite* QuoteTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testComposite));
     suite->add(QUANTLIB_TEST_CASE(
                       &QuoteTest::testForwardValueQuoteAndImpliedStdevQuote));
+    suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testNotificationBatch));
+    suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObserverScaling));
     return suite;
 }
 
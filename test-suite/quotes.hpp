@@ -32,6 +32,8 @@ class QuoteTest {
     static void testDerived();
     static void testComposite();
     static void testForwardValueQuoteAndImpliedStdevQuote();
+    static void testNotificationBatch();
+    static void testObserverScaling();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -21,6 +21,7 @@
 #include "rngtraits.hpp"
 #include "utilities.hpp"
 #include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/randomnumbers/sobolbrownianbridgersg.hpp>
 #include <ql/math/comparison.hpp>
 
 using namespace QuantLib;
@@ -92,11 +93,75 @@ void RngTraitsTest::testCustomPoisson() {
 }
 
 
+namespace {
+
+    template <class RSG>
+    void checkBlock(const std::string& name, const RSG& rsg) {
+        const Size n = 10, dimension = rsg.dimension();
+
+        RSG blockGenerator = rsg, sequenceGenerator = rsg;
+        std::vector<Real> block(n*dimension), weights(n);
+        blockGenerator.nextBlock(n, &block[0], &weights[0]);
+
+        for (Size i=0; i<n; i++) {
+            const typename RSG::sample_type& sample =
+                sequenceGenerator.nextSequence();
+            const std::vector<Real>& values = sample.value;
+            if (weights[i] != sample.weight) {
+                BOOST_ERROR(name << " block generation weight mismatch:"
+                            << "\n    sample:     " << i
+                            << "\n    calculated: " << weights[i]
+                            << "\n    expected:   " << sample.weight);
+                return;
+            }
+            for (Size j=0; j<dimension; j++) {
+                if (block[i*dimension+j] != values[j]) {
+                    BOOST_ERROR(name << " block generation mismatch:"
+                                << "\n    sample:     " << i
+                                << "\n    index:      " << j
+                                << "\n    calculated: " << block[i*dimension+j]
+                                << "\n    expected:   " << values[j]);
+                    return;
+                }
+            }
+        }
+
+        const std::vector<Real>& last = blockGenerator.lastSequence().value;
+        if (!std::equal(last.begin(), last.end(),
+                        block.begin()+(n-1)*dimension))
+            BOOST_ERROR(name << " block generation: last sequence "
+                        "not updated");
+
+        // the generators must be in the same state afterwards
+        if (blockGenerator.nextSequence().value !=
+            sequenceGenerator.nextSequence().value)
+            BOOST_ERROR(name << " block generation: "
+                        "generator state mismatch after block");
+    }
+
+}
+
+void RngTraitsTest::testBlockGeneration() {
+
+    BOOST_MESSAGE("Testing block generation of random sequences...");
+
+    checkBlock("uniform pseudo-random",
+               PseudoRandom::ursg_type(20, 1234));
+    checkBlock("Gaussian pseudo-random",
+               PseudoRandom::make_sequence_generator(20, 1234));
+    checkBlock("Sobol", SobolRsg(20));
+    checkBlock("Gaussian low-discrepancy",
+               LowDiscrepancy::make_sequence_generator(20, 0));
+    checkBlock("Sobol Brownian bridge", SobolBrownianBridgeRsg(3, 5));
+}
+
+
 test_suite* RngTraitsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testBlockGeneration));
     return suite;
 }
 
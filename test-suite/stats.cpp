@@ -322,12 +322,129 @@ void StatisticsTest::testConvergenceStatistics() {
 }
 
 
+namespace {
+
+    // negative samples are needed for the downside statistics
+    Real mergeData[] =    { 3.0, -4.0, 5.0, -2.0, 3.0,
+                            4.0, -5.0, 6.0, -1.0, 7.0 };
+    Real mergeWeights[] = { 1.0, 2.0, 0.5, 1.0, 1.5,
+                            1.0, 1.0, 2.0, 1.0, 0.5 };
+
+    void checkMergedValue(const std::string& name, const std::string& what,
+                          Real calculated, Real expected) {
+        Real tolerance = 1.0e-12;
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_FAIL(name << ": wrong merged " << what << "\n"
+                       << std::setprecision(16)
+                       << "    calculated: " << calculated << "\n"
+                       << "    expected:   " << expected);
+    }
+
+    template <class S>
+    void checkMerge(const std::string& name) {
+
+        S whole, merged, first, second, third;
+        for (Size i=0; i<LENGTH(mergeData); i++) {
+            whole.add(mergeData[i],mergeWeights[i]);
+            if (i < 3)
+                first.add(mergeData[i],mergeWeights[i]);
+            else if (i < 7)
+                second.add(mergeData[i],mergeWeights[i]);
+            else
+                third.add(mergeData[i],mergeWeights[i]);
+        }
+        merged.merge(first);
+        merged.merge(second);
+        merged.merge(S());
+        merged.merge(third);
+
+        if (merged.samples() != whole.samples())
+            BOOST_FAIL(name << ": wrong number of merged samples\n"
+                       << "    calculated: " << merged.samples() << "\n"
+                       << "    expected:   " << whole.samples());
+
+        if (merged.min() != whole.min() || merged.max() != whole.max())
+            BOOST_FAIL(name << ": wrong merged extremes\n"
+                       << "    calculated: " << merged.min()
+                       << ", " << merged.max() << "\n"
+                       << "    expected:   " << whole.min()
+                       << ", " << whole.max());
+
+        checkMergedValue(name, "weight sum",
+                         merged.weightSum(), whole.weightSum());
+        checkMergedValue(name, "mean", merged.mean(), whole.mean());
+        checkMergedValue(name, "variance",
+                         merged.variance(), whole.variance());
+        checkMergedValue(name, "skewness",
+                         merged.skewness(), whole.skewness());
+        checkMergedValue(name, "kurtosis",
+                         merged.kurtosis(), whole.kurtosis());
+        checkMergedValue(name, "downside variance",
+                         merged.downsideVariance(), whole.downsideVariance());
+    }
+
+}
+
+
+void StatisticsTest::testMergedStatistics() {
+
+    BOOST_MESSAGE("Testing merged statistics...");
+
+    checkMerge<IncrementalStatistics>(
+                              std::string("IncrementalStatistics"));
+    checkMerge<Statistics>(std::string("Statistics"));
+
+    // the merged covariance must match the one of the whole sample
+    Size dimension = 3;
+    SequenceStatistics whole(dimension), merged(dimension), part;
+    std::vector<Real> temp(dimension);
+    for (Size i=0; i<LENGTH(data); i++) {
+        for (Size j=0; j<dimension; j++)
+            temp[j] = data[(i+j)%LENGTH(data)]*(j+1.0);
+        whole.add(temp,weights[i]);
+        part.add(temp,weights[i]);
+        if (i == 4) {
+            merged.merge(part);
+            part.reset(dimension);
+        }
+    }
+    merged.merge(part);
+
+    Matrix expected = whole.covariance(), calculated = merged.covariance();
+    for (Size i=0; i<dimension; i++) {
+        for (Size j=0; j<dimension; j++) {
+            if (std::fabs(calculated[i][j]-expected[i][j]) > 1.0e-12)
+                BOOST_FAIL("SequenceStatistics: "
+                           << "wrong merged covariance ("
+                           << i << "," << j << ")\n"
+                           << std::setprecision(16)
+                           << "    calculated: " << calculated[i][j] << "\n"
+                           << "    expected:   " << expected[i][j]);
+        }
+    }
+
+    // central moments are not affected by a large offset
+    IncrementalStatistics shifted;
+    Real offset = 1.0e9;
+    for (Size i=0; i<LENGTH(data); i++)
+        shifted.add(data[i]+offset,weights[i]);
+    Real expectedVariance = 2.23333333333;
+    if (std::fabs(shifted.variance()-expectedVariance) > 1.0e-6)
+        BOOST_FAIL("IncrementalStatistics: wrong variance with offset "
+                   << offset << "\n"
+                   << std::setprecision(16)
+                   << "    calculated: " << shifted.variance() << "\n"
+                   << "    expected:   " << expectedVariance);
+}
+
+
 
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testMergedStatistics));
     return suite;
 }
 